@@ -0,0 +1,157 @@
+/// \file forward_bench.cpp
+///
+/// \brief The forward-handler routing benchmark.
+///
+/// This benchmark measures the routing work done by the forward handlers of
+/// the services that forward a task (switches and forwarding machines) on
+/// deep multi-switch topologies. For each depth, a tree of switches connects
+/// a set of masters to a set of machines, and every task is forwarded through
+/// every switch of its route. The per-hop cost is measured in two ways:
+///
+///   - Searching: the route is searched by the task's (origin, destination)
+///     vertices at every hop, as the handlers did before the messages carried
+///     a route identifier.
+///   - Identifier: the route is resolved through the identifier carried by
+///     the message, as the handlers do now.
+///
+/// Usage: ispd_forward_bench [master-count] [machine-count] [max-depth]
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include <ispd/log/log.hpp>
+#include <ispd/routing/routing.hpp>
+
+namespace {
+
+/// \brief A task in flight, as seen by the forward handlers.
+struct Task {
+  tw_lpid m_Origin;
+  tw_lpid m_Dest;
+  ispd::routing::RouteId m_RouteId;
+};
+
+/// \brief Builds the routes of a topology in which every master reaches every
+///        machine through a path with the specified number of switches.
+///
+/// The vertices are numbered as masters, machines and, then, links. Since
+/// only the links are stored in the paths, the switches are implicit.
+auto buildTopology(ispd::routing::RoutingTable &table,
+                   const std::uint64_t masterCount,
+                   const std::uint64_t machineCount, const unsigned depth)
+    -> void {
+  std::vector<ispd::routing::RouteRecord> routes;
+  std::vector<tw_lpid> hops;
+  tw_lpid nextLink = masterCount + machineCount;
+
+  routes.reserve(masterCount * machineCount);
+  hops.reserve(masterCount * machineCount * (depth + 1));
+
+  for (tw_lpid master = 0; master < masterCount; master++) {
+    for (tw_lpid machine = masterCount; machine < masterCount + machineCount;
+         machine++) {
+      routes.push_back({master, machine, hops.size(), depth + 1U});
+
+      /// A path with `depth` switches has `depth + 1` links.
+      for (unsigned i = 0; i <= depth; i++)
+        hops.push_back(nextLink++);
+    }
+  }
+
+  table.build(routes, hops.data());
+}
+
+/// \brief Forwards every task through every switch of its route, resolving
+///        the next hop with the specified resolver.
+///
+/// \returns The average time, in nanoseconds, spent per forwarded hop.
+template <typename Resolver>
+auto forwardAll(const std::vector<Task> &tasks, const unsigned depth,
+                const unsigned rounds, Resolver &&resolve,
+                tw_lpid &checksum) -> double {
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned round = 0; round < rounds; round++) {
+    for (const Task &task : tasks) {
+      /// The i-th switch forwards the task to the route's (i + 1)-th link.
+      for (unsigned offset = 1; offset <= depth; offset++)
+        checksum += resolve(task).get(offset);
+    }
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  const double hopCount = static_cast<double>(tasks.size()) * depth * rounds;
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         hopCount;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ispd::log::setOutputFile(nullptr);
+
+  const std::uint64_t masterCount =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+  const std::uint64_t machineCount =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+  const unsigned maxDepth =
+      argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 32;
+
+  if (masterCount == 0 || machineCount == 0 || maxDepth == 0) {
+    std::fprintf(stderr,
+                 "Usage: %s [master-count] [machine-count] [max-depth]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  constexpr std::size_t taskCount = 1 << 16;
+  std::mt19937_64 rng(42);
+  tw_lpid checksum = 0;
+
+  std::printf("%8s %12s %16s %16s %10s\n", "depth", "routes", "search (ns/hop)",
+              "id (ns/hop)", "speedup");
+
+  for (unsigned depth = 1; depth <= maxDepth; depth *= 2) {
+    ispd::routing::RoutingTable table;
+
+    buildTopology(table, masterCount, machineCount, depth);
+
+    /// Draw the tasks, resolving their route identifiers once, as the
+    /// masters do at generating them.
+    std::vector<Task> tasks(taskCount);
+
+    for (Task &task : tasks) {
+      task.m_Origin = rng() % masterCount;
+      task.m_Dest = masterCount + rng() % machineCount;
+      task.m_RouteId = table.getRouteId(task.m_Origin, task.m_Dest);
+    }
+
+    /// Keep the total number of forwarded hops roughly constant per depth.
+    const unsigned rounds = std::max(1U, 64U / depth);
+
+    const double searching = forwardAll(
+        tasks, depth, rounds,
+        [&table](const Task &task) {
+          return table.getRoute(task.m_Origin, task.m_Dest);
+        },
+        checksum);
+
+    const double identified = forwardAll(
+        tasks, depth, rounds,
+        [&table](const Task &task) {
+          return table.getRouteById(task.m_RouteId);
+        },
+        checksum);
+
+    std::printf("%8u %12lu %16.2lf %16.2lf %9.2lfx\n", depth,
+                masterCount * machineCount, searching, identified,
+                searching / identified);
+  }
+
+  /// Print the checksum, such that the lookups are not optimized away.
+  std::printf("Checksum: %lu\n", checksum);
+  return 0;
+}
@@ -0,0 +1,268 @@
+/// \file routing_bench.cpp
+///
+/// \brief The routing subsystem microbenchmark.
+///
+/// This benchmark measures the routing table in isolation over synthetic
+/// route sets of increasing scale (from 10^3 routes up to the specified
+/// maximum, by factors of 10) and of two path length ranges: short paths, as
+/// in star topologies, and long paths, as in deep switch trees. The paths of
+/// a source's routes share prefixes, as the routes of a tree do.
+///
+/// For each route set, every storage choice is populated and measured:
+///
+///   - text: the textual route file, parsed into the flat layout.
+///   - trie: the textual route file, parsed into the prefix trie.
+///   - compiled: the compiled route file, memory-mapped as is.
+///
+/// The load throughput (routes/s) and the memory held per route are reported
+/// for each storage, and the latency percentiles of `getRoute` (searched by
+/// the vertices, then the whole path read), `getRouteById` (then the whole
+/// path read) and `countRoutes` are reported over random lookups. Each
+/// latency is timed individually and the clock's own overhead is subtracted.
+///
+/// Usage: ispd_routing_bench [max-routes] [parse-threads]
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include <ispd/log/log.hpp>
+#include <ispd/routing/routing.hpp>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// \brief The number of destinations of each source.
+constexpr std::uint64_t g_DestsPerSource = 1000;
+
+/// \brief The number of timed lookups of each operation.
+constexpr std::size_t g_LookupCount = 200000;
+
+/// \brief A range of path lengths.
+struct PathLengths {
+  const char *m_Name;
+  unsigned m_Min;
+  unsigned m_Max;
+};
+
+/// \brief Returns the length of the route to the specified destination.
+auto getPathLength(const PathLengths &lengths, const std::uint64_t dest)
+    -> unsigned {
+  return lengths.m_Min + dest % (lengths.m_Max - lengths.m_Min + 1);
+}
+
+/// \brief Writes a synthetic textual route file.
+///
+/// The j-th hop of the route from `s` to `d` depends only on `s`, `j` and
+/// the high bits of `d`, such that the routes of a source to nearby
+/// destinations share their prefixes, as in a tree.
+auto writeRouteFile(const std::string &path, const std::uint64_t routeCount,
+                    const PathLengths &lengths) -> void {
+  std::FILE *const file = std::fopen(path.c_str(), "w");
+
+  if (!file)
+    ispd_error("Route file %s could not be created.", path.c_str());
+
+  const std::uint64_t sourceCount =
+      std::max<std::uint64_t>(1, routeCount / g_DestsPerSource);
+  const std::uint64_t destCount = routeCount / sourceCount;
+  const tw_lpid firstLink = sourceCount + destCount;
+
+  for (std::uint64_t s = 0; s < sourceCount; s++) {
+    for (std::uint64_t d = 0; d < destCount; d++) {
+      const unsigned length = getPathLength(lengths, d);
+
+      std::fprintf(file, "%lu %lu", s, sourceCount + d);
+
+      for (unsigned j = 0; j < length; j++) {
+        const unsigned shift = 2 * (length - 1 - j);
+        const tw_lpid group = shift < 64 ? d >> shift : 0;
+
+        std::fprintf(file, " %lu",
+                     firstLink + ((s * lengths.m_Max + j) << 20) + group);
+      }
+      std::fputc('\n', file);
+    }
+  }
+
+  std::fclose(file);
+}
+
+/// \brief Returns the median overhead, in nanoseconds, of reading the clock
+///        twice.
+auto measureClockOverhead() -> double {
+  std::vector<double> samples(10000);
+
+  for (double &sample : samples) {
+    const auto start = Clock::now();
+    const auto end = Clock::now();
+
+    sample = std::chrono::duration<double, std::nano>(end - start).count();
+  }
+
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                   samples.end());
+  return samples[samples.size() / 2];
+}
+
+/// \brief Times each call of the specified operation and prints the latency
+///        percentiles.
+template <typename Operation>
+auto measureLatency(const char *const name, const double overhead,
+                    Operation &&operation, tw_lpid &checksum) -> void {
+  std::vector<double> samples(g_LookupCount);
+
+  for (std::size_t i = 0; i < g_LookupCount; i++) {
+    const auto start = Clock::now();
+
+    checksum += operation(i);
+
+    const auto end = Clock::now();
+
+    samples[i] = std::max(
+        0.0,
+        std::chrono::duration<double, std::nano>(end - start).count() -
+            overhead);
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  const auto percentile = [&samples](const double p) {
+    return samples[static_cast<std::size_t>(p * (samples.size() - 1))];
+  };
+
+  std::printf("    %-14s %10.1lf %10.1lf %10.1lf %10.1lf\n", name,
+              percentile(0.50), percentile(0.90), percentile(0.99),
+              percentile(0.999));
+}
+
+/// \brief Measures the lookups of a populated routing table.
+auto measureLookups(const ispd::routing::RoutingTable &table,
+                    const std::uint64_t sourceCount,
+                    const std::uint64_t destCount, const double overhead,
+                    tw_lpid &checksum) -> void {
+  std::mt19937_64 rng(42);
+  std::vector<tw_lpid> srcs(g_LookupCount);
+  std::vector<tw_lpid> dests(g_LookupCount);
+  std::vector<ispd::routing::RouteId> ids(g_LookupCount);
+
+  for (std::size_t i = 0; i < g_LookupCount; i++) {
+    srcs[i] = rng() % sourceCount;
+    dests[i] = sourceCount + rng() % destCount;
+    ids[i] = table.getRouteId(srcs[i], dests[i]);
+  }
+
+  /// Reads every hop of the route, as the route is forwarded through.
+  const auto walk = [](const ispd::routing::Route &route) {
+    tw_lpid sum = 0;
+
+    for (std::size_t j = 0; j < route.getLength(); j++)
+      sum += route.get(j);
+    return sum;
+  };
+
+  std::printf("    %-14s %10s %10s %10s %10s\n", "lookup (ns)", "p50", "p90",
+              "p99", "p99.9");
+
+  measureLatency(
+      "getRoute", overhead,
+      [&](const std::size_t i) {
+        return walk(table.getRoute(srcs[i], dests[i]));
+      },
+      checksum);
+
+  measureLatency(
+      "getRouteById", overhead,
+      [&](const std::size_t i) { return walk(table.getRouteById(ids[i])); },
+      checksum);
+
+  measureLatency(
+      "countRoutes", overhead,
+      [&](const std::size_t i) {
+        return static_cast<tw_lpid>(table.countRoutes(srcs[i]));
+      },
+      checksum);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ispd::log::setOutputFile(nullptr);
+
+  const std::uint64_t maxRoutes =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  const unsigned threadCount =
+      argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0;
+
+  if (maxRoutes < 1000) {
+    std::fprintf(stderr, "Usage: %s [max-routes] [parse-threads]\n", argv[0]);
+    return 1;
+  }
+
+  const PathLengths pathLengths[] = {{"short", 2, 4}, {"long", 8, 16}};
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path();
+  const std::string textPath = (directory / "ispd_routing_bench.route");
+  const std::string compiledPath = (directory / "ispd_routing_bench.bin");
+  const double overhead = measureClockOverhead();
+  tw_lpid checksum = 0;
+
+  std::printf("Clock overhead: %.1lf ns (subtracted).\n", overhead);
+
+  for (std::uint64_t routeCount = 1000; routeCount <= maxRoutes;
+       routeCount *= 10) {
+    for (const PathLengths &lengths : pathLengths) {
+      const std::uint64_t sourceCount =
+          std::max<std::uint64_t>(1, routeCount / g_DestsPerSource);
+      const std::uint64_t destCount = routeCount / sourceCount;
+
+      writeRouteFile(textPath, routeCount, lengths);
+
+      std::printf("\n%lu routes, %s paths (%u to %u hops):\n",
+                  sourceCount * destCount, lengths.m_Name, lengths.m_Min,
+                  lengths.m_Max);
+
+      /// Compile the route file once, such that the compiled storage can be
+      /// measured as well.
+      {
+        ispd::routing::RoutingTable table;
+
+        table.load(textPath, threadCount);
+        table.save(compiledPath);
+      }
+
+      for (const char *const storage : {"text", "trie", "compiled"}) {
+        ispd::routing::RoutingTable table;
+        const bool compiled = std::string(storage) == "compiled";
+
+        if (std::string(storage) == "trie")
+          table.enablePrefixSharing();
+
+        const auto start = Clock::now();
+
+        table.load(compiled ? compiledPath : textPath, threadCount);
+
+        const double seconds =
+            std::chrono::duration<double>(Clock::now() - start).count();
+        const double routes = static_cast<double>(table.getRouteCount());
+
+        std::printf("  %-8s load: %12.0lf routes/s, %8.2lf bytes/route\n",
+                    storage, routes / seconds,
+                    table.getMemoryUsage() / routes);
+
+        measureLookups(table, sourceCount, destCount, overhead, checksum);
+      }
+    }
+  }
+
+  std::filesystem::remove(textPath);
+  std::filesystem::remove(compiledPath);
+
+  /// Print the checksum, such that the lookups are not optimized away.
+  std::printf("\nChecksum: %lu\n", checksum);
+  return 0;
+}
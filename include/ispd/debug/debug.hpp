@@ -1,7 +1,11 @@
 #ifndef ISPD_DEBUG_HPP
 #define ISPD_DEBUG_HPP
 
+// The debug mode is enabled unless ISPD_NDEBUG is defined, as it is for the
+// benchmarks, whose measurements must not include the debug checks and prints.
+#ifndef ISPD_NDEBUG
 #define DEBUG_ON
+#endif // ISPD_NDEBUG
 
 #ifdef DEBUG_ON
 # define DEBUG(CODE) CODE
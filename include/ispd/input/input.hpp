@@ -0,0 +1,91 @@
+#ifndef ISPD_INPUT_HPP
+#define ISPD_INPUT_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+
+namespace ispd::input {
+
+/// \enum ReadMode
+///
+/// \brief How the input files are read by the ranks.
+///
+/// When thousands of ranks are launched, every rank opening and reading the
+/// same input files from a shared parallel filesystem causes an I/O storm,
+/// and the startup time grows with the rank count. In the leader modes, the
+/// raw bytes of a file are read once and broadcast to the other ranks, which
+/// then parse them from memory.
+enum class ReadMode : unsigned {
+  INDEPENDENT = 0, ///< Every rank reads the file by itself.
+  LEADER = 1,      ///< Rank 0 reads the file and broadcasts it to every rank.
+  HOST_LEADER = 2  ///< One rank per host reads the file and broadcasts it to
+                   ///< the ranks in the same host.
+};
+
+/// \class FileBuffer
+///
+/// \brief The raw bytes of an input file, held in memory.
+///
+/// The bytes are stored in 64-bit words, such that a compiled route file can
+/// be served directly from the buffer with its sections properly aligned.
+class FileBuffer {
+  std::vector<std::uint64_t> m_Words;
+  std::size_t m_Size = 0;
+
+public:
+  FileBuffer() = default;
+
+  /// \brief Allocates a zeroed buffer of the specified size in bytes.
+  explicit FileBuffer(const std::size_t size)
+      : m_Words((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)),
+        m_Size(size) {}
+
+  /// \brief Returns the buffer's bytes.
+  [[nodiscard]] inline auto data() noexcept -> char * {
+    return reinterpret_cast<char *>(m_Words.data());
+  }
+
+  /// \brief Returns the buffer's bytes.
+  [[nodiscard]] inline auto data() const noexcept -> const char * {
+    return reinterpret_cast<const char *>(m_Words.data());
+  }
+
+  /// \brief Returns the buffer's size in bytes.
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_Size;
+  }
+
+  /// \brief Returns the buffer's bytes as text.
+  [[nodiscard]] inline auto getText() const noexcept -> std::string_view {
+    return std::string_view(data(), m_Size);
+  }
+
+  /// \brief Moves the buffer's words out, leaving the buffer empty.
+  [[nodiscard]] inline auto releaseWords() noexcept
+      -> std::vector<std::uint64_t> {
+    m_Size = 0;
+    return std::move(m_Words);
+  }
+};
+
+/// \brief Reads the specified file into memory as specified by the read mode.
+///
+/// In the leader modes, only the leader opens the file and the other ranks
+/// receive its bytes through MPI broadcasts, such that they never touch the
+/// filesystem. Therefore, it must be called by every rank, in the same order,
+/// after MPI has been initialized.
+///
+/// \param filepath The path to the file.
+/// \param mode How the file is read by the ranks.
+///
+/// \note If the file could not be read by the reading rank, the program is
+///       immediately aborted.
+[[nodiscard]] auto read(const std::string &filepath, const ReadMode mode)
+    -> FileBuffer;
+
+}; // namespace ispd::input
+
+#endif // ISPD_INPUT_HPP
@@ -2,6 +2,7 @@
 #define ISPD_MESSAGE_H
 
 #include <ispd/customer/task.hpp>
+#include <ispd/routing/routing.hpp>
 
 enum class message_type {
   GENERATE,
@@ -20,9 +21,22 @@ struct ispd_message {
   unsigned saved_core_index;
   double saved_core_next_available_time;
   double saved_waiting_time;
+  tw_lpid saved_route_dest;
+  double saved_route_waiting_time;
 
   /// \brief Route's descriptor.
+  ///
+  /// The route identifier is resolved once by the master, such that the
+  /// services that forward the message read the route's next hop directly
+  /// instead of searching the routing table for the task's vertices.
+  ispd::routing::RouteId route_id;
   int route_offset;
+
+  /// \brief The index of the route among the alternative routes to the task's
+  ///        destination, and the waiting time accumulated at its links. They
+  ///        are fed back to the master's route selector.
+  unsigned route_index;
+  double route_waiting_time;
   tw_lpid previous_service_id;
 
   /// \brief Message flags.
@@ -3,6 +3,7 @@
 
 #include <ross.h>
 #include <filesystem>
+#include <vector>
 #include <unordered_map>
 #include <ispd/model/user.hpp>
 #include <lib/nlohmann/json.hpp>
@@ -201,7 +202,7 @@ private:
     double m_GlobalTotalPowerIdle;                  ///< Total power idle across all nodes.
     double m_GlobalSimulationTime;                  ///< Total simulation time.
 
-    std::unordered_map<ispd::model::User::uid_t, ispd::metrics::UserMetrics> m_GlobalUserMetrics; ///< Total user metrics.
+    std::vector<ispd::metrics::UserMetrics> m_GlobalUserMetrics; ///< Total user metrics, indexed by the users' identifiers.
 #ifdef DEBUG_ON
   std::unordered_map<ispd::services::ServiceType, double> m_GlobalTotalForwardTime;
   std::unordered_map<ispd::services::ServiceType, uint64_t> m_GlobalTotalForwardEventsCount;
@@ -2,74 +2,152 @@
 #define ISPD_MODEL_BUILDER_HPP
 
 #include <ross.h>
+#include <string>
 #include <vector>
-#include <functional>
 #include <unordered_map>
 #include <ispd/log/log.hpp>
 #include <ispd/model/user.hpp>
+#include <ispd/model/service_tables.hpp>
 #include <ispd/workload/workload.hpp>
 #include <ispd/scheduler/scheduler.hpp>
+#include <ispd/route_selector/route_selector.hpp>
 
 namespace ispd::model {
 
 class SimulationModel {
 public:
-  using service_init_map_type =
-      std::unordered_map<tw_lpid, std::function<void(void *)>>;
-  using user_map_type = std::unordered_map<User::uid_t, User>;
+  /// \brief The registered users, indexed by their user identifiers, which
+  ///        are assigned densely in their registration order.
+  using user_vector_type = std::vector<User>;
 
+  /// \brief Registers the machines with the `count` consecutive global
+  ///        identifiers starting at `gid`, which share the same configuration
+  ///        and, therefore, the same row of the machines table.
   void registerMachine(const tw_lpid gid, const double power, const double load,
                        const unsigned coreCount, const double gpuPower,
                        const unsigned gpuCoreCount,
                        const double interconnectionBandwidth,
-                       const double wattageIdle, const double wattageMax);
+                       const double wattageIdle, const double wattageMax,
+                       const tw_lpid count = 1);
 
   void registerLink(const tw_lpid gid, const tw_lpid from, const tw_lpid to,
                     const double bandwidth, const double load,
                     const double latency);
 
+  /// \brief Registers the switches with the `count` consecutive global
+  ///        identifiers starting at `gid`, which share the same configuration
+  ///        and, therefore, the same row of the switches table.
   void registerSwitch(const tw_lpid gid, const double bandwidth,
-                      const double load, const double latency);
+                      const double load, const double latency,
+                      const tw_lpid count = 1);
 
   void registerMaster(const tw_lpid gid, std::vector<tw_lpid> &&slaves,
                       ispd::scheduler::Scheduler *const scheduler,
+                      ispd::route_selector::RouteSelector *const routeSelector,
                       ispd::workload::Workload *const workload);
 
   void registerUser(const std::string &name,
                     const double energyConsumptionLimit);
 
-  [[nodiscard]] const std::function<void(void *)> &
-  getServiceInitializer(const tw_lpid gid) noexcept;
+  /// \brief Registers a machine or a switch that is not hosted by this node,
+  ///        whose configuration is not materialized.
+  void registerRemoteService(const tw_lpid gid);
 
-  [[nodiscard]] inline const user_map_type &getUsers() const noexcept {
+  /// \brief Registers a master that is not hosted by this node, whose slaves
+  ///        are registered, but whose components are not materialized.
+  void registerRemoteMaster(const tw_lpid gid, std::vector<tw_lpid> &&slaves);
+
+  /// \brief Returns the row of the specified service in the configuration
+  ///        table of its type.
+  ///
+  /// \note If no service with the specified global identifier has been
+  ///       registered, the program is immediately aborted.
+  [[nodiscard]] ServiceRow getServiceRow(const tw_lpid gid) const noexcept;
+
+  /// \brief Returns the row of the specified link in the links table, or
+  ///        `g_NoServiceRow` if the specified service is not a link.
+  [[nodiscard]] ServiceRow findLink(const tw_lpid gid) const noexcept;
+
+  [[nodiscard]] inline const user_vector_type &getUsers() const noexcept {
     return m_Users;
   }
 
-  [[nodiscard]] inline User &getUserById(const User::uid_t id) {
-    return m_Users.at(id);
+  [[nodiscard]] inline const MachineTable &getMachines() const noexcept {
+    return m_Machines;
   }
 
-  [[nodiscard]] inline user_map_type::const_iterator
-  getUserByName(const std::string &name) {
-    return std::find_if(
-        m_Users.cbegin(), m_Users.cend(),
-        [&name](const auto &pair) { return pair.second.getName() == name; });
+  [[nodiscard]] inline const LinkTable &getLinks() const noexcept {
+    return m_Links;
+  }
+
+  [[nodiscard]] inline const SwitchTable &getSwitches() const noexcept {
+    return m_Switches;
+  }
+
+  [[nodiscard]] inline const MasterTable &getMasters() const noexcept {
+    return m_Masters;
+  }
+
+  /// \brief Returns the user with the specified identifier, which is a single
+  ///        indexed access, since it is called for every committed task.
+  ///
+  /// \note The identifier must have been assigned to a registered user.
+  [[nodiscard]] inline User &getUserById(const User::uid_t id) noexcept {
+    return m_Users[id];
+  }
+
+  /// \brief Returns the user with the specified name, or the end of the users
+  ///        if no user with that name has been registered.
+  [[nodiscard]] inline user_vector_type::const_iterator
+  getUserByName(const std::string &name) const {
+    const auto it = m_UserIds.find(name);
+
+    if (it == m_UserIds.cend())
+      return m_Users.cend();
+    return m_Users.cbegin() + it->second;
   }
 
 private:
-  service_init_map_type service_initializers;
-  user_map_type m_Users;
+  /// \brief The row of each service in the configuration table of its type,
+  ///        indexed by the service's global identifier.
+  ///
+  /// The services are initialized by reading their configurations directly
+  /// from the tables, such that no per-service initializer is stored.
+  std::vector<ServiceRow> m_Rows;
+  MachineTable m_Machines;
+  LinkTable m_Links;
+  SwitchTable m_Switches;
+  MasterTable m_Masters;
+  user_vector_type m_Users;
+
+  /// \brief The identifier of each registered user, indexed by its name.
+  std::unordered_map<std::string, User::uid_t> m_UserIds;
+
+  inline void registerServiceRow(const tw_lpid gid, const std::size_t row) {
+    if (gid >= m_Rows.size())
+      m_Rows.resize(gid + 1, g_NoServiceRow);
 
-  inline void
-  registerServiceInitializer(const tw_lpid gid,
-                             std::function<void(void *)> initializer) {
     /// Checks if a service with the specified global identifier has already
     /// been registered. If so, the program is immediately aborted.
-    if (service_initializers.find(gid) != service_initializers.end())
+    if (m_Rows[gid] != g_NoServiceRow)
       ispd_error("A service with GID %lu has already been registered.", gid);
 
-    /// Emplace the pair (gid, initializer).
-    service_initializers.emplace(gid, initializer);
+    m_Rows[gid] = static_cast<ServiceRow>(row);
+  }
+
+  inline void registerMasterRow(
+      const tw_lpid gid, const std::vector<tw_lpid> &slaves,
+      ispd::scheduler::Scheduler *const scheduler,
+      ispd::route_selector::RouteSelector *const routeSelector,
+      ispd::workload::Workload *const workload) {
+    registerServiceRow(gid, m_Masters.size());
+    m_Masters.m_Gid.push_back(gid);
+    m_Masters.m_Scheduler.push_back(scheduler);
+    m_Masters.m_RouteSelector.push_back(routeSelector);
+    m_Masters.m_Workload.push_back(workload);
+    m_Masters.m_Slaves.insert(m_Masters.m_Slaves.end(), slaves.cbegin(),
+                              slaves.cend());
+    m_Masters.m_SlaveOffsets.push_back(m_Masters.m_Slaves.size());
   }
 };
 
@@ -80,29 +158,45 @@ void registerMachine(const tw_lpid gid, const double power, const double load,
                      const unsigned coreCount, const double gpuPower,
                      const unsigned gpuCoreCount,
                      const double interconnectionBandwidth,
-                     const double wattageIdle, const double wattageMax);
+                     const double wattageIdle, const double wattageMax,
+                     const tw_lpid count = 1);
 
 void registerLink(const tw_lpid gid, const tw_lpid from, const tw_lpid to,
                   const double bandwidth, const double load,
                   const double latency);
 
 void registerSwitch(const tw_lpid gid, const double bandwidth,
-                    const double load, const double latency);
+                    const double load, const double latency,
+                    const tw_lpid count = 1);
 
 void registerMaster(const tw_lpid gid, std::vector<tw_lpid> &&slaves,
                     ispd::scheduler::Scheduler *const scheduler,
+                    ispd::route_selector::RouteSelector *const routeSelector,
                     ispd::workload::Workload *const workload);
 
 void registerUser(const std::string &name, const double energyConsumptionLimit);
 
-[[nodiscard]] const std::function<void(void *)> &
-getServiceInitializer(const tw_lpid gid);
+void registerRemoteService(const tw_lpid gid);
+
+void registerRemoteMaster(const tw_lpid gid, std::vector<tw_lpid> &&slaves);
+
+[[nodiscard]] ispd::model::ServiceRow getServiceRow(const tw_lpid gid);
 
-[[nodiscard]] const ispd::model::SimulationModel::user_map_type &getUsers();
+[[nodiscard]] ispd::model::ServiceRow findLink(const tw_lpid gid);
+
+[[nodiscard]] const ispd::model::SimulationModel::user_vector_type &getUsers();
 
 [[nodiscard]] ispd::model::User &getUserById(ispd::model::User::uid_t id);
 
-[[nodiscard]] const ispd::model::SimulationModel::user_map_type::const_iterator
+[[nodiscard]] const ispd::model::MachineTable &getMachines();
+
+[[nodiscard]] const ispd::model::LinkTable &getLinks();
+
+[[nodiscard]] const ispd::model::SwitchTable &getSwitches();
+
+[[nodiscard]] const ispd::model::MasterTable &getMasters();
+
+[[nodiscard]] const ispd::model::SimulationModel::user_vector_type::const_iterator
 getUserByName(const std::string &name);
 }; // namespace ispd::this_model
 
@@ -0,0 +1,213 @@
+#ifndef ISPD_MODEL_SERVICE_TABLES_HPP
+#define ISPD_MODEL_SERVICE_TABLES_HPP
+
+#include <ross.h>
+#include <array>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <ispd/configuration/link.hpp>
+#include <ispd/configuration/switch.hpp>
+#include <ispd/configuration/machine.hpp>
+#include <ispd/workload/workload.hpp>
+#include <ispd/scheduler/scheduler.hpp>
+#include <ispd/route_selector/route_selector.hpp>
+
+namespace ispd::model {
+
+/// \brief The row of a service in the configuration table of its type.
+using ServiceRow = std::uint32_t;
+
+/// \brief The row of an unregistered service.
+inline constexpr ServiceRow g_NoServiceRow =
+    std::numeric_limits<ServiceRow>::max();
+
+/// \brief The row of a service that has been registered, but whose
+///        configuration has not been materialized, since it is not hosted by
+///        this node.
+inline constexpr ServiceRow g_RemoteServiceRow = g_NoServiceRow - 1;
+
+/// \brief The index of a configuration in the configuration pool of its
+///        service type.
+using ConfigurationIndex = std::uint32_t;
+
+/// \class ConfigurationPool
+///
+/// \brief The distinct configurations of a service type, which are interned,
+///        such that the services with the same hardware share a single
+///        read-only configuration.
+///
+/// A model with thousands of services usually has only a few hardware
+/// classes. Therefore, the services' states refer to their pooled
+/// configuration instead of embedding a copy of it, which keeps the states
+/// small and the configurations read by the event handlers in the cache.
+///
+/// \note The configurations must only be referred to once the model has been
+///       loaded, since interning a configuration may move the others.
+template <typename Configuration, std::size_t ParameterCount>
+class ConfigurationPool final {
+public:
+  /// \brief The parameters from which a configuration is constructed, which
+  ///        identify it in the pool.
+  using Parameters = std::array<double, ParameterCount>;
+
+  /// \brief Returns the index of the configuration with the specified
+  ///        parameters, adding the specified configuration to the pool if no
+  ///        configuration with the same parameters has been interned yet.
+  [[nodiscard]] auto intern(const Parameters &parameters,
+                            const Configuration &configuration)
+      -> ConfigurationIndex {
+    Key key;
+
+    /// The parameters are compared by their bits, such that the equality is
+    /// consistent with the hash.
+    std::memcpy(key.data(), parameters.data(), sizeof(key));
+
+    const auto [it, inserted] = m_Indices.try_emplace(
+        key, static_cast<ConfigurationIndex>(m_Configurations.size()));
+
+    if (inserted)
+      m_Configurations.push_back(configuration);
+    return it->second;
+  }
+
+  [[nodiscard]] inline auto operator[](const ConfigurationIndex index) const
+      noexcept -> const Configuration & {
+    return m_Configurations[index];
+  }
+
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_Configurations.size();
+  }
+
+private:
+  using Key = std::array<std::uint64_t, ParameterCount>;
+
+  struct KeyHash final {
+    [[nodiscard]] auto operator()(const Key &key) const noexcept
+        -> std::size_t {
+      std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+      for (const auto word : key)
+        hash = (hash ^ word) * 0x100000001b3ULL;
+      return hash ^ (hash >> 32);
+    }
+  };
+
+  std::vector<Configuration> m_Configurations;
+  std::unordered_map<Key, ConfigurationIndex, KeyHash> m_Indices;
+};
+
+/// \struct MachineTable
+///
+/// \brief The configurations of the registered machines, stored as a
+///        structure of arrays with one row per machine.
+///
+/// The machines registered together as a range share a single row, in which
+/// case `m_Gid` holds the range's first global identifier. The rows refer to
+/// the interned configurations, such that the machines with the same hardware
+/// share a configuration even if they are registered separately.
+struct MachineTable final {
+  std::vector<tw_lpid> m_Gid;
+  std::vector<ConfigurationIndex> m_Configuration;
+  ConfigurationPool<ispd::configuration::MachineConfiguration, 8>
+      m_Configurations;
+
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_Gid.size();
+  }
+
+  /// \brief Returns the configuration of the machine at the specified row.
+  [[nodiscard]] inline auto getConfiguration(const ServiceRow row) const
+      noexcept -> const ispd::configuration::MachineConfiguration & {
+    return m_Configurations[m_Configuration[row]];
+  }
+};
+
+/// \struct LinkTable
+///
+/// \brief The ends and the configurations of the registered links, stored as
+///        a structure of arrays with one row per link.
+///
+/// The rows refer to the interned configurations (see `MachineTable`).
+struct LinkTable final {
+  std::vector<tw_lpid> m_Gid;
+  std::vector<tw_lpid> m_From; ///< The links' upward ends.
+  std::vector<tw_lpid> m_To;   ///< The links' downward ends.
+  std::vector<ConfigurationIndex> m_Configuration;
+  ConfigurationPool<ispd::configuration::LinkConfiguration, 3>
+      m_Configurations;
+
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_Gid.size();
+  }
+
+  /// \brief Returns the configuration of the link at the specified row.
+  [[nodiscard]] inline auto getConfiguration(const ServiceRow row) const
+      noexcept -> const ispd::configuration::LinkConfiguration & {
+    return m_Configurations[m_Configuration[row]];
+  }
+};
+
+/// \struct SwitchTable
+///
+/// \brief The configurations of the registered switches, stored as a
+///        structure of arrays with one row per switch.
+///
+/// The switches registered together as a range share a single row, in which
+/// case `m_Gid` holds the range's first global identifier. The rows refer to
+/// the interned configurations (see `MachineTable`).
+struct SwitchTable final {
+  std::vector<tw_lpid> m_Gid;
+  std::vector<ConfigurationIndex> m_Configuration;
+  ConfigurationPool<ispd::configuration::SwitchConfiguration, 3>
+      m_Configurations;
+
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_Gid.size();
+  }
+
+  /// \brief Returns the configuration of the switch at the specified row.
+  [[nodiscard]] inline auto getConfiguration(const ServiceRow row) const
+      noexcept -> const ispd::configuration::SwitchConfiguration & {
+    return m_Configurations[m_Configuration[row]];
+  }
+};
+
+/// \struct MasterTable
+///
+/// \brief The components and the slaves of the registered masters, stored as
+///        a structure of arrays with one row per master.
+///
+/// The slaves of every master are stored contiguously, such that the slaves
+/// of the master at row `r` are in `[m_SlaveOffsets[r], m_SlaveOffsets[r +
+/// 1])` of `m_Slaves`.
+///
+/// The masters not hosted by this node have their slaves registered, since
+/// the routes to them are needed by every node, but have no scheduler, route
+/// selector or workload.
+struct MasterTable final {
+  std::vector<tw_lpid> m_Gid;
+  std::vector<ispd::scheduler::Scheduler *> m_Scheduler;
+  std::vector<ispd::route_selector::RouteSelector *> m_RouteSelector;
+  std::vector<ispd::workload::Workload *> m_Workload;
+  std::vector<std::size_t> m_SlaveOffsets = {0};
+  std::vector<tw_lpid> m_Slaves;
+
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_Gid.size();
+  }
+
+  /// \brief Returns the slaves of the master at the specified row.
+  [[nodiscard]] inline auto getSlaves(const ServiceRow row) const
+      -> std::vector<tw_lpid> {
+    return std::vector<tw_lpid>(m_Slaves.cbegin() + m_SlaveOffsets[row],
+                                m_Slaves.cbegin() + m_SlaveOffsets[row + 1]);
+  }
+};
+
+}; // namespace ispd::model
+
+#endif // ISPD_MODEL_SERVICE_TABLES_HPP
@@ -0,0 +1,58 @@
+#ifndef ISPD_MODEL_CHECKER_HPP
+#define ISPD_MODEL_CHECKER_HPP
+
+#include <ross.h>
+#include <ispd/routing/routing.hpp>
+
+/// \brief The whole-model consistency checker.
+///
+/// The model loader validates each element of the model specification on its
+/// own, but the references between the elements (such as the ends of a link
+/// or the slaves of a master) and the routes have been checked piecemeal, if
+/// at all, by the services once the simulation has started. The checker
+/// validates them right after they have been loaded, by many threads, and
+/// reports every violation at once, such that a broken model is rejected
+/// before the logical processes are set up.
+namespace ispd::model_checker {
+
+/// \brief Checks the references between the elements of the loaded model.
+///
+/// It checks that:
+///
+///   - The ends of every link are distinct registered services, which are
+///     not links.
+///   - Every master has slaves, which are registered machines.
+///   - Every materialized master has a workload, owned by a registered user,
+///     and every materialized workload is assigned to a master.
+///
+/// If any violation is found, the violations are listed and the program is
+///  aborted.
+///
+/// \param threadCount The number of checking threads. If zero, the hardware
+///                    concurrency is used.
+auto checkModel(const unsigned threadCount = 0) noexcept -> void;
+
+/// \brief Checks the routes from the specified masters to their slaves.
+///
+/// It checks that there is at least one route from every master to every of
+/// its slaves, and that every route is a chain of registered links from the
+/// master to the slave, that is, the first link leaves the master, each link
+/// arrives at the service from which the next one leaves, which is a switch
+/// or a machine, and the last link arrives at the slave, as the links forward
+/// the tasks from their `from` end to their `to` end.
+///
+/// If any violation is found, the violations are listed and the program is
+/// aborted.
+///
+/// \param threadCount The number of checking threads. If zero, the hardware
+///                    concurrency is used.
+/// \param isLocal If set, only the routes from the masters for which it holds
+///                are checked, such as the masters hosted by this node, whose
+///                routes are all kept by the rank-local route loading.
+auto checkRoutes(const unsigned threadCount = 0,
+                 const ispd::routing::VertexPredicate &isLocal =
+                     nullptr) noexcept -> void;
+
+} // namespace ispd::model_checker
+
+#endif // ISPD_MODEL_CHECKER_HPP
@@ -1,9 +1,16 @@
 #pragma once
 
 #include <ross.h>
+#include <string>
+#include <functional>
 #include <filesystem>
+#include <string_view>
 #include <unordered_map>
 
+namespace ispd::workload {
+class Workload;
+} // namespace ispd::workload
+
 namespace ispd::model_loader {
 
 /// \brief Logical Process Types.
@@ -38,12 +45,87 @@ enum LogicalProcessType {
   DUMMY = 4
 };
 
-auto loadModel(const std::filesystem::path modelPath) noexcept -> void;
+/// \brief A predicate that decides whether the service with the specified
+///        global identifier is hosted by this node, given the total number of
+///        services in the model.
+using HostPredicate =
+    std::function<bool(const tw_lpid gid, const std::size_t serviceCount)>;
+
+/// \brief Loads the model from the specified model file.
+///
+/// A machine, link or switch element with a `count` attribute declares that
+/// many identical services with consecutive identifiers starting at its `id`,
+/// and the ends of a range of links advance by its `from_stride` and
+/// `to_stride` attributes. A master's slaves may be listed as ranges, such as
+/// `{"first": 10, "count": 1000}`. The ranges are only expanded as they are
+/// registered, such that the model file's size and parse time depend on the
+/// number of distinct services rather than on the number of services.
+///
+/// The services' identifiers must be the dense global identifiers `0..N-1`,
+/// unless the identifier remapping is enabled (see
+/// `enableIdentifierRemapping`).
+///
+/// Once the model file has been parsed and validated, a binary snapshot of
+/// the model is written next to it (with the `.snapshot` extension). In the
+/// following runs, if the model file's hash and size match the snapshot's,
+/// the model is restored from the snapshot instead of being parsed.
+///
+/// If a host predicate is specified, the model is materialized rank-locally:
+/// the whole model is still validated, but the configurations, schedulers,
+/// route selectors and workloads are only created for the hosted services.
+/// The links and the masters' slaves are registered for every service, since
+/// the routes are computed from them.
+///
+/// \param modelPath The path to the model file.
+/// \param useSnapshot If false, the snapshot is neither read nor written.
+/// \param isHosted If specified, the predicate of the hosted services.
+auto loadModel(const std::filesystem::path modelPath,
+               const bool useSnapshot = true,
+               const HostPredicate &isHosted = nullptr) noexcept -> void;
+
+/// \brief Loads the model from the contents of the specified model file,
+///        which have already been read into memory.
+///
+/// It is used when the model file has been read once and broadcast to the
+/// ranks (see `ispd::input::read`), such that the ranks parse it from memory.
+///
+/// \param contents The model file's contents.
+/// \param isHosted If specified, the predicate of the hosted services (see
+///                 `loadModel`).
+auto loadModelFromMemory(const std::string_view contents,
+                         const HostPredicate &isHosted = nullptr) noexcept
+    -> void;
+
+/// \brief Enables the remapping of the services' identifiers, which must be
+///        called before the model is loaded.
+///
+/// The services may then be identified by sparse integers or by strings in
+/// the model specification. Each identifier is assigned the next dense global
+/// identifier the first time it is declared or referenced, and every
+/// referenced identifier must be declared. A range of services is identified
+/// by its first integer identifier, as if its identifiers were listed one by
+/// one.
+///
+/// \note The route files must still be written with the global identifiers,
+///       and the implicit routing providers cannot be used, since they rely
+///       on the services' numbering. The routes computed from the links are
+///       not affected.
+auto enableIdentifierRemapping() noexcept -> void;
 
 [[nodiscard]] auto getLogicalProcessType(const tw_lpid gid) noexcept
     -> LogicalProcessType;
 
-[[nodiscard]] auto getServicesSize() noexcept
-    -> std::unordered_map<tw_lpid, LogicalProcessType>::size_type;
+[[nodiscard]] auto getServicesSize() noexcept -> std::size_t;
+
+/// \brief Returns the model identifier of the service with the specified
+///        global identifier, with which the service is reported.
+///
+/// If the identifiers are not remapped, it is the global identifier itself.
+[[nodiscard]] auto getServiceIdentifier(const tw_lpid gid) -> std::string;
+
+/// \brief Returns the materialized workloads, indexed by the global
+///        identifier of the master to which each one has been assigned.
+[[nodiscard]] auto getWorkloads() noexcept
+    -> const std::unordered_map<tw_lpid, ispd::workload::Workload *> &;
 
 } // namespace ispd::model_loader
\ No newline at end of file
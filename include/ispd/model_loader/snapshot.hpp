@@ -0,0 +1,317 @@
+#ifndef ISPD_MODEL_LOADER_SNAPSHOT_HPP
+#define ISPD_MODEL_LOADER_SNAPSHOT_HPP
+
+#include <ross.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <type_traits>
+
+namespace ispd::model_loader {
+
+/// \brief The magic number that identifies a model snapshot.
+inline constexpr char g_SnapshotMagic[8] = {'I', 'S', 'P', 'D',
+                                            'M', 'S', 'N', '\0'};
+
+/// \brief The model snapshot format version.
+///
+/// It must be incremented every time a record or the layout described in
+/// `SnapshotHeader` changes, or whenever the model loader starts deriving
+/// the records differently from the model specification.
+inline constexpr std::uint32_t g_SnapshotVersion = 3;
+
+/// \brief A known value written in the snapshot header, such that a snapshot
+///        written in a machine with a different byte order is detected.
+inline constexpr std::uint64_t g_SnapshotByteOrderMark = 0x0102030405060708ULL;
+
+/// \brief The loading options from which the records are derived differently,
+///        as stored in the snapshot header. A snapshot taken with different
+///        options is never restored.
+inline constexpr std::uint64_t g_SnapshotRemappedIdentifiers = 1;
+
+/// \brief The kinds of the components selected by name in the model
+///        specification, as stored in the snapshot records.
+enum class SchedulerKind : std::uint32_t { ROUND_ROBIN = 0 };
+enum class RouteSelectorKind : std::uint32_t {
+  FIRST = 0,
+  ECMP = 1,
+  ROUND_ROBIN = 2,
+  LEAST_WAITED = 3
+};
+enum class WorkloadKind : std::uint32_t { UNIFORM = 0, CONSTANT = 1 };
+enum class InterarrivalKind : std::uint32_t {
+  POISSON = 0,
+  FIXED = 1,
+  EXPONENTIAL = 2,
+  WEIBULL = 3
+};
+enum class RoutingProviderKind : std::uint32_t {
+  STAR = 0,
+  TREE = 1,
+  FAT_TREE = 2,
+  TORUS = 3
+};
+
+/// \brief A range of a snapshot pool, which is either the string pool or the
+///        global identifier pool.
+struct PoolRange final {
+  std::uint64_t m_First;
+  std::uint64_t m_Count;
+};
+
+/// \brief The records of the validated model elements. Each one holds the
+///        arguments with which its element is registered.
+///
+/// A service record describes a range of `m_Count` services with consecutive
+/// global identifiers starting at `m_Id`, which are expanded as the record is
+/// registered.
+struct UserRecord final {
+  PoolRange m_Name;
+  double m_EnergyConsumptionLimit;
+};
+
+struct WorkloadRecord final {
+  tw_lpid m_MasterId;
+  PoolRange m_Owner;
+  WorkloadKind m_Kind;
+  std::uint32_t m_RemainingTasks;
+  double m_ComputingOffload;
+  double m_MinProcSize;
+  double m_MaxProcSize;
+  double m_MinCommSize;
+  double m_MaxCommSize;
+  InterarrivalKind m_InterarrivalKind;
+  std::uint32_t m_Padding;
+  double m_InterarrivalMean;  ///< The lambda, interval or mean.
+  double m_InterarrivalShape; ///< The Weibull distribution's shape.
+};
+
+struct MasterRecord final {
+  tw_lpid m_Id;
+  SchedulerKind m_Scheduler;
+  RouteSelectorKind m_RouteSelector;
+  PoolRange m_Slaves;
+};
+
+struct MachineRecord final {
+  tw_lpid m_Id;
+  tw_lpid m_Count;
+  double m_Power;
+  double m_Load;
+  std::uint32_t m_CoreCount;
+  std::uint32_t m_GpuCoreCount;
+  double m_GpuPower;
+  double m_InterconnectionBandwidth;
+  double m_WattageIdle;
+  double m_WattageMax;
+};
+
+struct LinkRecord final {
+  tw_lpid m_Id;
+  tw_lpid m_Count;
+  tw_lpid m_From;       ///< The first link's upward end.
+  tw_lpid m_To;         ///< The first link's downward end.
+  tw_lpid m_FromStride; ///< The upward end's increment from link to link.
+  tw_lpid m_ToStride;   ///< The downward end's increment from link to link.
+  double m_Bandwidth;
+  double m_Load;
+  double m_Latency;
+};
+
+struct SwitchRecord final {
+  tw_lpid m_Id;
+  tw_lpid m_Count;
+  double m_Bandwidth;
+  double m_Load;
+  double m_Latency;
+};
+
+struct RoutingRecord final {
+  RoutingProviderKind m_Kind;
+  std::uint32_t m_Depth;
+  tw_lpid m_MasterCount;
+  tw_lpid m_MachineCount;
+  tw_lpid m_Arity;
+  tw_lpid m_K;
+  PoolRange m_Dimensions;
+};
+
+/// \struct SnapshotHeader
+///
+/// \brief The header of a model snapshot file.
+///
+/// The header is followed by the sections of users, workloads, masters,
+/// machines, links, switches and routing records, the services' model
+/// identifiers, the global identifier pool and the string pool, in this
+/// order. Each section is padded to a multiple of eight bytes.
+struct SnapshotHeader final {
+  char m_Magic[8];             ///< Must match `g_SnapshotMagic`.
+  std::uint32_t m_Version;     ///< Must match `g_SnapshotVersion`.
+  std::uint32_t m_LpidWidth;   ///< Must match `sizeof(tw_lpid)`.
+  std::uint64_t m_ByteOrder;   ///< Must match `g_SnapshotByteOrderMark`.
+  std::uint64_t m_SourceHash;  ///< The hash of the model specification.
+  std::uint64_t m_SourceSize;  ///< The model specification size in bytes.
+  std::uint64_t m_Options;     ///< The loading options of the snapshot.
+  std::uint64_t m_Counts[10];  ///< The number of items in each section.
+
+  /// \brief Returns %true if the header identifies a snapshot that can be
+  ///        read in this build and that has been taken from the model
+  ///        specification with the specified hash and size, with the
+  ///        specified loading options.
+  [[nodiscard]] auto matches(const std::uint64_t sourceHash,
+                             const std::uint64_t sourceSize,
+                             const std::uint64_t options) const noexcept
+      -> bool {
+    return std::memcmp(m_Magic, g_SnapshotMagic, sizeof(m_Magic)) == 0 &&
+           m_Version == g_SnapshotVersion && m_LpidWidth == sizeof(tw_lpid) &&
+           m_ByteOrder == g_SnapshotByteOrderMark &&
+           m_SourceHash == sourceHash && m_SourceSize == sourceSize &&
+           m_Options == options;
+  }
+};
+
+static_assert(sizeof(SnapshotHeader) % sizeof(std::uint64_t) == 0,
+              "The snapshot header size must keep the sections aligned.");
+
+/// \class ModelSnapshot
+///
+/// \brief A compact binary snapshot of a validated model.
+///
+/// The snapshot holds the records of every element of a model, in their
+/// registration order, which are collected as the model specification is
+/// loaded. Since the records have already been validated, a model whose
+/// specification has not changed is restored by replaying its records,
+/// which are bulk read from the snapshot file without any parsing.
+///
+/// The logical process type of each service is implied by the section of its
+/// record, such that registering the records restores it as well.
+///
+/// If the services' model identifiers are remapped, the records hold the
+/// remapped global identifiers, and the model identifier of each global
+/// identifier is stored in the string pool.
+class ModelSnapshot {
+  std::vector<UserRecord> m_Users;
+  std::vector<WorkloadRecord> m_Workloads;
+  std::vector<MasterRecord> m_Masters;
+  std::vector<MachineRecord> m_Machines;
+  std::vector<LinkRecord> m_Links;
+  std::vector<SwitchRecord> m_Switches;
+  std::vector<RoutingRecord> m_Routings;
+  std::vector<PoolRange> m_Identifiers;
+  std::vector<tw_lpid> m_Lpids;
+  std::string m_Strings;
+
+public:
+  /// \brief Adds the string to the string pool.
+  [[nodiscard]] auto addString(const std::string_view string) -> PoolRange {
+    const PoolRange range{m_Strings.size(), string.size()};
+
+    m_Strings.append(string);
+    return range;
+  }
+
+  /// \brief Adds the global identifiers to the global identifier pool.
+  [[nodiscard]] auto addLpids(const std::vector<tw_lpid> &lpids) -> PoolRange {
+    const PoolRange range{m_Lpids.size(), lpids.size()};
+
+    m_Lpids.insert(m_Lpids.end(), lpids.cbegin(), lpids.cend());
+    return range;
+  }
+
+  /// \brief Adds the model identifier of the next global identifier.
+  auto addIdentifier(const std::string_view identifier) -> void {
+    m_Identifiers.push_back(addString(identifier));
+  }
+
+  [[nodiscard]] auto getString(const PoolRange range) const -> std::string {
+    return m_Strings.substr(range.m_First, range.m_Count);
+  }
+
+  [[nodiscard]] auto getLpids(const PoolRange range) const
+      -> std::vector<tw_lpid> {
+    return std::vector<tw_lpid>(m_Lpids.cbegin() + range.m_First,
+                                m_Lpids.cbegin() + range.m_First +
+                                    range.m_Count);
+  }
+
+  auto add(const UserRecord &record) -> void { m_Users.push_back(record); }
+  auto add(const WorkloadRecord &record) -> void {
+    m_Workloads.push_back(record);
+  }
+  auto add(const MasterRecord &record) -> void { m_Masters.push_back(record); }
+  auto add(const MachineRecord &record) -> void {
+    m_Machines.push_back(record);
+  }
+  auto add(const LinkRecord &record) -> void { m_Links.push_back(record); }
+  auto add(const SwitchRecord &record) -> void {
+    m_Switches.push_back(record);
+  }
+  auto add(const RoutingRecord &record) -> void {
+    m_Routings.push_back(record);
+  }
+
+  [[nodiscard]] auto getUsers() const noexcept
+      -> const std::vector<UserRecord> & {
+    return m_Users;
+  }
+  [[nodiscard]] auto getWorkloads() const noexcept
+      -> const std::vector<WorkloadRecord> & {
+    return m_Workloads;
+  }
+  [[nodiscard]] auto getMasters() const noexcept
+      -> const std::vector<MasterRecord> & {
+    return m_Masters;
+  }
+  [[nodiscard]] auto getMachines() const noexcept
+      -> const std::vector<MachineRecord> & {
+    return m_Machines;
+  }
+  [[nodiscard]] auto getLinks() const noexcept
+      -> const std::vector<LinkRecord> & {
+    return m_Links;
+  }
+  [[nodiscard]] auto getSwitches() const noexcept
+      -> const std::vector<SwitchRecord> & {
+    return m_Switches;
+  }
+  [[nodiscard]] auto getRoutings() const noexcept
+      -> const std::vector<RoutingRecord> & {
+    return m_Routings;
+  }
+  [[nodiscard]] auto getIdentifiers() const noexcept
+      -> const std::vector<PoolRange> & {
+    return m_Identifiers;
+  }
+
+  /// \brief Writes the snapshot to the specified file.
+  ///
+  /// The snapshot is written to a temporary file, which then replaces the
+  /// specified file, such that a concurrent reader never sees a partially
+  /// written snapshot.
+  ///
+  /// \returns False if the snapshot could not be written.
+  auto save(const std::filesystem::path &path, const std::uint64_t sourceHash,
+            const std::uint64_t sourceSize, const std::uint64_t options) const
+      -> bool;
+
+  /// \brief Reads the snapshot from the specified file.
+  ///
+  /// \returns False if the file does not exist or has not been taken from the
+  ///          model specification with the specified hash and size, with the
+  ///          specified loading options, in which case the snapshot is left
+  ///          empty.
+  auto load(const std::filesystem::path &path, const std::uint64_t sourceHash,
+            const std::uint64_t sourceSize, const std::uint64_t options)
+      -> bool;
+
+  /// \brief Returns the 64-bit hash of the specified bytes.
+  [[nodiscard]] static auto hash(const char *data, const std::size_t size)
+      -> std::uint64_t;
+};
+
+} // namespace ispd::model_loader
+
+#endif // ISPD_MODEL_LOADER_SNAPSHOT_HPP
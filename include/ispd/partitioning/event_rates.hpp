@@ -0,0 +1,54 @@
+#ifndef ISPD_PARTITIONING_EVENT_RATES_HPP
+#define ISPD_PARTITIONING_EVENT_RATES_HPP
+
+#include <vector>
+#include <cstdint>
+
+/// \brief The estimation of the events processed by each logical process
+///        (LP), computed from the loaded model before the simulation starts.
+///
+/// Each task generated by a master is sent through a route of links to one
+/// of its slaves and its results are sent back through the same route. Hence,
+/// a task costs two events at its master (its generation and the arrival of
+/// its results), two events at each link and at each service forwarding it,
+/// and one event at its slave. The tasks are spread through the slaves as by
+/// the round-robin scheduler and through the alternative routes evenly.
+namespace ispd::event_rates {
+
+/// \struct EventEstimate
+///
+/// \brief The expected number of events processed by the services during the
+///        whole simulation, which is their mean event rate times the
+///        simulated time.
+struct EventEstimate final {
+  /// \brief The expected events of each service, indexed by its global
+  ///        identifier.
+  std::vector<std::uint64_t> m_Events;
+
+  /// \brief The expected tasks sent through each link, in both directions,
+  ///        indexed by its row in the link table.
+  ///
+  /// Each task sent through a link costs two events between the link and
+  /// each of its ends.
+  std::vector<std::uint64_t> m_LinkTasks;
+};
+
+/// \brief Estimates the events processed by the loaded model's services.
+///
+/// The tasks generated by each master are the remaining tasks of its
+/// workload, bounded by the tasks that arrive before the simulation ends
+/// according to its interarrival mean. The routes are taken from the
+/// implicit routing provider, if the model has selected one. Otherwise, since
+/// the routes are only loaded after the LPs have been mapped, each task is
+/// assumed to follow a route with the fewest hops to its slave.
+///
+/// The estimation is exact in integers, such that every rank computes the
+/// same one, whatever the number of threads.
+///
+/// \param threadCount The number of threads. If zero, the hardware
+///                    concurrency is used.
+[[nodiscard]] auto estimate(unsigned threadCount = 0) -> EventEstimate;
+
+}; // namespace ispd::event_rates
+
+#endif // ISPD_PARTITIONING_EVENT_RATES_HPP
@@ -0,0 +1,68 @@
+#ifndef ISPD_PARTITIONING_LP_MAPPING_HPP
+#define ISPD_PARTITIONING_LP_MAPPING_HPP
+
+#include <ross.h>
+
+/// \brief The partitioned mapping of the logical processes (LP) to the
+///        processing elements (PE).
+///
+/// By default, the LPs are mapped to the PEs in blocks of consecutive global
+/// identifiers, such that a master, its links and its machines usually end up
+/// in different PEs and nearly every hop of a task is a remote event. Instead,
+/// the graph whose vertices are the services and whose edges connect each
+/// link to its ends, through which every event is sent, is partitioned into
+/// one part per PE, minimizing the edges between different parts while
+/// keeping the parts balanced. The services and the edges are weighted by
+/// their expected events (see `ispd::event_rates::estimate`), such that each
+/// PE is expected to process nearly the same number of events. The mapping is
+/// installed through the ROSS custom mapping hooks.
+namespace ispd::lp_mapping {
+
+/// \brief Partitions the loaded model's services through the specified
+///        number of processing elements, which enables the partitioned
+///        mapping.
+///
+/// Every rank computes the same partition, which is deterministic.
+///
+/// \param peCount The number of processing elements.
+/// \param imbalance The tolerated imbalance of the partition (see
+///                  `ispd::partitioning::partition`).
+/// \param threadCount The number of partitioning threads. If zero, the
+///                    hardware concurrency is used.
+///
+/// \note If a processing element is left with no service, the program is
+///       immediately aborted.
+auto build(const tw_peid peCount, const double imbalance,
+           const unsigned threadCount = 0) -> void;
+
+/// \brief Returns true if the partitioned mapping has been built.
+[[nodiscard]] auto isEnabled() noexcept -> bool;
+
+/// \brief Returns the processing element to which the specified service is
+///        mapped.
+[[nodiscard]] auto getPe(const tw_lpid gid) noexcept -> tw_peid;
+
+/// \brief Returns the number of services mapped to this processing element.
+[[nodiscard]] auto getLocalLpCount() noexcept -> tw_lpid;
+
+/// \brief Returns the global identifier of the service with the specified
+///        local identifier in this processing element.
+[[nodiscard]] auto getLocalGid(const tw_lpid index) noexcept -> tw_lpid;
+
+/// \brief Places the services mapped to this processing element on it and on
+///        its kernel processes, in the order of their global identifiers.
+///
+/// It is the ROSS custom initial mapping (`g_tw_custom_initial_mapping`),
+/// which is called while the LPs are defined.
+auto mapLocalLps() -> void;
+
+/// \brief Returns the LP of the specified service, which must be mapped to
+///        this processing element.
+///
+/// It is the ROSS custom global-to-local mapping
+/// (`g_tw_custom_lp_global_to_local_map`).
+[[nodiscard]] auto getLocalLp(const tw_lpid gid) -> tw_lp *;
+
+}; // namespace ispd::lp_mapping
+
+#endif // ISPD_PARTITIONING_LP_MAPPING_HPP
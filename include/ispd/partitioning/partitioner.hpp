@@ -0,0 +1,100 @@
+#ifndef ISPD_PARTITIONING_PARTITIONER_HPP
+#define ISPD_PARTITIONING_PARTITIONER_HPP
+
+#include <vector>
+#include <cstdint>
+
+namespace ispd::partitioning {
+
+/// \brief A vertex of a graph to be partitioned, which is the global
+///        identifier of a logical process.
+using Vertex = std::uint32_t;
+
+/// \brief The part to which a vertex is assigned.
+using PartId = std::uint32_t;
+
+/// \brief The weight of a vertex or of an edge.
+using Weight = std::uint64_t;
+
+/// \struct Edge
+///
+/// \brief An undirected weighted edge given to `Graph::build`.
+struct Edge final {
+  Vertex m_First;
+  Vertex m_Second;
+  Weight m_Weight;
+};
+
+/// \struct Graph
+///
+/// \brief An undirected graph with weighted vertices and edges, stored in the
+///        compressed sparse row (CSR) layout.
+///
+/// The neighbors of the vertex `v` are in `[m_Offsets[v], m_Offsets[v + 1])`
+/// of `m_Adjacency`, along with the weights of the edges to them.
+/// Every edge is stored in both directions, and there are neither self loops
+/// nor parallel edges.
+struct Graph final {
+  std::vector<std::uint64_t> m_Offsets = {0};
+  std::vector<Vertex> m_Adjacency;
+  std::vector<Weight> m_EdgeWeights;
+  std::vector<Weight> m_VertexWeights;
+
+  /// \brief Builds the graph with the specified vertex weights and edges.
+  ///
+  /// The self loops are dropped, and the parallel edges are merged into a
+  /// single edge whose weight is the sum of theirs.
+  [[nodiscard]] static auto build(std::vector<Weight> vertexWeights,
+                                  const std::vector<Edge> &edges) -> Graph;
+
+  /// \brief Returns the number of vertices.
+  [[nodiscard]] inline auto size() const noexcept -> std::size_t {
+    return m_VertexWeights.size();
+  }
+
+  /// \brief Returns the sum of the vertices' weights.
+  [[nodiscard]] auto getTotalVertexWeight() const noexcept -> Weight;
+};
+
+/// \brief Partitions the specified graph into the specified number of parts,
+///        minimizing the weight of the edges between different parts (the
+///        edge cut) while keeping the parts' weights balanced.
+///
+/// It is a multilevel recursive bisection, as popularized by METIS. Each
+/// bisection coarsens the graph by collapsing heavy-edge matchings, bisects
+/// the coarsest graph by greedy graph growing, and refines the bisection by
+/// Fiduccia-Mattheyses passes while the graph is projected back to the finer
+/// levels. The k-way partition is finally refined by greedy moves of the
+/// boundary vertices, which also restore the balance if it has been lost.
+///
+/// The partitioning is deterministic, such that every rank computes the same
+/// partition from the same graph, whatever the number of threads.
+///
+/// \param graph The graph to be partitioned.
+/// \param partCount The number of parts.
+/// \param imbalance The tolerated imbalance, such that no part weighs more
+///                  than `(1 + imbalance)` times the average part weight, if
+///                  the vertices' weights allow it.
+/// \param threadCount The number of threads, which partition the halves of
+///                    the bisections concurrently. If zero, the hardware
+///                    concurrency is used.
+///
+/// \return The part of each vertex.
+[[nodiscard]] auto partition(const Graph &graph, const PartId partCount,
+                             const double imbalance,
+                             unsigned threadCount = 0) -> std::vector<PartId>;
+
+/// \brief Returns the weight of the edges between different parts.
+[[nodiscard]] auto getEdgeCut(const Graph &graph,
+                              const std::vector<PartId> &parts) noexcept
+    -> Weight;
+
+/// \brief Returns the weight of the heaviest part divided by the average part
+///        weight.
+[[nodiscard]] auto getImbalance(const Graph &graph,
+                                const std::vector<PartId> &parts,
+                                const PartId partCount) -> double;
+
+}; // namespace ispd::partitioning
+
+#endif // ISPD_PARTITIONING_PARTITIONER_HPP
@@ -0,0 +1,42 @@
+#ifndef ISPD_PROFILER_HPP
+#define ISPD_PROFILER_HPP
+
+#include <cstdint>
+#include <lib/nlohmann/json.hpp>
+
+/// \brief The startup phase profiler.
+///
+/// Each startup phase (such as loading the model or the routes) is measured
+/// by every rank with its wall time, the growth of the peak resident set size
+/// (RSS) of the process and the number of items it has processed (such as
+/// services or routes). Once the startup is over, the measures are reduced
+/// through the ranks, such that the slowest phases and the most imbalanced
+/// ranks are easily found.
+namespace ispd::profiler {
+
+/// \brief Begins the startup phase with the specified name, which ends at the
+///        next call to `endPhase`.
+///
+/// \note The phases must not be nested, and every rank must go through the
+///       same phases in the same order.
+auto beginPhase(const char *const name) noexcept -> void;
+
+/// \brief Ends the current startup phase.
+///
+/// \param itemCount The number of items processed by this rank in the phase.
+auto endPhase(const std::uint64_t itemCount = 0) noexcept -> void;
+
+/// \brief Reduces the startup phases through the ranks and prints the
+///        minimum, the average and the maximum of each phase's measures.
+///
+/// It is a collective call, which must be made by every rank once the
+/// startup is over and before the simulation starts.
+auto reportPhases() noexcept -> void;
+
+/// \brief Returns the reduced startup phases, as written to the global
+///        metrics report, or null if they have not been reported.
+[[nodiscard]] auto getPhasesReport() noexcept -> const nlohmann::json &;
+
+} // namespace ispd::profiler
+
+#endif // ISPD_PROFILER_HPP
@@ -0,0 +1,59 @@
+/// \file ecmp.hpp
+///
+/// \brief This file defines the Ecmp class, a concrete implementation of the
+/// RouteSelector interface.
+///
+/// The Ecmp class implements the equal-cost multipath (ECMP) selection, which
+/// hashes the task's flow identifier, namely, its master, its slave and its
+/// submission time, to spread the tasks uniformly among the alternative
+/// routes.
+///
+#pragma once
+
+#include <cstring>
+#include <ispd/route_selector/route_selector.hpp>
+
+namespace ispd::route_selector {
+
+/// \class Ecmp
+///
+/// \brief Implements the hash-based equal-cost multipath route selection.
+///
+/// Since the selection is a pure function of the event being processed, it is
+/// recomputed identically if the event is processed again and, thus, there is
+/// nothing to be reversed.
+///
+class Ecmp final : public RouteSelector {
+private:
+  /// \brief Mixes the bits of the specified value (SplitMix64 finalizer).
+  [[nodiscard]] static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+  }
+
+public:
+  void initSelector() override {}
+
+  [[nodiscard]] std::uint32_t forwardSelect(const tw_lpid dest,
+                                            const std::uint32_t routeCount,
+                                            tw_bf *bf, ispd_message *msg,
+                                            tw_lp *lp) override {
+    const double now = tw_now(lp);
+    std::uint64_t nowBits;
+
+    std::memcpy(&nowBits, &now, sizeof(nowBits));
+
+    const std::uint64_t hash = mix(mix(mix(lp->gid) ^ dest) ^ nowBits);
+
+    return static_cast<std::uint32_t>(hash % routeCount);
+  }
+
+  void reverseSelect(const tw_lpid dest, tw_bf *bf, ispd_message *msg,
+                     tw_lp *lp) override {}
+};
+
+} // namespace ispd::route_selector
@@ -0,0 +1,36 @@
+/// \file first.hpp
+///
+/// \brief This file defines the First class, a concrete implementation of the
+/// RouteSelector interface.
+///
+/// The First class always selects the first route given for a (master, slave)
+/// pair, which is the behavior of a single path routing.
+///
+#pragma once
+
+#include <ispd/route_selector/route_selector.hpp>
+
+namespace ispd::route_selector {
+
+/// \class First
+///
+/// \brief Implements the single path route selection.
+///
+/// Since the selection is always the same, there is nothing to be reversed.
+///
+class First final : public RouteSelector {
+public:
+  void initSelector() override {}
+
+  [[nodiscard]] std::uint32_t forwardSelect(const tw_lpid dest,
+                                            const std::uint32_t routeCount,
+                                            tw_bf *bf, ispd_message *msg,
+                                            tw_lp *lp) override {
+    return 0;
+  }
+
+  void reverseSelect(const tw_lpid dest, tw_bf *bf, ispd_message *msg,
+                     tw_lp *lp) override {}
+};
+
+} // namespace ispd::route_selector
@@ -0,0 +1,101 @@
+/// \file least_waited.hpp
+///
+/// \brief This file defines the LeastWaited class, a concrete implementation
+/// of the RouteSelector interface.
+///
+/// The LeastWaited class selects the route whose last task has waited the
+/// least at the route's links. The waiting times are fed back by the tasks'
+/// results arriving at the master, whose messages accumulate the waiting time
+/// of every link they traverse, in both directions.
+///
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <ispd/route_selector/route_selector.hpp>
+
+namespace ispd::route_selector {
+
+/// \class LeastWaited
+///
+/// \brief Implements the least-recently-waited route selection.
+///
+/// The ties, as the ones before any feedback has arrived, are broken in a
+/// round-robin manner among the routes with the least waiting time, such that
+/// the selection is reversed by only decrementing the slave's task count. The
+/// feedback is reversed by restoring the waiting time that it has replaced,
+/// which is saved into the arriving message.
+///
+class LeastWaited final : public RouteSelector {
+private:
+  /// \struct SlaveRoutes
+  ///
+  /// \brief The selection state of the routes to a single slave.
+  struct SlaveRoutes {
+    /// \brief The number of tasks sent to the slave.
+    std::uint64_t m_SentTasks = 0;
+
+    /// \brief The waiting time of the last task fed back through each route.
+    std::vector<double> m_Waiting;
+  };
+
+  std::unordered_map<tw_lpid, SlaveRoutes> m_Slaves;
+
+public:
+  void initSelector() override { m_Slaves.clear(); }
+
+  [[nodiscard]] std::uint32_t forwardSelect(const tw_lpid dest,
+                                            const std::uint32_t routeCount,
+                                            tw_bf *bf, ispd_message *msg,
+                                            tw_lp *lp) override {
+    SlaveRoutes &routes = m_Slaves[dest];
+
+    if (routes.m_Waiting.size() != routeCount)
+      routes.m_Waiting.resize(routeCount, 0.0);
+
+    /// Find the least waiting time and count the routes that have it.
+    double leastWaiting = routes.m_Waiting[0];
+    std::uint32_t tieCount = 0;
+
+    for (const double waiting : routes.m_Waiting) {
+      if (waiting < leastWaiting) {
+        leastWaiting = waiting;
+        tieCount = 1;
+      } else if (waiting == leastWaiting) {
+        tieCount++;
+      }
+    }
+
+    /// Select among the tied routes in a round-robin manner.
+    std::uint32_t tie = routes.m_SentTasks++ % tieCount;
+
+    for (std::uint32_t i = 0; i < routeCount; i++)
+      if (routes.m_Waiting[i] == leastWaiting && tie-- == 0)
+        return i;
+
+    return 0;
+  }
+
+  void reverseSelect(const tw_lpid dest, tw_bf *bf, ispd_message *msg,
+                     tw_lp *lp) override {
+    m_Slaves[dest].m_SentTasks--;
+  }
+
+  void forwardFeedback(ispd_message *msg, tw_lp *lp) override {
+    SlaveRoutes &routes = m_Slaves[msg->task.m_Dest];
+
+    if (routes.m_Waiting.size() <= msg->route_index)
+      routes.m_Waiting.resize(msg->route_index + 1, 0.0);
+
+    /// Save the replaced waiting time (for reverse computation).
+    msg->saved_route_waiting_time = routes.m_Waiting[msg->route_index];
+    routes.m_Waiting[msg->route_index] = msg->route_waiting_time;
+  }
+
+  void reverseFeedback(ispd_message *msg, tw_lp *lp) override {
+    m_Slaves[msg->task.m_Dest].m_Waiting[msg->route_index] =
+        msg->saved_route_waiting_time;
+  }
+};
+
+} // namespace ispd::route_selector
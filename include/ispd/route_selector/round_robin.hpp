@@ -0,0 +1,46 @@
+/// \file round_robin.hpp
+///
+/// \brief This file defines the RoundRobin class, a concrete implementation of
+/// the RouteSelector interface.
+///
+/// The RoundRobin class cycles through the alternative routes of each slave
+/// in a circular manner, such that consecutive tasks sent to the same slave
+/// follow different routes.
+///
+#pragma once
+
+#include <unordered_map>
+#include <ispd/route_selector/route_selector.hpp>
+
+namespace ispd::route_selector {
+
+/// \class RoundRobin
+///
+/// \brief Implements the round-robin route selection.
+///
+/// The number of tasks sent to each slave is tracked and the selected route is
+/// that number modulo the route count. Therefore, the selection is reversed by
+/// only decrementing that number.
+///
+class RoundRobin final : public RouteSelector {
+private:
+  /// \brief The number of tasks sent to each slave.
+  std::unordered_map<tw_lpid, std::uint64_t> m_SentTasks;
+
+public:
+  void initSelector() override { m_SentTasks.clear(); }
+
+  [[nodiscard]] std::uint32_t forwardSelect(const tw_lpid dest,
+                                            const std::uint32_t routeCount,
+                                            tw_bf *bf, ispd_message *msg,
+                                            tw_lp *lp) override {
+    return static_cast<std::uint32_t>(m_SentTasks[dest]++ % routeCount);
+  }
+
+  void reverseSelect(const tw_lpid dest, tw_bf *bf, ispd_message *msg,
+                     tw_lp *lp) override {
+    m_SentTasks[dest]--;
+  }
+};
+
+} // namespace ispd::route_selector
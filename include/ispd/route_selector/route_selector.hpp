@@ -0,0 +1,72 @@
+#ifndef ISPD_ROUTE_SELECTOR_HPP
+#define ISPD_ROUTE_SELECTOR_HPP
+
+#include <ross.h>
+#include <cstdint>
+#include <ispd/message/message.hpp>
+
+/// \namespace ispd::route_selector
+///
+/// \brief Contains classes related to the multipath route selection policies.
+namespace ispd::route_selector {
+
+/// \class RouteSelector
+///
+/// \brief Represents an abstract base class for the policy that selects one
+///        of the alternative routes connecting a master to a slave.
+///
+/// The routing table keeps every route given for a (master, slave) pair. At
+/// generating a task, the master asks its route selector which of these routes
+/// the task must follow. As every other state change in the simulation, the
+/// selection must be reversible, such that any information needed to reverse
+/// it must be kept by the selector or saved into the message.
+class RouteSelector {
+public:
+  /// \brief Initializes the route selector.
+  virtual void initSelector() = 0;
+
+  /// \brief Selects the route that a task sent to the specified slave must
+  ///        follow.
+  ///
+  /// \param dest The slave to which the task is sent.
+  /// \param routeCount The number of alternative routes to the slave, which
+  ///                   is always positive.
+  /// \param bf A pointer to the bitfield of the event being processed.
+  /// \param msg A pointer to the message being processed.
+  /// \param lp A pointer to the logical process performing the selection.
+  ///
+  /// \return The index, in `[0, routeCount)`, of the selected route.
+  [[nodiscard]] virtual std::uint32_t
+  forwardSelect(const tw_lpid dest, const std::uint32_t routeCount,
+                tw_bf *const bf, ispd_message *const msg,
+                tw_lp *const lp) = 0;
+
+  /// \brief Reverses the selection performed by `forwardSelect` for the same
+  ///        event.
+  ///
+  /// \param dest The slave to which the task has been sent.
+  /// \param bf A pointer to the bitfield of the event being reversed.
+  /// \param msg A pointer to the message being reversed.
+  /// \param lp A pointer to the logical process performing the selection.
+  virtual void reverseSelect(const tw_lpid dest, tw_bf *const bf,
+                             ispd_message *const msg, tw_lp *const lp) = 0;
+
+  /// \brief Notifies the selector of a task's results arriving back at the
+  ///        master, whose message carries the route it has followed and the
+  ///        waiting time accumulated at the route's links.
+  ///
+  /// \param msg A pointer to the arriving message.
+  /// \param lp A pointer to the logical process receiving the results.
+  virtual void forwardFeedback(ispd_message *const msg, tw_lp *const lp) {}
+
+  /// \brief Reverses the feedback performed by `forwardFeedback` for the same
+  ///        event.
+  ///
+  /// \param msg A pointer to the message being reversed.
+  /// \param lp A pointer to the logical process receiving the results.
+  virtual void reverseFeedback(ispd_message *const msg, tw_lp *const lp) {}
+};
+
+} // namespace ispd::route_selector
+
+#endif // ISPD_ROUTE_SELECTOR_HPP
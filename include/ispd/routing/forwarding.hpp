@@ -0,0 +1,157 @@
+#ifndef ISPD_ROUTING_FORWARDING_HPP
+#define ISPD_ROUTING_FORWARDING_HPP
+
+#include <ross.h>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <ispd/log/log.hpp>
+#include <ispd/routing/routing.hpp>
+
+namespace ispd::routing {
+
+/// \struct NextHop
+///
+/// \brief The links through which a forwarding service sends a task of a
+///        route, in each direction.
+struct NextHop final {
+  tw_lpid m_Downward; ///< The next link towards the route's destination.
+  tw_lpid m_Upward;   ///< The next link towards the route's source.
+
+  /// \brief Returns the next link in the specified direction.
+  [[nodiscard]] constexpr auto get(const bool downward) const noexcept
+      -> tw_lpid {
+    return downward ? m_Downward : m_Upward;
+  }
+};
+
+/// \class NextHopTable
+///
+/// \brief A read-only view over the next-hop table of a single forwarding
+///        service, whose entries are sorted by route identifier.
+///
+/// The view is obtained once, at the service's initialization, and is kept
+/// in the service's state. The entries are stored by the `ForwardingTables`
+/// of the processing element that hosts the service.
+class NextHopTable {
+  const RouteId *m_RouteIds = nullptr;
+  const NextHop *m_NextHops = nullptr;
+  std::size_t m_Count = 0;
+
+public:
+  constexpr NextHopTable() noexcept = default;
+
+  [[nodiscard]] constexpr NextHopTable(const RouteId *const routeIds,
+                                       const NextHop *const nextHops,
+                                       const std::size_t count) noexcept
+      : m_RouteIds(routeIds), m_NextHops(nextHops), m_Count(count) {}
+
+  /// \brief Returns the next hops of the route with the specified identifier.
+  ///
+  /// \note If the route does not pass by the service, the program is
+  ///       immediately aborted.
+  [[nodiscard]] inline auto find(const RouteId id) const -> const NextHop & {
+    const RouteId *const last = m_RouteIds + m_Count;
+    const RouteId *const it = std::lower_bound(m_RouteIds, last, id);
+
+    if (it == last || *it != id) [[unlikely]]
+      ispd_error("There is no next hop for the route with identifier %lu.",
+                 id);
+
+    return m_NextHops[it - m_RouteIds];
+  }
+
+  /// \brief Returns the number of routes passing by the service.
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+    return m_Count;
+  }
+};
+
+/// \class ForwardingTables
+///
+/// \brief The next-hop tables of the forwarding services hosted by a
+///        processing element.
+///
+/// Instead of resolving the full path of a route at every hop, a forwarding
+/// service (a switch or a forwarding machine) looks up the route's next link
+/// in its own table, as a router does. The key is the route's identifier
+/// rather than its destination, since the routes from different masters to
+/// the same destination, or the alternative routes between the same vertices,
+/// may leave the service through different links.
+///
+/// The tables of every hosted service are laid out contiguously in the
+/// compressed sparse row (CSR) layout: the sorted services index their
+/// entries, which are sorted by route identifier. Only the entries of the
+/// routes passing by the hosted services are stored, such that the memory
+/// held by a rank is bounded by the routing work of its services.
+class ForwardingTables {
+  std::vector<tw_lpid> m_Services;      ///< The sorted forwarding services.
+  std::vector<std::uint64_t> m_Offsets; ///< The first entry of each service.
+  std::vector<RouteId> m_RouteIds;      ///< The entries' route identifiers.
+  std::vector<NextHop> m_NextHops;      ///< The entries' next hops.
+
+public:
+  /// \brief Builds the next-hop tables of the hosted forwarding services from
+  ///        the routes of the specified demands.
+  ///
+  /// Every route from a demand's source to each of its destinations, as
+  /// served by the provider, is walked. Whenever it passes by a hosted
+  /// forwarding service, which is the downward end of one of its links, the
+  /// links before and after the service are recorded.
+  ///
+  /// \param provider The provider that serves the routes.
+  /// \param demands The sources and destinations whose routes are walked.
+  /// \param edges The links, sorted by their global identifiers.
+  /// \param isHosted The predicate that tells if a vertex is a forwarding
+  ///                 service hosted by this processing element.
+  ///
+  /// \note If a route passes by the same service more than once, the next hop
+  ///       is ambiguous, and the program is immediately aborted.
+  auto build(const RoutingProvider &provider,
+             const std::vector<RouteDemand> &demands,
+             const std::vector<RouteEdge> &edges,
+             const VertexPredicate &isHosted) -> void;
+
+  /// \brief Returns the next-hop table of the specified service, which is
+  ///        empty if no route passes by it.
+  [[nodiscard]] auto getTable(const tw_lpid service) const noexcept
+      -> NextHopTable;
+
+  /// \brief Returns the total number of entries.
+  [[nodiscard]] auto getEntryCount() const noexcept -> std::size_t {
+    return m_RouteIds.size();
+  }
+
+  /// \brief Returns the memory held by the tables, in bytes.
+  [[nodiscard]] auto getMemoryUsage() const noexcept -> std::size_t {
+    return m_Services.size() * sizeof(tw_lpid) +
+           m_Offsets.size() * sizeof(std::uint64_t) +
+           m_RouteIds.size() * sizeof(RouteId) +
+           m_NextHops.size() * sizeof(NextHop);
+  }
+};
+
+}; // namespace ispd::routing
+
+namespace ispd::forwarding_table {
+
+/// \brief Builds the next-hop tables of the forwarding services hosted by this
+///        processing element and enables their use by the services.
+///
+/// \see ispd::routing::ForwardingTables::build
+auto build(const std::vector<ispd::routing::RouteDemand> &demands,
+           const std::vector<ispd::routing::RouteEdge> &edges,
+           const ispd::routing::VertexPredicate &isHosted) -> void;
+
+/// \brief Returns true if the next-hop tables have been built, in which case
+///        the forwarding services look up their next link in them instead of
+///        in the routes' full paths.
+[[nodiscard]] auto isEnabled() noexcept -> bool;
+
+/// \brief Returns the next-hop table of the specified service.
+[[nodiscard]] auto getTable(const tw_lpid service) noexcept
+    -> ispd::routing::NextHopTable;
+
+}; // namespace ispd::forwarding_table
+
+#endif // ISPD_ROUTING_FORWARDING_HPP
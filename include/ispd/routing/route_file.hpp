@@ -0,0 +1,95 @@
+#ifndef ISPD_ROUTING_ROUTE_FILE_HPP
+#define ISPD_ROUTING_ROUTE_FILE_HPP
+
+#include <ross.h>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ispd::routing {
+
+/// \brief The magic number that identifies a compiled route file.
+///
+/// Every compiled route file starts with these eight bytes, which allows the
+/// routing table loader to tell apart a compiled route file from a textual
+/// one without relying on the file's extension.
+inline constexpr char g_RouteFileMagic[8] = {'I', 'S', 'P', 'D',
+                                             'R', 'T', 'B', '\0'};
+
+/// \brief The compiled route file format version.
+///
+/// It must be incremented every time the layout described in
+/// `RouteFileHeader` changes in a non backward compatible way.
+inline constexpr std::uint32_t g_RouteFileVersion = 1;
+
+/// \brief A known value written in the compiled route file header, such that
+///        a file compiled in a machine with a different byte order is
+///        detected instead of silently misread.
+inline constexpr std::uint64_t g_RouteFileByteOrderMark = 0x0102030405060708ULL;
+
+/// \struct RouteFileHeader
+///
+/// \brief The header of a compiled route file.
+///
+/// A compiled route file is produced by the `ispd_routec` tool from the
+/// textual `routes.route` file and is designed to be memory-mapped by every
+/// rank, such that the routes are served directly from the page cache without
+/// any parsing or copying at startup.
+///
+/// The header is followed by six contiguous sections of 64-bit unsigned
+/// integers, in the following order:
+///
+///   1. `sources[SourceCount]`: The sorted source vertices.
+///   2. `sourcePairs[SourceCount + 1]`: For each source, the first index in
+///      the `pairDests` section of its (source, destination) pairs.
+///   3. `pairDests[PairCount]`: The destination vertices, sorted within each
+///      source.
+///   4. `pairRoutes[PairCount + 1]`: For each pair, the first index in the
+///      `routeHops` section of its routes.
+///   5. `routeHops[RouteCount + 1]`: For each route, the first index in the
+///      `hops` section of its path.
+///   6. `hops[HopCount]`: The routes' paths, one after the other.
+///
+/// \note Since the header size is a multiple of eight bytes, every section
+///       is naturally aligned for 64-bit reads when the file is mapped.
+struct RouteFileHeader final {
+  char m_Magic[8];              ///< Must match `g_RouteFileMagic`.
+  std::uint32_t m_Version;      ///< Must match `g_RouteFileVersion`.
+  std::uint32_t m_HopWidth;     ///< Must match `sizeof(tw_lpid)`.
+  std::uint64_t m_ByteOrder;    ///< Must match `g_RouteFileByteOrderMark`.
+  std::uint64_t m_SourceCount;  ///< The number of distinct sources.
+  std::uint64_t m_PairCount;    ///< The number of (source, dest) pairs.
+  std::uint64_t m_RouteCount;   ///< The number of routes.
+  std::uint64_t m_HopCount;     ///< The total number of hops.
+
+  /// \brief Returns the number of 64-bit words that follows the header.
+  [[nodiscard]] constexpr auto getPayloadWords() const noexcept
+      -> std::uint64_t {
+    return m_SourceCount + (m_SourceCount + 1) + m_PairCount +
+           (m_PairCount + 1) + (m_RouteCount + 1) + m_HopCount;
+  }
+
+  /// \brief Returns the expected size in bytes of the whole file.
+  [[nodiscard]] constexpr auto getFileSize() const noexcept -> std::uint64_t {
+    return sizeof(RouteFileHeader) + getPayloadWords() * sizeof(std::uint64_t);
+  }
+
+  /// \brief Returns %true if the header identifies a compiled route file that
+  ///        can be read in this build.
+  [[nodiscard]] auto isCompatible() const noexcept -> bool {
+    return std::memcmp(m_Magic, g_RouteFileMagic, sizeof(m_Magic)) == 0 &&
+           m_Version == g_RouteFileVersion && m_HopWidth == sizeof(tw_lpid) &&
+           m_ByteOrder == g_RouteFileByteOrderMark;
+  }
+};
+
+static_assert(sizeof(RouteFileHeader) % sizeof(std::uint64_t) == 0,
+              "The route file header size must keep the sections aligned.");
+static_assert(std::is_trivially_copyable_v<RouteFileHeader>,
+              "The route file header must be trivially copyable.");
+static_assert(sizeof(tw_lpid) == sizeof(std::uint64_t),
+              "The compiled route file stores the vertices as 64-bit words.");
+
+} // namespace ispd::routing
+
+#endif // ISPD_ROUTING_ROUTE_FILE_HPP
@@ -6,133 +6,101 @@
 #include <vector>
 #include <cstdint>
 #include <fstream>
-#include <numeric>
-#include <type_traits>
-#include <unordered_map>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <functional>
 #include <ispd/log/log.hpp>
+#include <ispd/input/input.hpp>
+#include <ispd/routing/route_file.hpp>
 
 namespace ispd::routing {
 
-namespace {
-
-/// \brief Checks if %T type can be used in Szudzik's pairing function.
-///
-/// This value is %true, if and only if, the type can be used in the
-/// Szudzik's pairing function. The restrctions are that the type must
-/// be an unsigned integer type and must not be unsigned char.
-///
-/// \tparam T Type to be checked.
-template <typename T>
-inline constexpr bool is_szudzik_type_v =
-    std::is_integral_v<T> && std::is_unsigned_v<T> &&
-    !std::is_same_v<T, unsigned char>;
-
-/// \brief Szudzik's Pairing Function
-///
-/// This static function implements Szudzik's Pairing Function, which combines
-/// two non-negative 32-bit integers 'a' and 'b' into a unique 64-bit unsigned
-/// integer result. The returned integer is a combination of 'a' and 'b' that
-/// ensures uniqueness for each pair (a, b).
-///
-/// Szudzik's pairing function provides a way to map a pair of integers onto a
-/// single value, useful for hashing or indexing two-dimensional data
-/// structures. It is a method to transform a pair of non-negative integers into
-/// a single integer, allowing two-dimensional data to be represented as a
-/// one-dimensional index.
-///
-/// The pairing function is defined as follows:
-///
-///     result = a >= b ? a * a + a + b : a + b * b
-///
-/// \param a The first non-negative 32-bit integer.
-/// \param b The second non-negative 32-bit integer.
-/// \return A 64-bit integer representing the unique pairing of 'a' and 'b'.
-///
-/// \note Szudzik's pairing function is invertible, meaning that it can be
-///       reversed to extract 'a' and 'b' from the result.
-//
-///       However, it may lead to information loss if the original 'a' and 'b'
-///       values exceed the 32-bit range. For larger integers, consider using
-///       more advanced pairing functions or hash functions. The function
-///       assumes that 'a' and 'b' are non-negative 32-bit integers. It may not
-///       be suitable for negative integers or other data types without
-///       modification. For mathematical details, refer to Szudzik's Pairing
-///       Function definition.
-///
-/// \see
-/// https://en.wikipedia.org/wiki/Pairing_function#Szudzik's_pairing_function
-///
-template <typename SzudzikIn = std::uint32_t,
-          typename SzudzikOut = std::uint64_t>
-[[nodiscard]] constexpr static auto szudzik(const SzudzikIn a,
-                                            const SzudzikIn b) noexcept
-    -> SzudzikOut {
-  static_assert(std::numeric_limits<SzudzikIn>::max() *
-                        std::numeric_limits<SzudzikIn>::max() <=
-                    std::numeric_limits<SzudzikOut>::max(),
-                "SzudzikIn type may cause overflow");
-  static_assert(is_szudzik_type_v<SzudzikIn>,
-                "SzudzikIn type must be an unsigned "
-                "integer type but not a "
-                "character one.");
-  static_assert(is_szudzik_type_v<SzudzikOut>,
-                "SzudzikOut type must be an "
-                "unsigned integer type but not a "
-                "character one.");
-  const auto a64 = static_cast<SzudzikOut>(a);
-  const auto b64 = static_cast<SzudzikOut>(b);
-  return a64 >= b64 ? a64 * a64 + a64 + b64 : a64 + b64 * b64;
-}
+/// \brief A compact identifier of a route, which is resolved by
+///        `RoutingProvider::getRouteById` without searching for its vertices.
+///
+/// Every rank agrees on the identifiers, such that they can be carried by
+/// the messages sent between logical processes hosted by different ranks.
+using RouteId = std::uint64_t;
 
-}; // namespace
+class RoutingProvider;
 
 class Route {
-  /// \brief The path's length.
-  ///
-  /// This member variable holds the total number of elements in the path of the
-  /// route. The length represents the number of elements that make up the route
-  /// sequence. It is an essential attribute of the `Route` class, defining the
-  /// size of the route.
-  ///
-  /// \note The length is always non-negative, and it is set based on the number
-  ///       of elements stored in the path container.
-  ///
-  std::size_t m_Length;
-
   /// \brief The path.
   ///
-  /// This member variable represents the route's sequence of elements.
-  /// The route is implemented as a dynamic array of type `tw_lpid`.
-  /// The `path` array stores the individual elements that make up the route.
-  ///
-  /// \note The `m_Path` array is dynamically allocated and deallocated as
-  ///       needed. It holds `m_Length` elements in the route sequence.
+  /// This member variable points to the route's sequence of elements. The
+  /// route does not own its path, that is stored contiguously by the routing
+  /// table that created this route, either in memory or in a memory-mapped
+  /// compiled route file.
   ///
   /// \warning Accessing `m_Path` directly without considering `m_Length` may
   ///          result in undefined behavior and possible memory access
   ///          violations. In that case, is recommended the use of the `get`
   ///          function.
-  std::unique_ptr<tw_lpid *> m_Path;
+  const tw_lpid *m_Path;
+
+  /// \brief The parent of each node of the routing table's prefix trie, or
+  ///        `nullptr` if the route's path is stored contiguously.
+  ///
+  /// If set, `m_Path` holds the hop of each trie node instead, and the route
+  /// is the trie path that ends at `m_Node`.
+  const std::uint64_t *m_Parents = nullptr;
+
+  /// \brief The trie node of the route's last hop, if `m_Parents` is set, or
+  ///        the route's identifier, if `m_Provider` is set.
+  std::uint64_t m_Node = 0;
+
+  /// \brief The implicit provider that computes the route's hops, or
+  ///        `nullptr` if the route's path is stored.
+  const RoutingProvider *m_Provider = nullptr;
+
+  /// \brief The path's length.
+  ///
+  /// This member variable holds the total number of elements in the path of the
+  /// route. The length represents the number of elements that make up the route
+  /// sequence. It is an essential attribute of the `Route` class, defining the
+  /// size of the route.
+  std::size_t m_Length;
 
 public:
   /// \brief Constructor for the Route class.
   ///
-  /// Creates a new `Route` object with the given path and length.
+  /// Creates a new `Route` view over the given path and length.
   ///
-  /// \param path A `unique_ptr` to an array of `tw_lpid` values representing
-  ///             the path of the route.
+  /// \param path A pointer to the first element of the route's path.
   /// \param length The length of the route's path, indicating the number
   ///               of vertices in the route.
   ///
-  /// \note The constructor takes ownership of the `path` pointer, transferring
-  ///       it to the `m_Path` member using `std::move`. The caller should
-  ///       ensure that the memory pointed to by `path` is dynamically allocated
-  ///       and manage its deallocation properly. After construction, the
-  ///       `Route` object will be responsible for managing the memory and will
-  ///       automatically deallocate it when the object is destructed.
-  [[nodiscard]] Route(std::unique_ptr<tw_lpid *> path,
-                      const std::size_t length) noexcept
-      : m_Path(std::move(path)), m_Length(length) {}
+  /// \note The route does not take ownership of the `path` pointer. The
+  ///       caller must ensure that the path outlives the route, which is
+  ///       always the case for routes obtained from the routing table.
+  [[nodiscard]] constexpr Route(const tw_lpid *const path,
+                                const std::size_t length) noexcept
+      : m_Path(path), m_Length(length) {}
+
+  /// \brief Creates a new `Route` view over a path of a prefix trie.
+  ///
+  /// \param trieHops The hop of each trie node.
+  /// \param trieParents The parent of each trie node.
+  /// \param node The trie node of the route's last hop.
+  /// \param length The length of the route's path.
+  [[nodiscard]] constexpr Route(const tw_lpid *const trieHops,
+                                const std::uint64_t *const trieParents,
+                                const std::uint64_t node,
+                                const std::size_t length) noexcept
+      : m_Path(trieHops), m_Parents(trieParents), m_Node(node),
+        m_Length(length) {}
+
+  /// \brief Creates a new `Route` view over a route whose hops are computed
+  ///        on demand by an implicit provider.
+  ///
+  /// \param provider The provider that computes the route's hops.
+  /// \param id The route's identifier in the provider.
+  /// \param length The length of the route's path.
+  [[nodiscard]] constexpr Route(const RoutingProvider *const provider,
+                                const RouteId id,
+                                const std::size_t length) noexcept
+      : m_Path(nullptr), m_Node(id), m_Provider(provider), m_Length(length) {}
 
   /// \brief Access the element at the specified index in the route.
   ///
@@ -140,10 +108,6 @@ public:
   /// index in the route. The index represents the position of the desired
   /// element in the route, and it is zero-based.
   ///
-  /// The route represents a sequence of elements that can be accessed through
-  /// index-based addressing. The route is implemented as a collection of
-  /// elements stored in the `path` array.
-  ///
   /// In debug mode, if the provided index is out of the bounds of the route
   /// (greater than or equal to its length), the program will be immediately
   /// aborted. The `ispd_error` macro provides additional information about the
@@ -154,6 +118,11 @@ public:
   /// In release mode, the function works without any exception or overflow
   /// checks, providing optimal performance.
   ///
+  /// If the route is stored in a prefix trie, the element is found by walking
+  /// from the route's last hop towards the source, which takes time linear in
+  /// the distance from the index to the route's end. If the route is served
+  /// by an implicit provider, the element is computed by the provider.
+  ///
   /// \param index The index of the element to be accessed in the route.
   /// \return The route's element at the specified index.
   __attribute__((always_inline)) inline auto
@@ -167,136 +136,569 @@ public:
                    index, m_Length);
     });
 
-    return (*m_Path)[index];
+    if (m_Path && !m_Parents) [[likely]]
+      return m_Path[index];
+
+    if (m_Provider)
+      return getImplicit(index);
+
+    std::uint64_t node = m_Node;
+
+    for (std::size_t i = index + 1; i < m_Length; i++)
+      node = m_Parents[node];
+    return m_Path[node];
   }
 
   /// \brief Returns the route's length.
   [[nodiscard]] constexpr auto getLength() const noexcept -> std::size_t {
     return m_Length;
   }
+
+private:
+  /// \brief Returns the element at the specified index, as computed by the
+  ///        route's implicit provider.
+  [[nodiscard]] inline auto getImplicit(const std::size_t index) const noexcept
+      -> tw_lpid;
+};
+
+/// \class RouteList
+///
+/// \brief A read-only view over all the routes that connect a source and a
+///        destination vertex.
+///
+/// The routes are stored as a pooled hop array and an offsets array, in which
+/// the i-th route's path is stored in `[hops + offsets[i], hops +
+/// offsets[i + 1])`. If the routes are stored in a prefix trie, the offsets
+/// only give the routes' lengths, and the i-th route is the trie path ending
+/// at `nodes[i]`. If the routes are served by an implicit provider, the i-th
+/// route is the one identified by `firstId + i`. No route is copied when a
+/// list is created or indexed.
+class RouteList {
+  /// \brief The offsets of each route's path in the pooled hop array. It has
+  ///        `m_Count + 1` elements.
+  const std::uint64_t *m_Offsets;
+
+  /// \brief The pooled hop array, or the trie nodes' hops.
+  const tw_lpid *m_Hops;
+
+  /// \brief The trie nodes' parents, or `nullptr` if there is no trie.
+  const std::uint64_t *m_Parents = nullptr;
+
+  /// \brief The trie node of each route's last hop, if there is a trie.
+  const std::uint64_t *m_Nodes = nullptr;
+
+  /// \brief The implicit provider of the routes, or `nullptr` if the routes
+  ///        are stored.
+  const RoutingProvider *m_Provider = nullptr;
+
+  /// \brief The identifier of the first route, if `m_Provider` is set.
+  RouteId m_FirstId = 0;
+
+  /// \brief The number of routes in this list.
+  std::size_t m_Count;
+
+public:
+  [[nodiscard]] constexpr RouteList(const std::uint64_t *const offsets,
+                                    const tw_lpid *const hops,
+                                    const std::size_t count) noexcept
+      : m_Offsets(offsets), m_Hops(hops), m_Count(count) {}
+
+  [[nodiscard]] constexpr RouteList(const std::uint64_t *const offsets,
+                                    const tw_lpid *const trieHops,
+                                    const std::uint64_t *const trieParents,
+                                    const std::uint64_t *const nodes,
+                                    const std::size_t count) noexcept
+      : m_Offsets(offsets), m_Hops(trieHops), m_Parents(trieParents),
+        m_Nodes(nodes), m_Count(count) {}
+
+  [[nodiscard]] constexpr RouteList(const RoutingProvider *const provider,
+                                    const RouteId firstId,
+                                    const std::size_t count) noexcept
+      : m_Offsets(nullptr), m_Hops(nullptr), m_Provider(provider),
+        m_FirstId(firstId), m_Count(count) {}
+
+  /// \brief Returns the route at the specified index in this list.
+  [[nodiscard]] inline auto operator[](const std::size_t index) const noexcept
+      -> Route {
+    DEBUG({
+      if (index >= m_Count) [[unlikely]]
+        ispd_error("Accessing an invalid route index (Index: %zu, Route "
+                   "Count: %zu).",
+                   index, m_Count);
+    });
+
+    if (m_Provider)
+      return getImplicit(index);
+
+    const std::size_t length = m_Offsets[index + 1] - m_Offsets[index];
+
+    if (m_Parents)
+      return Route(m_Hops, m_Parents, m_Nodes[index], length);
+    return Route(m_Hops + m_Offsets[index], length);
+  }
+
+  /// \brief Returns the number of routes in this list.
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+    return m_Count;
+  }
+
+private:
+  /// \brief Returns the route at the specified index, as served by the
+  ///        list's implicit provider.
+  [[nodiscard]] inline auto getImplicit(const std::size_t index) const
+      -> Route;
+};
+
+/// \struct RouteRecord
+///
+/// \brief A route given to `RoutingTable::build`, whose path is stored in a
+///        pooled hop array as `[hops + m_HopBegin, hops + m_HopBegin +
+///        m_HopCount)`.
+struct RouteRecord final {
+  tw_lpid m_Src;            ///< The route's source vertex.
+  tw_lpid m_Dest;           ///< The route's destination vertex.
+  std::uint64_t m_HopBegin; ///< The path's first index in the hop array.
+  std::uint64_t m_HopCount; ///< The path's length.
+};
+
+/// \brief A predicate that tells if a vertex is relevant to this process.
+///
+/// When given to `RoutingTable::load`, only the routes whose source vertex or
+/// at least one of whose hops is relevant are kept. It is used to keep, in
+/// distributed runs, only the routes that may be looked up by the logical
+/// processes hosted by this processing element.
+using VertexPredicate = std::function<bool(const tw_lpid)>;
+
+/// \struct RouteEdge
+///
+/// \brief A link of the topology from which the routes are computed.
+///
+/// A route traverses a link from its `m_From` end to its `m_To` end, since
+/// the tasks are sent downward from the masters to the slaves.
+struct RouteEdge final {
+  tw_lpid m_Link;  ///< The link's global identifier.
+  tw_lpid m_From;  ///< The link's upward end.
+  tw_lpid m_To;    ///< The link's downward end.
+  double m_Weight; ///< The link's non-negative cost.
+};
+
+/// \struct RouteDemand
+///
+/// \brief A source vertex and the destination vertices to be routed from it.
+struct RouteDemand final {
+  tw_lpid m_Src;                ///< The source vertex.
+  std::vector<tw_lpid> m_Dests; ///< The destination vertices.
+};
+
+/// \class RoutingProvider
+///
+/// \brief The interface through which the routes are served to the services.
+///
+/// The routes are served either by a `RoutingTable`, which stores the routes
+/// read from a route file or computed from the model's links, or by an
+/// implicit provider, which computes the routes of a regular topology from
+/// the vertices' global identifiers (see `ispd::routing_provider`). An
+/// implicit provider needs no route file and stores no route at all.
+///
+/// Every provider must serve the same routes with the same identifiers in
+/// every rank, since the identifiers are carried by the messages.
+class RoutingProvider {
+public:
+  virtual ~RoutingProvider() = default;
+
+  /// \brief Returns true if there is at least one route from the source
+  ///        vertex to the destination vertex.
+  [[nodiscard]] virtual auto hasRoute(const tw_lpid src,
+                                      const tw_lpid dest) const -> bool = 0;
+
+  /// \brief Retrieves the routes between the specified source and
+  ///        destination vertices.
+  ///
+  /// \note If there is no route connecting the vertices, the program is
+  ///       immediately aborted.
+  [[nodiscard]] virtual auto getRoutes(const tw_lpid src,
+                                       const tw_lpid dest) const
+      -> RouteList = 0;
+
+  /// \brief Retrieves the identifier of the index-th route between the
+  ///        specified source and destination vertices.
+  ///
+  /// \note If there is no such route, the program is immediately aborted.
+  [[nodiscard]] virtual auto getRouteId(const tw_lpid src, const tw_lpid dest,
+                                        const std::size_t index = 0) const
+      -> RouteId = 0;
+
+  /// \brief Retrieves the route with the specified identifier.
+  ///
+  /// \note If there is no route with the identifier, the program is
+  ///       immediately aborted.
+  [[nodiscard]] virtual auto getRouteById(const RouteId id) const
+      -> Route = 0;
+
+  /// \brief Returns the element at the specified index of the route with the
+  ///        specified identifier.
+  ///
+  /// It is called by the routes served by an implicit provider, whose hops
+  /// are computed on demand instead of stored.
+  [[nodiscard]] virtual auto getHop(const RouteId id,
+                                    const std::size_t index) const noexcept
+      -> tw_lpid = 0;
+
+  /// \brief Returns the number of routes originating from the specified
+  ///        source vertex.
+  [[nodiscard]] virtual auto countRoutes(const tw_lpid src) const
+      -> const std::uint32_t = 0;
+
+  /// \brief Returns the number of distinct destinations of the routes
+  ///        originating from the specified source vertex.
+  [[nodiscard]] virtual auto countDestinations(const tw_lpid src) const
+      -> const std::uint32_t = 0;
+
+  /// \brief Retrieves the first route between the specified source and
+  ///        destination vertices.
+  ///
+  /// \note If there is no route connecting the vertices, the program is
+  ///       immediately aborted.
+  [[nodiscard]] auto getRoute(const tw_lpid src, const tw_lpid dest) const
+      -> Route {
+    return getRoutes(src, dest)[0];
+  }
 };
 
+inline auto Route::getImplicit(const std::size_t index) const noexcept
+    -> tw_lpid {
+  return m_Provider->getHop(m_Node, index);
+}
+
+inline auto RouteList::getImplicit(const std::size_t index) const -> Route {
+  return m_Provider->getRouteById(m_FirstId + index);
+}
+
 /// \class RoutingTable
 ///
 /// \brief A class representing a routing table to store and manage routes
 ///        between source and destination vertices.
 ///
-class RoutingTable {
-  /// \brief A hash table that stores routes between source and destination
-  /// vertices.
+/// The routes are stored in a flat compressed sparse row (CSR) layout, which
+/// is exactly the layout of the compiled route file (see `RouteFileHeader`):
+/// the sorted sources index their (source, destination) pairs, the pairs
+/// index their routes, and the routes index a single pooled hop array. Every
+/// key is a full 64-bit vertex identifier, such that models with more than
+/// 2^32 logical processes are supported.
+///
+/// The routing table can be populated from two kinds of files: the textual
+/// route file, whose routes are parsed into an in-memory image of the layout,
+/// and the compiled route file generated by the `ispd_routec` tool, which is
+/// memory-mapped and served without any parsing or copying. In both cases,
+/// the lookups are served by the same code through binary searches over
+/// contiguous arrays.
+///
+class RoutingTable final : public RoutingProvider {
+  /// \brief The in-memory image of the routes, or empty if the routes have
+  ///        been loaded from a compiled route file.
   ///
-  /// Each route is identified by a unique key, which is calculated based on the
-  /// pairing of the source and destination vertices using Szudzik's pairing
-  /// function. The key is a 64-bit unsigned integer obtained by applying
-  /// Szudzik's pairing function on the source and destination vertex IDs.
+  /// The image is laid out exactly as a compiled route file, with the header
+  /// followed by the sections, such that it can be written as is by `save`.
+  std::vector<std::uint64_t> m_Image;
+
+  /// \brief The compiled route file's mapping, or `nullptr` if the routes
+  ///        have been loaded from a textual route file.
+  const void *m_Mapping = nullptr;
+
+  /// \brief The compiled route file's mapping size in bytes.
+  std::size_t m_MappingSize = 0;
+
+  /// \brief The header and sections of the route layout. They point either
+  ///        into `m_Image` or into `m_Mapping`.
+  const RouteFileHeader *m_Header = nullptr;
+  const std::uint64_t *m_Sources = nullptr;
+  const std::uint64_t *m_SourcePairs = nullptr;
+  const std::uint64_t *m_PairDests = nullptr;
+  const std::uint64_t *m_PairRoutes = nullptr;
+  const std::uint64_t *m_RouteHops = nullptr;
+  const tw_lpid *m_Hops = nullptr;
+
+  /// \brief The identifier of each route in the layout, or empty if the
+  ///        identifier of a route is its index in the layout.
   ///
-  /// \note The value associated with each key is a constant pointer to the
-  ///       corresponding `Route` object, ensuring that the routes themselves
-  ///       cannot be modified through this map.
-  std::unordered_map<uint64_t, std::vector<const Route *>> m_Routes;
+  /// It is only set when not every route of the file is kept, since the
+  /// identifiers must then be agreed on by ranks whose layouts differ.
+  std::vector<RouteId> m_RouteIds;
+
+  /// \brief The (identifier, index) of each route in the layout, sorted by
+  ///        the identifier. It is empty if `m_RouteIds` is empty.
+  std::vector<std::pair<RouteId, std::uint64_t>> m_RouteIdIndex;
+
+  /// \brief If set, the routes built into this table are stored in a prefix
+  ///        trie instead of the pooled hop array.
+  bool m_SharePrefixes = false;
 
-  /// \brief A hash map that keeps track of the number of routes originating
-  ///        from each source vertex.
+  /// \brief The prefix trie, in which each node is a hop and its parent is
+  ///        the previous hop of every route passing by it. Routes sharing a
+  ///        prefix share its nodes. They are empty if there is no trie.
+  std::vector<tw_lpid> m_TrieHops;
+  std::vector<std::uint64_t> m_TrieParents;
+
+  /// \brief The trie node of each route's last hop, in the layout's order.
+  std::vector<std::uint64_t> m_RouteNodes;
+
+  /// \brief Moves the routes' paths from the pooled hop array to the prefix
+  ///        trie and releases the pooled hop array.
+  auto sharePrefixes() -> void;
+
+  /// \brief Returns the route at the specified index of the layout.
+  [[nodiscard]] inline auto makeRoute(const std::uint64_t route) const noexcept
+      -> Route {
+    const std::size_t length = m_RouteHops[route + 1] - m_RouteHops[route];
+
+    if (!m_TrieParents.empty())
+      return Route(m_TrieHops.data(), m_TrieParents.data(), m_RouteNodes[route],
+                   length);
+    return Route(m_Hops + m_RouteHops[route], length);
+  }
+
+  /// \brief Loads route information from the specified textual route file.
   ///
-  /// This map allows an early sanity checking about if the routes from a
-  /// speecific vertex match with the specified model built.
-  std::unordered_map<tw_lpid, uint32_t> m_RoutesCounting;
+  /// The file is memory-mapped, such that it is parsed in place.
+  auto loadText(const std::string &filepath, unsigned threadCount,
+                const VertexPredicate &isRelevant) -> void;
 
-  /// \brief Adds a route to the routing table between the given source and
-  ///        destination vertices.
+  /// \brief Parses the specified textual routes.
   ///
-  /// \param src The source vertex (`tw_lpid`) of the route.
-  /// \param dest The destination vertex (`tw_lpid`) of the route.
-  /// \param route A pointer to a `const Route` object representing the route
-  ///              from the source to the destination.
+  /// The text is split into newline-aligned chunks, which are parsed in
+  /// parallel by the specified number of threads.
+  auto parseText(const std::string &name, const char *const text,
+                 const std::size_t size, unsigned threadCount,
+                 const VertexPredicate &isRelevant) -> void;
+
+  /// \brief Memory-maps the specified compiled route file.
+  auto loadCompiled(const std::string &filepath) -> void;
+
+  /// \brief Checks if the compiled route file's header is compatible with
+  ///        this build and describes the specified size in bytes.
+  static auto checkCompiled(const std::string &name,
+                            const RouteFileHeader *const header,
+                            const std::size_t size) -> void;
+
+  /// \brief Points the sections to the layout that follows the header.
+  auto bindSections(const RouteFileHeader *const header) noexcept -> void;
+
+  /// \brief Searches the source vertex.
   ///
-  /// \note This function uses Szudzik's pairing function to generate a unique
-  ///       key for the route based on the source and destination vertices. The
-  ///       key is obtained by applying Szudzik's pairing function on the source
-  ///       and destination vertex IDs. The route is then stored in the
-  ///       `m_Routes` map, indexed by this unique key.
-  auto addRoute(const tw_lpid src, const tw_lpid dest, const Route *route)
-      -> void;
+  /// \returns The source's index in the `sources` section, or the source
+  ///          count if there is no route starting at the vertex.
+  [[nodiscard]] auto findSource(const tw_lpid src) const noexcept
+      -> std::uint64_t;
 
-  /// \brief Parses a route line from the input file and extracts the source and
-  ///        destination vertices.
+  /// \brief Searches the (src, dest) pair.
   ///
-  /// This function is used internally by the `load()` function to read and
-  /// parse individual route lines from the input file. It extracts the source
-  /// and destination vertices from the route line and returns a dynamically
-  /// allocated `Route` object.
-  ///
-  /// \param routeLine A string containing a single line of the input file
-  ///                  representing a route.
-  /// \param src A reference to a `tw_lpid` variable that
-  ///            will hold the parsed source vertex.
-  /// \param dest A reference to a `tw_lpid`
-  ///             variable that will hold the parsed destination vertex.
-  ///
-  /// \returns A pointer to a `Route` object representing the parsed route.
-  ///
-  /// \note This function expects the input route line to be in a specific
-  ///       format, containing source and destination vertex IDs separated by a
-  ///       delimiter. It extracts these IDs, converts them to `tw_lpid` format,
-  ///       and creates a new `Route` object to represent the route. The caller
-  ///       is responsible for managing the memory of the returned `Route`
-  ///       object.
-  [[nodiscard]] auto parseRouteLine(const std::string &routeLine,
-                                    const std::size_t lineNumber, tw_lpid &src,
-                                    tw_lpid &dest) -> Route *;
+  /// \returns The pair's index in the `pairDests` section, or the pair count
+  ///          if there is no route connecting the vertices.
+  [[nodiscard]] auto findPair(const tw_lpid src,
+                              const tw_lpid dest) const noexcept
+      -> std::uint64_t;
 
 public:
+  RoutingTable() = default;
+  RoutingTable(const RoutingTable &) = delete;
+  RoutingTable &operator=(const RoutingTable &) = delete;
+  ~RoutingTable() override;
+
   /// \brief Loads route information from the specified file and populates the
   ///        routing table.
   ///
-  /// This function reads route data from the input file, parses each route line
-  /// using `parseRouteLine()`, and adds the routes to the routing table using
-  /// `addRoute()`. It also updates the `m_RoutesCounting` map to keep track of
-  /// the number of routes originating from each source vertex.
+  /// If the file is a compiled route file (see `RouteFileHeader`), it is
+  /// memory-mapped and the routes are served directly from the mapping.
+  /// Otherwise, the textual route lines are parsed in parallel and the
+  /// in-memory image of the routes is built from them.
   ///
   /// \param filepath The path to the input file containing route information.
+  /// \param threadCount The number of threads that parse a textual route
+  ///                    file. If zero, the hardware concurrency is used.
+  /// \param isRelevant If set, only the routes whose source or hops are
+  ///                   relevant are kept.
+  ///
+  /// \note If a route line is malformed, an error containing its line number
+  ///       is reported and the program is immediately aborted.
+  ///
+  /// \note A compiled route file is always mapped as a whole, since its pages
+  ///       are shared by every rank in the same host and, thus, filtering it
+  ///       into a private copy would only increase the memory usage.
+  auto load(const std::string &filepath, const unsigned threadCount = 0,
+            const VertexPredicate &isRelevant = nullptr) -> void;
+
+  /// \brief Loads route information from the specified in-memory route file
+  ///        and populates the routing table.
+  ///
+  /// It is used when the route file has been read once and broadcast to the
+  /// ranks (see `ispd::input::read`). A compiled route file is served from
+  /// the buffer, which is taken over by the table, and a textual route file
+  /// is parsed as by `load`.
+  ///
+  /// \param name The name of the route file, which is used in the messages.
+  /// \param buffer The raw bytes of the route file.
+  /// \param threadCount The number of threads that parse a textual route
+  ///                    file. If zero, the hardware concurrency is used.
+  /// \param isRelevant If set, only the routes whose source or hops are
+  ///                   relevant are kept.
+  auto load(const std::string &name, ispd::input::FileBuffer &&buffer,
+            const unsigned threadCount = 0,
+            const VertexPredicate &isRelevant = nullptr) -> void;
+
+  /// \brief Stores the routes built afterwards into a prefix trie.
+  ///
+  /// Since the routes from a source often share long prefixes, as in star and
+  /// tree topologies, the routes' memory scales with the number of distinct
+  /// prefixes rather than with the sum of all paths' lengths. In exchange,
+  /// accessing a hop walks the route backwards from its last hop.
   ///
-  /// \note This function assumes that the input file contains route information
-  ///       in a specific format, with each route represented by a single line
-  ///       containing source and destination vertex IDs separated by a
-  ///       delimiter. The function reads each line, parses it using
-  ///       `parseRouteLine()`, and adds the routes to the `m_Routes` map. It
-  ///       also updates the `m_RoutesCounting` map to increment the count for
-  ///       the corresponding source vertex.
-  auto load(const std::string &filepath) -> void;
+  /// \note It must be called before the table is populated, and it has no
+  ///       effect on a memory-mapped compiled route file, whose pages are
+  ///       shared by every rank in the same host.
+  inline auto enablePrefixSharing() noexcept -> void { m_SharePrefixes = true; }
 
-  /// \brief Retrieves the route between the specified source and destination
+  /// \brief Computes the shortest routes of the specified demands and
+  ///        populates the routing table with them.
+  ///
+  /// The shortest routes of each source are computed with the Dijkstra's
+  /// algorithm over the directed graph formed by the edges, and the sources
+  /// are distributed among the specified number of threads. A route starts
+  /// at its source, ends at its destination, and passes only by transit
+  /// vertices in between.
+  ///
+  /// The demands' sources must be distinct. The routes are identified by
+  /// their ordinal in the demands' order, such that every rank computing the
+  /// same demands agrees on the identifiers.
+  ///
+  /// \param edges The links of the topology.
+  /// \param demands The sources and the destinations to be routed.
+  /// \param isTransit The predicate that tells if a vertex may forward a
+  ///                  route that does not end at it.
+  /// \param threadCount The number of threads that compute the routes. If
+  ///                    zero, the hardware concurrency is used.
+  /// \param isRelevant If set, only the routes whose source or hops are
+  ///                   relevant are kept.
+  ///
+  /// \note If a destination cannot be reached from its source, an error is
+  ///       reported and the program is immediately aborted.
+  auto compute(const std::vector<RouteEdge> &edges,
+               const std::vector<RouteDemand> &demands,
+               const VertexPredicate &isTransit, unsigned threadCount = 0,
+               const VertexPredicate &isRelevant = nullptr) -> void;
+
+  /// \brief Populates the routing table with the specified routes.
+  ///
+  /// The routes are laid out in the flat layout and their paths are copied
+  /// from the pooled hop array, which may be released after this call. The
+  /// routes may be given in any order, although routes that connect the
+  /// same vertices keep their relative order.
+  ///
+  /// \param routes The routes to be added.
+  /// \param hops The pooled hop array in which the routes' paths are stored.
+  /// \param routeIds The identifiers of the routes, in the same order of the
+  ///                 routes. If `nullptr`, the identifier of a route is its
+  ///                 index in the layout.
+  auto build(const std::vector<RouteRecord> &routes, const tw_lpid *const hops,
+             const RouteId *const routeIds = nullptr) -> void;
+
+  /// \brief Returns the number of routes in the routing table.
+  [[nodiscard]] auto getRouteCount() const noexcept -> std::uint64_t {
+    return m_Header ? m_Header->m_RouteCount : 0;
+  }
+
+  /// \brief Returns the memory held by the routing table, in bytes.
+  ///
+  /// It includes the memory-mapped compiled route file, if any, although its
+  /// pages are shared by every rank in the same host and are only resident
+  /// once they have been accessed.
+  [[nodiscard]] auto getMemoryUsage() const noexcept -> std::size_t {
+    return m_Image.size() * sizeof(std::uint64_t) + m_MappingSize +
+           m_RouteIds.size() * sizeof(RouteId) +
+           m_RouteIdIndex.size() * sizeof(m_RouteIdIndex[0]) +
+           m_TrieHops.size() * sizeof(tw_lpid) +
+           m_TrieParents.size() * sizeof(std::uint64_t) +
+           m_RouteNodes.size() * sizeof(std::uint64_t);
+  }
+
+  /// \brief Writes the routes of this routing table as a compiled route file.
+  ///
+  /// \param filepath The path of the compiled route file to be written.
+  auto save(const std::string &filepath) const -> void;
+
+  /// \brief Returns true if there is at least one route from the source
+  ///        vertex to the destination vertex in the routing table.
+  [[nodiscard]] auto hasRoute(const tw_lpid src, const tw_lpid dest) const
+      -> bool override;
+
+  /// \brief Retrieves the routes between the specified source and destination
   ///        vertices from the routing table.
   ///
   /// \param src The source vertex (`tw_lpid`) of the desired route.
   /// \param dest The destination vertex (`tw_lpid`) of the desired route.
   ///
-  /// \returns A pointer to a `const Route` object representing the route from
-  ///          the source to the destination, or `nullptr` if no route is found.
+  /// \returns A read-only view over the routes that connects the source and
+  ///          destination vertices.
   ///
-  /// \note This function uses Szudzik's pairing function to generate the key
-  ///       based on the source and destination vertices and looks up the route
-  ///       in the `m_Routes` map. It returns the corresponding `Route` object
-  ///       if found, or throws an exception otherwise.
-  [[nodiscard]] auto getRoute(const tw_lpid src, const tw_lpid dest) const
-      -> const Route *;
+  /// \note If there is no route connecting the vertices, the program is
+  ///       immediately aborted.
+  [[nodiscard]] auto getRoutes(const tw_lpid src, const tw_lpid dest) const
+      -> RouteList override;
 
-  /// \brief Retrieves the routes between the specified source and destination
-  ///        vertices from the routing table.
+  /// \brief Retrieves the identifier of the route between the specified
+  ///        source and destination vertices from the routing table.
   ///
   /// \param src The source vertex (`tw_lpid`) of the desired route.
   /// \param dest The destination vertex (`tw_lpid`) of the desired route.
+  /// \param index The index of the desired route among the routes returned
+  ///              by `getRoutes`.
   ///
-  /// \returns A constant (read-only) reference to the vector of routes that
-  ///          connects the source and destination vertices.
+  /// \returns The identifier of the route. By default, it is the first route
+  ///          from the source to the destination, which is the one returned
+  ///          by `getRoute`.
   ///
-  /// \note This function uses Szudzik's pairing function to generate the key
-  ///       based on the source and destination vertices and looks up the vector
-  ///       of routes in the `m_Routes` map. It returns the corresponding
-  ///       reference vector of routes if found, or throws an exception
-  ///       otherwise.
-  [[nodiscard]] auto getRoutes(const tw_lpid src, const tw_lpid dest) const
-      -> const std::vector<const Route *> &;
+  /// \note If there is no such route, the program is immediately aborted.
+  [[nodiscard]] auto getRouteId(const tw_lpid src, const tw_lpid dest,
+                                const std::size_t index = 0) const
+      -> RouteId override;
+
+  /// \brief Retrieves the route with the specified identifier.
+  ///
+  /// If every route of the file has been kept, it is a single indexed read.
+  /// Otherwise, the identifier is binary searched among the kept routes.
+  ///
+  /// \param id The route's identifier, as returned by `getRouteId`.
+  ///
+  /// \returns A view over the route.
+  ///
+  /// \note If there is no route with the identifier, the program is
+  ///       immediately aborted.
+  [[nodiscard]] inline auto getRouteById(const RouteId id) const
+      -> Route override {
+    std::uint64_t route = id;
+
+    if (!m_RouteIdIndex.empty()) {
+      const auto it = std::lower_bound(
+          m_RouteIdIndex.cbegin(), m_RouteIdIndex.cend(),
+          std::make_pair(id, std::uint64_t{0}));
+
+      route = it != m_RouteIdIndex.cend() && it->first == id
+                  ? it->second
+                  : m_Header->m_RouteCount;
+    }
+
+    if (route >= m_Header->m_RouteCount) [[unlikely]]
+      ispd_error("There is no route with identifier %lu.", id);
+
+    return makeRoute(route);
+  }
+
+  /// \brief Returns the element at the specified index of the route with the
+  ///        specified identifier.
+  [[nodiscard]] auto getHop(const RouteId id,
+                            const std::size_t index) const noexcept
+      -> tw_lpid override {
+    return getRouteById(id).get(index);
+  }
 
   /// \brief Returns the number of routes originating from the specified source
   ///        vertex.
@@ -306,13 +708,22 @@ public:
   ///
   /// \returns The count of routes originating from the specified source vertex.
   ///
-  /// \note This function retrieves the count of routes for the given source
-  ///       vertex from the `m_RoutesCounting` map. It returns the count as an
-  ///       unsigned 32-bit integer. This information is useful for sanity
-  ///       checking, ensuring that the routes from a specific vertex match the
-  ///       expected model built.
+  /// \note This information is useful for sanity checking, ensuring that the
+  ///       routes from a specific vertex match the expected model built.
   [[nodiscard]] auto countRoutes(const tw_lpid src) const
-      -> const std::uint32_t;
+      -> const std::uint32_t override;
+
+  /// \brief Returns the number of distinct destinations of the routes
+  ///        originating from the specified source vertex.
+  ///
+  /// It differs from `countRoutes` if there are alternative routes connecting
+  /// the source to some destination.
+  ///
+  /// \param src The source vertex (`tw_lpid`).
+  ///
+  /// \returns The count of destinations reached from the source vertex.
+  [[nodiscard]] auto countDestinations(const tw_lpid src) const
+      -> const std::uint32_t override;
 };
 
 }; // namespace ispd::routing
@@ -322,21 +733,66 @@ namespace ispd::routing_table {
 /// \brief Loads route information from the specified file and populates the
 ///        global routing table.
 ///
-/// This function reads route data from the input file, parses each route line
-/// using `parseRouteLine()`, and adds the routes to the routing table using
-/// `addRoute()`. It also updates the `m_RoutesCounting` map to keep track of
-/// the number of routes originating from each source vertex.
+/// The file may be either a textual route file or a compiled route file
+/// generated by the `ispd_routec` tool. In the latter case, the file is
+/// memory-mapped and no parsing is done at all.
 ///
 /// \param filepath The path to the input file containing route information.
+/// \param threadCount The number of threads that parse a textual route file.
+///                    If zero, the hardware concurrency is used.
+/// \param isRelevant If set, only the routes whose source or hops are
+///                   relevant are kept (see `ispd::routing::VertexPredicate`).
+auto load(const std::string &filepath, const unsigned threadCount = 0,
+          const ispd::routing::VertexPredicate &isRelevant = nullptr) -> void;
+
+/// \brief Loads route information from the specified in-memory route file
+///        and populates the global routing table.
 ///
-/// \note This function assumes that the input file contains route information
-///       in a specific format, with each route represented by a single line
-///       containing source and destination vertex IDs separated by a
-///       delimiter. The function reads each line, parses it using
-///       `parseRouteLine()`, and adds the routes to the `m_Routes` map. It
-///       also updates the `m_RoutesCounting` map to increment the count for
-///       the corresponding source vertex.
-auto load(const std::string &filepath) -> void;
+/// \see ispd::routing::RoutingTable::load
+auto load(const std::string &name, ispd::input::FileBuffer &&buffer,
+          const unsigned threadCount = 0,
+          const ispd::routing::VertexPredicate &isRelevant = nullptr) -> void;
+
+/// \brief Serves the routes through the specified provider instead of the
+///        global routing table.
+///
+/// It is used to select an implicit provider (see `ispd::routing_provider`),
+/// in which case no route file has to be loaded at all. The provider must
+/// outlive the simulation.
+auto setProvider(const ispd::routing::RoutingProvider *const provider)
+    -> void;
+
+/// \brief Returns true if the routes are served by an implicit provider
+///        instead of the global routing table.
+[[nodiscard]] auto hasImplicitProvider() -> bool;
+
+/// \brief Returns the provider that serves the routes.
+[[nodiscard]] auto getProvider() -> const ispd::routing::RoutingProvider &;
+
+/// \brief Stores the routes built afterwards into the global routing table in
+///        a prefix trie (see `RoutingTable::enablePrefixSharing`).
+auto enablePrefixSharing() -> void;
+
+/// \brief Returns the number of routes in the global routing table.
+[[nodiscard]] auto getRouteCount() -> std::uint64_t;
+
+/// \brief Computes the shortest routes of the specified demands and populates
+///        the global routing table with them.
+///
+/// \param edges The links of the topology.
+/// \param demands The sources and the destinations to be routed.
+/// \param isTransit The predicate that tells if a vertex may forward a route
+///                  that does not end at it.
+/// \param threadCount The number of threads that compute the routes. If zero,
+///                    the hardware concurrency is used.
+/// \param isRelevant If set, only the routes whose source or hops are
+///                   relevant are kept (see `ispd::routing::VertexPredicate`).
+auto compute(const std::vector<ispd::routing::RouteEdge> &edges,
+             const std::vector<ispd::routing::RouteDemand> &demands,
+             const ispd::routing::VertexPredicate &isTransit,
+             const unsigned threadCount = 0,
+             const ispd::routing::VertexPredicate &isRelevant = nullptr)
+    -> void;
 
 /// \brief Retrieves the route between the specified source and destination
 ///        vertices from the routing table.
@@ -344,15 +800,15 @@ auto load(const std::string &filepath) -> void;
 /// \param src The source vertex (`tw_lpid`) of the desired route.
 /// \param dest The destination vertex (`tw_lpid`) of the desired route.
 ///
-/// \returns A pointer to a `const Route` object representing the route from
-///          the source to the destination, or `nullptr` if no route is found.
+/// \returns A view over the first route from the source to the destination.
 ///
-/// \note This function uses Szudzik's pairing function to generate the key
-///       based on the source and destination vertices and looks up the route
-///       in the `m_Routes` map. It returns the corresponding `Route` object
-///       if found, or throws an exception otherwise.
-auto getRoute(const tw_lpid src, const tw_lpid dest)
-    -> const ispd::routing::Route *;
+/// \note If there is no route connecting the vertices, the program is
+///       immediately aborted.
+auto getRoute(const tw_lpid src, const tw_lpid dest) -> ispd::routing::Route;
+
+/// \brief Returns true if there is at least one route from the source vertex
+///        to the destination vertex.
+[[nodiscard]] auto hasRoute(const tw_lpid src, const tw_lpid dest) -> bool;
 
 /// \brief Retrieves the routes between the specified source and destination
 ///        vertices from the routing table.
@@ -360,16 +816,36 @@ auto getRoute(const tw_lpid src, const tw_lpid dest)
 /// \param src The source vertex (`tw_lpid`) of the desired route.
 /// \param dest The destination vertex (`tw_lpid`) of the desired route.
 ///
-/// \returns A constant (read-only) reference to the vector of routes that
-///          connects the source and destination vertices.
+/// \returns A read-only view over the routes that connects the source and
+///          destination vertices.
 ///
-/// \note This function uses Szudzik's pairing function to generate the key
-///       based on the source and destination vertices and looks up the vector
-///       of routes in the `m_Routes` map. It returns the corresponding
-///       reference vector of routes if found, or throws an exception
-///       otherwise.
+/// \note If there is no route connecting the vertices, the program is
+///       immediately aborted.
 [[nodiscard]] auto getRoutes(const tw_lpid src, const tw_lpid dest)
-    -> const std::vector<const ispd::routing::Route *> &;
+    -> ispd::routing::RouteList;
+
+/// \brief Retrieves the identifier of the route between the specified
+///        source and destination vertices from the global routing table.
+///
+/// \param src The source vertex (`tw_lpid`) of the desired route.
+/// \param dest The destination vertex (`tw_lpid`) of the desired route.
+/// \param index The index of the desired route among the routes returned by
+///              `getRoutes`.
+///
+/// \returns The identifier of the route. By default, it is the one of the
+///          route returned by `getRoute`.
+[[nodiscard]] auto getRouteId(const tw_lpid src, const tw_lpid dest,
+                              const std::size_t index = 0)
+    -> ispd::routing::RouteId;
+
+/// \brief Retrieves the route with the specified identifier from the global
+///        routing table.
+///
+/// \param id The route's identifier, as returned by `getRouteId`.
+///
+/// \returns A view over the route.
+[[nodiscard]] auto getRouteById(const ispd::routing::RouteId id)
+    -> ispd::routing::Route;
 
 /// \brief Returns the number of routes originating from the specified source
 ///        vertex.
@@ -379,13 +855,18 @@ auto getRoute(const tw_lpid src, const tw_lpid dest)
 ///
 /// \returns The count of routes originating from the specified source vertex.
 ///
-/// \note This function retrieves the count of routes for the given source
-///       vertex from the `m_RoutesCounting` map. It returns the count as an
-///       unsigned 32-bit integer. This information is useful for sanity
-///       checking, ensuring that the routes from a specific vertex match the
-///       expected model built.
+/// \note This information is useful for sanity checking, ensuring that the
+///       routes from a specific vertex match the expected model built.
 auto countRoutes(const tw_lpid src) -> const std::uint32_t;
 
+/// \brief Returns the number of distinct destinations of the routes
+///        originating from the specified source vertex.
+///
+/// \param src The source vertex (`tw_lpid`).
+///
+/// \returns The count of destinations reached from the source vertex.
+auto countDestinations(const tw_lpid src) -> const std::uint32_t;
+
 }; // namespace ispd::routing_table
 
 #endif // ISPD_ROUTING_HPP
@@ -0,0 +1,183 @@
+/// \file fat_tree.hpp
+///
+/// \brief This file defines the FatTree class, an implicit routing provider
+/// for k-ary fat-tree topologies.
+///
+#pragma once
+
+#include <algorithm>
+#include <ispd/routing_provider/implicit.hpp>
+
+namespace ispd::routing_provider {
+
+/// \class FatTree
+///
+/// \brief Routes a three-level k-ary fat-tree, whose hosts are the masters
+///        and the machines.
+///
+/// The fat-tree has `k` pods, each of which has `k/2` edge switches and `k/2`
+/// aggregation switches, and `(k/2)^2` core switches. Each edge switch has
+/// `k/2` hosts, and there are `H = k^3/4` hosts. The a-th aggregation switch
+/// of every pod is connected to the a-th group of `k/2` core switches. With
+/// `h = k/2`, `P = k * h` and `M` masters, the services are numbered as
+/// follows:
+///
+///   - Hosts: `[0, H)`, pod by pod and edge switch by edge switch. The first
+///     `M` hosts are the masters and the remaining ones are the machines.
+///   - Edge switches: `H + p * h + e`.
+///   - Aggregation switches: `H + P + p * h + a`.
+///   - Core switches: `H + 2P + a * h + c`.
+///   - Host up links: `E + i`, from the i-th host to its edge switch, where
+///     `E = H + 2P + h^2` is the first link.
+///   - Host down links: `E + H + i`, from its edge switch to the i-th host.
+///   - Edge up links: `E + 2H + (p * h + e) * h + a`.
+///   - Aggregation down links: `E + 3H + (p * h + a) * h + e`.
+///   - Aggregation up links: `E + 4H + (p * h + a) * h + c`.
+///   - Core down links: `E + 5H + (a * h + c) * k + p`.
+///
+/// Since a route goes up to the lowest common switch level and then down,
+/// each cable is modelled as an up link and a down link, which are traversed
+/// from their `from` end to their `to` end by the tasks.
+///
+/// There is a single route between hosts of the same edge switch, `k/2`
+/// routes (one per aggregation switch) between hosts of the same pod, and
+/// `(k/2)^2` routes (one per core switch) between hosts of different pods,
+/// which are the alternative routes given to the route selectors.
+///
+class FatTree final : public ImplicitProvider<FatTree> {
+  tw_lpid m_MasterCount;
+  tw_lpid m_HostCount;
+  tw_lpid m_K;
+  tw_lpid m_Half;
+
+  /// \brief The first link.
+  tw_lpid m_Links;
+
+  [[nodiscard]] static auto countVertices(const tw_lpid k) -> tw_lpid {
+    if (k < 2 || k % 2 != 0)
+      ispd_error("The fat-tree must have an even k of at least 2 (k: %lu).",
+                 k);
+
+    const tw_lpid half = k / 2;
+    const tw_lpid hostCount = k * half * half;
+
+    return hostCount + 2 * k * half + half * half + 6 * hostCount;
+  }
+
+  [[nodiscard]] inline auto getPod(const tw_lpid host) const noexcept
+      -> tw_lpid {
+    return host / (m_Half * m_Half);
+  }
+
+  [[nodiscard]] inline auto getEdge(const tw_lpid host) const noexcept
+      -> tw_lpid {
+    return host / m_Half;
+  }
+
+  /// \brief Returns the number of machines among the hosts in `[first,
+  ///        last)`.
+  [[nodiscard]] inline auto countMachines(const tw_lpid first,
+                                          const tw_lpid last) const noexcept
+      -> tw_lpid {
+    const tw_lpid begin = std::max(first, m_MasterCount);
+    const tw_lpid end = std::min(last, m_HostCount);
+
+    return end > begin ? end - begin : 0;
+  }
+
+public:
+  FatTree(const tw_lpid masterCount, const tw_lpid k)
+      : ImplicitProvider(countVertices(k), (k / 2) * (k / 2)),
+        m_MasterCount(masterCount), m_HostCount(k * k * k / 4), m_K(k),
+        m_Half(k / 2) {
+    if (masterCount > m_HostCount)
+      ispd_error("The fat-tree with k %lu has only %lu hosts, but %lu masters "
+                 "have been requested.",
+                 k, m_HostCount, masterCount);
+
+    m_Links = m_HostCount + 2 * m_K * m_Half + m_Half * m_Half;
+  }
+
+  [[nodiscard]] inline auto countAlternatives(const tw_lpid src,
+                                              const tw_lpid dest) const noexcept
+      -> std::uint64_t {
+    if (src >= m_MasterCount || dest < m_MasterCount || dest >= m_HostCount)
+      return 0;
+
+    if (getEdge(src) == getEdge(dest))
+      return 1;
+    if (getPod(src) == getPod(dest))
+      return m_Half;
+    return m_Half * m_Half;
+  }
+
+  [[nodiscard]] inline auto getPathLength(const tw_lpid src, const tw_lpid dest,
+                                          const std::uint64_t alternative) const
+      noexcept -> std::size_t {
+    if (getEdge(src) == getEdge(dest))
+      return 2;
+    if (getPod(src) == getPod(dest))
+      return 4;
+    return 6;
+  }
+
+  [[nodiscard]] inline auto getPathHop(const tw_lpid src, const tw_lpid dest,
+                                       const std::uint64_t alternative,
+                                       const std::size_t index) const noexcept
+      -> tw_lpid {
+    const tw_lpid length = getPathLength(src, dest, alternative);
+
+    /// The first link goes up from the source host and the last link goes
+    /// down to the destination host.
+    if (index == 0)
+      return m_Links + src;
+    if (index == length - 1)
+      return m_Links + m_HostCount + dest;
+
+    const tw_lpid srcPod = getPod(src);
+    const tw_lpid destPod = getPod(dest);
+    const tw_lpid srcEdge = getEdge(src) % m_Half;
+    const tw_lpid destEdge = getEdge(dest) % m_Half;
+
+    /// Within a pod, the alternative is the aggregation switch. Otherwise, it
+    /// is the core switch, whose group is the aggregation switch.
+    const tw_lpid agg = length == 4 ? alternative : alternative / m_Half;
+    const tw_lpid core = alternative % m_Half;
+
+    if (index == 1)
+      return m_Links + 2 * m_HostCount + (srcPod * m_Half + srcEdge) * m_Half +
+             agg;
+    if (index == length - 2)
+      return m_Links + 3 * m_HostCount + (destPod * m_Half + agg) * m_Half +
+             destEdge;
+    if (index == 2)
+      return m_Links + 4 * m_HostCount + (srcPod * m_Half + agg) * m_Half +
+             core;
+    return m_Links + 5 * m_HostCount + (agg * m_Half + core) * m_K + destPod;
+  }
+
+  [[nodiscard]] auto countRoutes(const tw_lpid src) const
+      -> const std::uint32_t override {
+    if (src >= m_MasterCount)
+      ispd_error("There is no routing with source at LP with GID %lu.", src);
+
+    const tw_lpid edgeFirst = getEdge(src) * m_Half;
+    const tw_lpid podFirst = getPod(src) * m_Half * m_Half;
+    const tw_lpid sameEdge = countMachines(edgeFirst, edgeFirst + m_Half);
+    const tw_lpid samePod =
+        countMachines(podFirst, podFirst + m_Half * m_Half) - sameEdge;
+    const tw_lpid others = countDestinations(src) - sameEdge - samePod;
+
+    return sameEdge + samePod * m_Half + others * m_Half * m_Half;
+  }
+
+  [[nodiscard]] auto countDestinations(const tw_lpid src) const
+      -> const std::uint32_t override {
+    if (src >= m_MasterCount)
+      ispd_error("There is no routing with source at LP with GID %lu.", src);
+
+    return m_HostCount - m_MasterCount;
+  }
+};
+
+} // namespace ispd::routing_provider
@@ -0,0 +1,136 @@
+/// \file implicit.hpp
+///
+/// \brief This file defines the ImplicitProvider class, the common base of the
+/// routing providers that compute the routes of a regular topology.
+///
+/// An implicit provider assumes that the topology's services have been
+/// numbered following a convention that is documented by each provider, such
+/// that the hops of a route are computed from the global identifiers of its
+/// source and destination with a few arithmetic operations. No route file is
+/// needed and no route is stored at all.
+///
+#pragma once
+
+#include <limits>
+#include <ispd/log/log.hpp>
+#include <ispd/routing/routing.hpp>
+
+namespace ispd::routing_provider {
+
+/// \class ImplicitProvider
+///
+/// \brief Serves the routes of a regular topology through the routing
+///        provider interface.
+///
+/// The identifier of the `alternative`-th route from `src` to `dest` is
+/// `(src * vertexCount + dest) * maxAlternatives + alternative`, such that the
+/// route is found again from its identifier without any search.
+///
+/// The topology is given as the template parameter, which must provide:
+///
+///   - `countAlternatives(src, dest)`: The number of routes from the source
+///     to the destination, or zero if there is no route.
+///   - `getPathLength(src, dest, alternative)`: The length of a route.
+///   - `getPathHop(src, dest, alternative, index)`: The hop of a route.
+///
+/// Since the topology is statically dispatched, resolving a hop costs a single
+/// virtual call, as does indexing a stored route.
+///
+template <typename Topology>
+class ImplicitProvider : public ispd::routing::RoutingProvider {
+  /// \brief The number of services in the topology.
+  tw_lpid m_VertexCount;
+
+  /// \brief The maximum number of routes connecting two vertices.
+  std::uint64_t m_MaxAlternatives;
+
+  [[nodiscard]] inline auto self() const noexcept -> const Topology & {
+    return static_cast<const Topology &>(*this);
+  }
+
+  [[nodiscard]] inline auto encode(const tw_lpid src, const tw_lpid dest,
+                                   const std::uint64_t alternative) const
+      noexcept -> ispd::routing::RouteId {
+    return (src * m_VertexCount + dest) * m_MaxAlternatives + alternative;
+  }
+
+  inline auto decode(ispd::routing::RouteId id, tw_lpid &src, tw_lpid &dest,
+                     std::uint64_t &alternative) const noexcept -> void {
+    alternative = id % m_MaxAlternatives;
+    id /= m_MaxAlternatives;
+    dest = id % m_VertexCount;
+    src = id / m_VertexCount;
+  }
+
+protected:
+  ImplicitProvider(const tw_lpid vertexCount,
+                   const std::uint64_t maxAlternatives)
+      : m_VertexCount(vertexCount), m_MaxAlternatives(maxAlternatives) {
+    /// Checks if the identifiers of the routes do not fit in 64 bits. If so,
+    /// the program is immediately aborted.
+    if (vertexCount == 0 || maxAlternatives == 0 ||
+        std::numeric_limits<std::uint64_t>::max() / vertexCount / vertexCount <
+            maxAlternatives)
+      ispd_error("The topology is too large to be routed implicitly (Services: "
+                 "%lu, Alternative Routes: %lu).",
+                 vertexCount, maxAlternatives);
+  }
+
+public:
+  /// \brief Returns the number of services in the topology, which must match
+  ///        the number of services in the model.
+  [[nodiscard]] auto getVertexCount() const noexcept -> tw_lpid {
+    return m_VertexCount;
+  }
+
+  [[nodiscard]] auto hasRoute(const tw_lpid src, const tw_lpid dest) const
+      -> bool override {
+    return self().countAlternatives(src, dest) > 0;
+  }
+
+  [[nodiscard]] auto getRoutes(const tw_lpid src, const tw_lpid dest) const
+      -> ispd::routing::RouteList override {
+    const std::uint64_t count = self().countAlternatives(src, dest);
+
+    if (count == 0) [[unlikely]]
+      ispd_error("There is no route from %lu to %lu.", src, dest);
+
+    return ispd::routing::RouteList(this, encode(src, dest, 0), count);
+  }
+
+  [[nodiscard]] auto getRouteId(const tw_lpid src, const tw_lpid dest,
+                                const std::size_t index = 0) const
+      -> ispd::routing::RouteId override {
+    if (index >= self().countAlternatives(src, dest)) [[unlikely]]
+      ispd_error("There is no route %lu from %lu to %lu.", index, src, dest);
+
+    return encode(src, dest, index);
+  }
+
+  [[nodiscard]] auto getRouteById(const ispd::routing::RouteId id) const
+      -> ispd::routing::Route override {
+    tw_lpid src, dest;
+    std::uint64_t alternative;
+
+    decode(id, src, dest, alternative);
+
+    if (src >= m_VertexCount ||
+        alternative >= self().countAlternatives(src, dest)) [[unlikely]]
+      ispd_error("There is no route with identifier %lu.", id);
+
+    return ispd::routing::Route(
+        this, id, self().getPathLength(src, dest, alternative));
+  }
+
+  [[nodiscard]] auto getHop(const ispd::routing::RouteId id,
+                            const std::size_t index) const noexcept
+      -> tw_lpid final {
+    tw_lpid src, dest;
+    std::uint64_t alternative;
+
+    decode(id, src, dest, alternative);
+    return self().getPathHop(src, dest, alternative, index);
+  }
+};
+
+} // namespace ispd::routing_provider
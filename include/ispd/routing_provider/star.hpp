@@ -0,0 +1,73 @@
+/// \file star.hpp
+///
+/// \brief This file defines the Star class, an implicit routing provider for
+/// star topologies.
+///
+#pragma once
+
+#include <ispd/routing_provider/implicit.hpp>
+
+namespace ispd::routing_provider {
+
+/// \class Star
+///
+/// \brief Routes a star topology, in which every master and every machine is
+///        attached to a single central switch.
+///
+/// With `M` masters and `K` machines, the services are numbered as follows:
+///
+///   - Masters: `[0, M)`.
+///   - Machines: `[M, M + K)`.
+///   - The switch: `M + K`.
+///   - Master links: `M + K + 1 + m`, from the m-th master to the switch.
+///   - Machine links: `2M + K + 1 + k`, from the switch to the k-th machine.
+///
+/// Every master reaches every machine through its link and the machine's
+/// link.
+///
+class Star final : public ImplicitProvider<Star> {
+  tw_lpid m_MasterCount;
+  tw_lpid m_MachineCount;
+
+public:
+  Star(const tw_lpid masterCount, const tw_lpid machineCount)
+      : ImplicitProvider(2 * (masterCount + machineCount) + 1, 1),
+        m_MasterCount(masterCount), m_MachineCount(machineCount) {}
+
+  [[nodiscard]] inline auto countAlternatives(const tw_lpid src,
+                                              const tw_lpid dest) const noexcept
+      -> std::uint64_t {
+    return src < m_MasterCount && dest >= m_MasterCount &&
+           dest < m_MasterCount + m_MachineCount;
+  }
+
+  [[nodiscard]] inline auto getPathLength(const tw_lpid src, const tw_lpid dest,
+                                          const std::uint64_t alternative) const
+      noexcept -> std::size_t {
+    return 2;
+  }
+
+  [[nodiscard]] inline auto getPathHop(const tw_lpid src, const tw_lpid dest,
+                                       const std::uint64_t alternative,
+                                       const std::size_t index) const noexcept
+      -> tw_lpid {
+    const tw_lpid masterLinks = m_MasterCount + m_MachineCount + 1;
+
+    return index == 0 ? masterLinks + src : masterLinks + dest;
+  }
+
+  [[nodiscard]] auto countRoutes(const tw_lpid src) const
+      -> const std::uint32_t override {
+    return countDestinations(src);
+  }
+
+  [[nodiscard]] auto countDestinations(const tw_lpid src) const
+      -> const std::uint32_t override {
+    if (src >= m_MasterCount)
+      ispd_error("There is no routing with source at LP with GID %lu.", src);
+
+    return m_MachineCount;
+  }
+};
+
+} // namespace ispd::routing_provider
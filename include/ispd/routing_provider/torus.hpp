@@ -0,0 +1,167 @@
+/// \file torus.hpp
+///
+/// \brief This file defines the Torus class, an implicit routing provider for
+/// multidimensional torus topologies.
+///
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <ispd/routing_provider/implicit.hpp>
+
+namespace ispd::routing_provider {
+
+/// \class Torus
+///
+/// \brief Routes a multidimensional torus of switches with dimension-order
+///        routing, in which each switch has a single attached host.
+///
+/// The torus has `D` dimensions of sizes `n_0, ..., n_{D-1}` and `N = n_0 *
+/// ... * n_{D-1}` switches. The i-th switch has the coordinates `c_d = (i /
+/// (n_0 * ... * n_{d-1})) % n_d`, that is, the first dimension varies the
+/// fastest. With `M` masters, the services are numbered as follows:
+///
+///   - Hosts: `[0, N)`, in the switches' order. The first `M` hosts are the
+///     masters and the remaining ones are the machines.
+///   - Switches: `N + i`.
+///   - Host up links: `2N + i`, from the i-th host to its switch.
+///   - Host down links: `3N + i`, from its switch to the i-th host.
+///   - Ring links: `4N + (i * D + d) * 2 + s`, from the i-th switch to its
+///     neighbour in the d-th dimension, which is the next one if `s` is zero
+///     and the previous one otherwise.
+///
+/// A route corrects the dimensions in order, each in the shortest direction
+/// around its ring (the next neighbours' direction, on ties).
+///
+class Torus final : public ImplicitProvider<Torus> {
+  tw_lpid m_MasterCount;
+  tw_lpid m_SwitchCount;
+
+  /// \brief The size and the stride of each dimension.
+  std::vector<tw_lpid> m_Sizes;
+  std::vector<tw_lpid> m_Strides;
+
+  [[nodiscard]] static auto countSwitches(const std::vector<tw_lpid> &sizes)
+      -> tw_lpid {
+    if (sizes.empty())
+      ispd_error("The torus must have at least one dimension.");
+
+    tw_lpid count = 1;
+
+    for (const tw_lpid size : sizes) {
+      /// Checks if the dimension is empty or the torus is too large. If so,
+      /// the program is immediately aborted.
+      if (size == 0 || count > (tw_lpid{1} << 40) / size)
+        ispd_error("The torus has an empty dimension or is too large.");
+      count *= size;
+    }
+    return count;
+  }
+
+  /// \brief Returns the coordinate of the switch in the dimension.
+  [[nodiscard]] inline auto getCoordinate(const tw_lpid node,
+                                          const std::size_t dimension) const
+      noexcept -> tw_lpid {
+    return (node / m_Strides[dimension]) % m_Sizes[dimension];
+  }
+
+  /// \brief Returns the number of ring links traversed in the dimension, and
+  ///        sets if they are traversed towards the previous neighbours.
+  [[nodiscard]] inline auto countSteps(const tw_lpid src, const tw_lpid dest,
+                                       const std::size_t dimension,
+                                       bool &backwards) const noexcept
+      -> tw_lpid {
+    const tw_lpid size = m_Sizes[dimension];
+    const tw_lpid forward =
+        (getCoordinate(dest, dimension) + size - getCoordinate(src, dimension)) %
+        size;
+
+    backwards = forward > size - forward;
+    return backwards ? size - forward : forward;
+  }
+
+public:
+  Torus(const tw_lpid masterCount, std::vector<tw_lpid> sizes)
+      : ImplicitProvider(countSwitches(sizes) * (4 + 2 * sizes.size()), 1),
+        m_MasterCount(masterCount), m_SwitchCount(countSwitches(sizes)),
+        m_Sizes(std::move(sizes)) {
+    if (masterCount > m_SwitchCount)
+      ispd_error("The torus has only %lu hosts, but %lu masters have been "
+                 "requested.",
+                 m_SwitchCount, masterCount);
+
+    tw_lpid stride = 1;
+
+    for (const tw_lpid size : m_Sizes) {
+      m_Strides.push_back(stride);
+      stride *= size;
+    }
+  }
+
+  [[nodiscard]] inline auto countAlternatives(const tw_lpid src,
+                                              const tw_lpid dest) const noexcept
+      -> std::uint64_t {
+    return src < m_MasterCount && dest >= m_MasterCount &&
+           dest < m_SwitchCount;
+  }
+
+  [[nodiscard]] inline auto getPathLength(const tw_lpid src, const tw_lpid dest,
+                                          const std::uint64_t alternative) const
+      noexcept -> std::size_t {
+    std::size_t length = 2;
+    bool backwards;
+
+    for (std::size_t d = 0; d < m_Sizes.size(); d++)
+      length += countSteps(src, dest, d, backwards);
+    return length;
+  }
+
+  [[nodiscard]] inline auto getPathHop(const tw_lpid src, const tw_lpid dest,
+                                       const std::uint64_t alternative,
+                                       const std::size_t index) const noexcept
+      -> tw_lpid {
+    if (index == 0)
+      return 2 * m_SwitchCount + src;
+
+    /// Walk the dimensions until the one in which the index-th link is
+    /// traversed. The dimensions before it have already been corrected.
+    tw_lpid node = src;
+    tw_lpid step = index - 1;
+
+    for (std::size_t d = 0; d < m_Sizes.size(); d++) {
+      bool backwards;
+      const tw_lpid steps = countSteps(src, dest, d, backwards);
+      const tw_lpid coordinate = getCoordinate(src, d);
+
+      if (step < steps) {
+        const tw_lpid size = m_Sizes[d];
+        const tw_lpid current = backwards
+                                    ? (coordinate + size - step % size) % size
+                                    : (coordinate + step) % size;
+
+        node += (current - coordinate) * m_Strides[d];
+        return 4 * m_SwitchCount + (node * m_Sizes.size() + d) * 2 + backwards;
+      }
+
+      node += (getCoordinate(dest, d) - coordinate) * m_Strides[d];
+      step -= steps;
+    }
+
+    return 3 * m_SwitchCount + dest;
+  }
+
+  [[nodiscard]] auto countRoutes(const tw_lpid src) const
+      -> const std::uint32_t override {
+    return countDestinations(src);
+  }
+
+  [[nodiscard]] auto countDestinations(const tw_lpid src) const
+      -> const std::uint32_t override {
+    if (src >= m_MasterCount)
+      ispd_error("There is no routing with source at LP with GID %lu.", src);
+
+    return m_SwitchCount - m_MasterCount;
+  }
+};
+
+} // namespace ispd::routing_provider
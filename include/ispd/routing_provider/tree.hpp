@@ -0,0 +1,139 @@
+/// \file tree.hpp
+///
+/// \brief This file defines the Tree class, an implicit routing provider for
+/// complete tree topologies.
+///
+#pragma once
+
+#include <vector>
+#include <ispd/routing_provider/implicit.hpp>
+
+namespace ispd::routing_provider {
+
+/// \class Tree
+///
+/// \brief Routes a complete tree of switches, in which the masters are
+///        attached to the root switch and the machines are the leaves.
+///
+/// The tree has `D` levels of switches, and each switch has `A` children,
+/// such that the l-th level has `A^l` switches and there are `L = A^D`
+/// machines. The switches are numbered in breadth-first order, such that the
+/// l-th level starts at `(A^l - 1) / (A - 1)`, and there are `W = (A^D - 1) /
+/// (A - 1)` switches. With `M` masters, the services are numbered as follows:
+///
+///   - Masters: `[0, M)`.
+///   - Machines: `[M, M + L)`, in the leaves' order.
+///   - Switches: `M + L + s`, in breadth-first order.
+///   - Master links: `M + L + W + m`, from the m-th master to the root.
+///   - Switch links: `2M + L + W + s - 1`, from the parent of the s-th switch
+///     to it, for every switch but the root.
+///   - Machine links: `2M + L + 2W - 1 + k`, from the parent of the k-th
+///     machine to it.
+///
+/// Every master reaches every machine by going down the tree.
+///
+class Tree final : public ImplicitProvider<Tree> {
+  tw_lpid m_MasterCount;
+  tw_lpid m_MachineCount;
+  unsigned m_Depth;
+
+  /// \brief The first switch of each level.
+  std::vector<tw_lpid> m_LevelBegin;
+
+  /// \brief The number of machines under a switch of each level.
+  std::vector<tw_lpid> m_Span;
+
+  tw_lpid m_MasterLinks;
+  tw_lpid m_SwitchLinks;
+  tw_lpid m_MachineLinks;
+
+  [[nodiscard]] static auto power(const tw_lpid base, const unsigned exponent)
+      -> tw_lpid {
+    tw_lpid result = 1;
+
+    for (unsigned i = 0; i < exponent; i++) {
+      /// Checks if the tree is too large. If so, the program is immediately
+      /// aborted.
+      if (result > (tw_lpid{1} << 40) / base)
+        ispd_error("The tree with arity %lu and depth %u is too large.", base,
+                   exponent);
+      result *= base;
+    }
+    return result;
+  }
+
+  [[nodiscard]] static auto countSwitches(const tw_lpid arity,
+                                          const unsigned depth) -> tw_lpid {
+    if (arity < 2 || depth == 0)
+      ispd_error("The tree must have an arity of at least 2 and a depth of at "
+                 "least 1 (Arity: %lu, Depth: %u).",
+                 arity, depth);
+
+    return (power(arity, depth) - 1) / (arity - 1);
+  }
+
+public:
+  Tree(const tw_lpid masterCount, const tw_lpid arity, const unsigned depth)
+      : ImplicitProvider(2 * masterCount + 2 * power(arity, depth) +
+                             2 * countSwitches(arity, depth) - 1,
+                         1),
+        m_MasterCount(masterCount), m_MachineCount(power(arity, depth)),
+        m_Depth(depth) {
+    const tw_lpid switchCount = countSwitches(arity, depth);
+    tw_lpid levelBegin = 0;
+
+    for (unsigned l = 0; l < depth; l++) {
+      m_LevelBegin.push_back(levelBegin);
+      m_Span.push_back(power(arity, depth - l));
+      levelBegin += power(arity, l);
+    }
+
+    m_MasterLinks = masterCount + m_MachineCount + switchCount;
+    m_SwitchLinks = m_MasterLinks + masterCount - 1;
+    m_MachineLinks = m_SwitchLinks + switchCount;
+  }
+
+  [[nodiscard]] inline auto countAlternatives(const tw_lpid src,
+                                              const tw_lpid dest) const noexcept
+      -> std::uint64_t {
+    return src < m_MasterCount && dest >= m_MasterCount &&
+           dest < m_MasterCount + m_MachineCount;
+  }
+
+  [[nodiscard]] inline auto getPathLength(const tw_lpid src, const tw_lpid dest,
+                                          const std::uint64_t alternative) const
+      noexcept -> std::size_t {
+    return m_Depth + 1;
+  }
+
+  [[nodiscard]] inline auto getPathHop(const tw_lpid src, const tw_lpid dest,
+                                       const std::uint64_t alternative,
+                                       const std::size_t index) const noexcept
+      -> tw_lpid {
+    const tw_lpid leaf = dest - m_MasterCount;
+
+    if (index == 0)
+      return m_MasterLinks + src;
+    if (index == m_Depth)
+      return m_MachineLinks + leaf;
+
+    /// The index-th link goes down to the switch of the index-th level above
+    /// the destination machine.
+    return m_SwitchLinks + m_LevelBegin[index] + leaf / m_Span[index];
+  }
+
+  [[nodiscard]] auto countRoutes(const tw_lpid src) const
+      -> const std::uint32_t override {
+    return countDestinations(src);
+  }
+
+  [[nodiscard]] auto countDestinations(const tw_lpid src) const
+      -> const std::uint32_t override {
+    if (src >= m_MasterCount)
+      ispd_error("There is no routing with source at LP with GID %lu.", src);
+
+    return m_MachineCount;
+  }
+};
+
+} // namespace ispd::routing_provider
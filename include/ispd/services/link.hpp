@@ -20,8 +20,9 @@ struct link_state {
   tw_lpid from;
   tw_lpid to;
 
-  /// \brief Link's Configuration.
-  ispd::configuration::LinkConfiguration conf;
+  /// \brief Link's Configuration, which is interned and shared by the links
+  ///        with the same hardware.
+  const ispd::configuration::LinkConfiguration *conf;
 
   /// \brief Link's Metrics.
   ispd::metrics::LinkMetrics metrics;
@@ -34,11 +35,14 @@ struct link_state {
 struct link {
 
   static void init(link_state *s, tw_lp *lp) {
-    /// Fetch the service initializer from this logical process.
-    const auto &service_initializer = ispd::this_model::getServiceInitializer(lp->gid);
-
-    /// Call the service initializer for this logical process.
-    service_initializer(s);
+    /// Fetch the link's ends and configuration from its row of the links
+    /// table.
+    const auto &links = ispd::this_model::getLinks();
+    const auto row = ispd::this_model::getServiceRow(lp->gid);
+
+    s->from = links.m_From[row];
+    s->to = links.m_To[row];
+    s->conf = &links.getConfiguration(row);
     
     /// Initialize link's metrics.
     s->metrics.upward_comm_time = 0;
@@ -67,7 +71,7 @@ struct link {
 
     /// Fetch the communication size and calculates the communication time.
     const double comm_size = msg->task.m_CommSize;
-    const double comm_time = s->conf.timeToCommunicate(comm_size);
+    const double comm_time = s->conf->timeToCommunicate(comm_size);
 
     /// Here is selected which available time should be used, i.e., if the
     /// messages is being sent from the master to the slave, then the downward
@@ -132,7 +136,10 @@ struct link {
     m->type = message_type::ARRIVAL;
     m->task = msg->task; /// Copy the task's information.
     m->downward_direction = msg->downward_direction;
+    m->route_id = msg->route_id;
     m->route_offset = msg->route_offset;
+    m->route_index = msg->route_index;
+    m->route_waiting_time = msg->route_waiting_time + waiting_delay;
     m->previous_service_id = lp->gid;
 
     /// Save information (for reverse computation).
@@ -159,7 +166,7 @@ struct link {
 
     /// Fetch the communication size and calculates the communication time.
     const double comm_size = msg->task.m_CommSize;
-    const double comm_time = s->conf.timeToCommunicate(comm_size);
+    const double comm_time = s->conf->timeToCommunicate(comm_size);
     const double next_available_time = msg->saved_link_next_available_time;
     const double waiting_delay = msg->saved_waiting_time;
 
@@ -220,7 +227,7 @@ struct link {
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_COMMUNICATION_TIME, linkTotalCommunicationTime);
 
     /// Report to the node's metrics reports file this links's metrics.
-    ispd::node_metrics::notifyReport(s->metrics, s->conf, lp->gid);
+    ispd::node_metrics::notifyReport(s->metrics, *s->conf, lp->gid);
 
     std::printf(
         "Link Queue Info & Metrics (%lu)\n"
@@ -10,6 +10,7 @@
 
 #include <ispd/message/message.hpp>
 #include <ispd/routing/routing.hpp>
+#include <ispd/routing/forwarding.hpp>
 #include <ispd/model/builder.hpp>
 #include <ispd/metrics/metrics.hpp>
 #include <ispd/metrics/user_metrics.hpp>
@@ -22,9 +23,10 @@ namespace ispd {
 namespace services {
 
 struct machine_state {
-  ispd::configuration::MachineConfiguration conf; ///< Machine's configuration.
+  const ispd::configuration::MachineConfiguration *conf; ///< Machine's interned configuration.
   ispd::metrics::MachineMetrics m_Metrics; ///< Machine's metrics.
   std::vector<double> cores_free_time; ///< Machine's queueing model information
+  ispd::routing::NextHopTable m_NextHops; ///< Machine's next-hop table (if enabled).
 };
 
 struct machine {
@@ -48,11 +50,15 @@ struct machine {
   }
 
   static void init(machine_state *s, tw_lp *lp) {
-    /// Fetch the service initializer from this logical process.
-    const auto &service_initializer = ispd::this_model::getServiceInitializer(lp->gid);
+    /// Fetch the machine's configuration from its row of the machines table.
+    const auto &machines = ispd::this_model::getMachines();
+    const auto row = ispd::this_model::getServiceRow(lp->gid);
 
-    /// Call the service initializer for this logical process.
-    service_initializer(s);
+    s->conf = &machines.getConfiguration(row);
+    s->cores_free_time.resize(s->conf->getCoreCount(), 0.0);
+
+    /// Fetch the machine's next-hop table, which is used if it forwards tasks.
+    s->m_NextHops = ispd::forwarding_table::getTable(lp->gid);
 
     /// Print a debug message.
     ispd_debug("Machine %lu has been initialized.", lp->gid);
@@ -70,7 +76,7 @@ struct machine {
     if (msg->task.m_Dest == lp->gid) {
       /// Fetch the processing size and calculates the processing time.
       const double proc_size = msg->task.m_ProcSize;
-      const double proc_time = s->conf.timeToProcess(proc_size, msg->task.m_CommSize, msg->task.m_Offload);
+      const double proc_time = s->conf->timeToProcess(proc_size, msg->task.m_CommSize, msg->task.m_Offload);
 
       unsigned core_index;
       const double least_free_time = least_core_time(s->cores_free_time, core_index);
@@ -82,7 +88,7 @@ struct machine {
       s->m_Metrics.m_ProcTime += proc_time;
       s->m_Metrics.m_ProcTasks++;
       s->m_Metrics.m_ProcWaitingTime += waiting_delay;
-      s->m_Metrics.m_EnergyConsumption += proc_time * s->conf.getWattagePerCore();
+      s->m_Metrics.m_EnergyConsumption += proc_time * s->conf->getWattagePerCore();
 
       /// Update the machine's queueing model information.
       s->cores_free_time[core_index] = tw_now(lp) + departure_delay;
@@ -96,6 +102,9 @@ struct machine {
       m->task.m_CommSize = 0.000976562; /// 1 Kib (representing the results).
       m->task_processed = 1;           /// Indicate that the message is carrying a processed task.
       m->downward_direction = 0;       /// The task's results will be sent back to the master.
+      m->route_id = msg->route_id;     /// The results are sent back through the same route.
+      m->route_index = msg->route_index;
+      m->route_waiting_time = msg->route_waiting_time;
       m->route_offset = msg->route_offset - 2;
       m->previous_service_id = lp->gid;
       
@@ -108,21 +117,27 @@ struct machine {
     /// Otherwise, this indicates that the task's destination IS NOT this machine and, therefore,
     /// the task should only be forwarded to its next destination. 
     else {
-      /// Fetch the route between the task's origin and task's destination.
-      const ispd::routing::Route *route = ispd::routing_table::getRoute(msg->task.m_Origin, msg->task.m_Dest);
+      /// Fetch the next link either from the machine's next-hop table or from the
+      /// route between the task's origin and task's destination.
+      const tw_lpid next = ispd::forwarding_table::isEnabled()
+          ? s->m_NextHops.find(msg->route_id).get(msg->downward_direction)
+          : ispd::routing_table::getRouteById(msg->route_id).get(msg->route_offset);
 
       /// Update machine's metrics.
       s->m_Metrics.m_ForwardedTasks++;
 
       /// @Todo: This zero-delay timestamped message could affect the conservative synchronization.
       ///        This should be changed after.
-      tw_event *const e = tw_event_new(route->get(msg->route_offset), g_tw_lookahead, lp);
+      tw_event *const e = tw_event_new(next, g_tw_lookahead, lp);
       ispd_message *const m = static_cast<ispd_message *>(tw_event_data(e));
 
       m->type = message_type::ARRIVAL;
       m->task = msg->task; /// Copy the tasks's information.
       m->task_processed = msg->task_processed;
       m->downward_direction = msg->downward_direction;
+      m->route_id = msg->route_id;
+      m->route_index = msg->route_index;
+      m->route_waiting_time = msg->route_waiting_time;
       m->route_offset = msg->downward_direction ? (msg->route_offset + 1) : (msg->route_offset - 1);
       m->previous_service_id = lp->gid;
 
@@ -147,7 +162,7 @@ struct machine {
     /// Check if the task's destination is this machine.
     if (msg->task.m_Dest == lp->gid) {
       const double proc_size = msg->task.m_ProcSize;
-      const double proc_time = s->conf.timeToProcess(proc_size, msg->task.m_CommSize, msg->task.m_Offload);
+      const double proc_time = s->conf->timeToProcess(proc_size, msg->task.m_CommSize, msg->task.m_Offload);
 
       const double least_free_time = msg->saved_core_next_available_time;
       const double waiting_delay = ROSS_MAX(0.0, least_free_time - tw_now(lp));
@@ -157,7 +172,7 @@ struct machine {
       s->m_Metrics.m_ProcTime -= proc_time;
       s->m_Metrics.m_ProcTasks--;
       s->m_Metrics.m_ProcWaitingTime -= waiting_delay;
-      s->m_Metrics.m_EnergyConsumption -= proc_time * s->conf.getWattagePerCore();
+      s->m_Metrics.m_EnergyConsumption -= proc_time * s->conf->getWattagePerCore();
 
       /// Reverse the machine's queueing model information.
       s->cores_free_time[msg->saved_core_index] = least_free_time;
@@ -179,13 +194,13 @@ struct machine {
     if (msg->task.m_Dest == lp->gid) {
       /// Fetch the processing size and calculates the processing time.
       const double proc_size = msg->task.m_ProcSize;
-      const double proc_time = s->conf.timeToProcess(proc_size, msg->task.m_CommSize, msg->task.m_Offload);
+      const double proc_time = s->conf->timeToProcess(proc_size, msg->task.m_CommSize, msg->task.m_Offload);
 
       const double least_free_time = msg->saved_core_next_available_time;
       const double waiting_delay = ROSS_MAX(0.0, least_free_time - tw_now(lp));
 
       /// Calculates the energy consumption by processing this task.
-      const double energyConsumption = proc_time * (s->conf.getWattageIdle() + s->conf.getWattagePerCore());
+      const double energyConsumption = proc_time * (s->conf->getWattageIdle() + s->conf->getWattagePerCore());
 
       /// Update the user's metrics.
       ispd::metrics::UserMetrics& userMetrics = ispd::this_model::getUserById(msg->task.m_Owner).getMetrics();
@@ -210,15 +225,15 @@ struct machine {
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_PROCESSED_MFLOPS, s->m_Metrics.m_ProcMflops);
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_PROCESSING_WAITING_TIME, s->m_Metrics.m_ProcWaitingTime);
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_MACHINE_SERVICES);
-    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_COMPUTATIONAL_POWER, s->conf.getPower() + s->conf.getGpuPower());
-    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_CPU_CORES, s->conf.getCoreCount());
-    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_GPU_CORES, s->conf.getGpuCoreCount());
+    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_COMPUTATIONAL_POWER, s->conf->getPower() + s->conf->getGpuPower());
+    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_CPU_CORES, s->conf->getCoreCount());
+    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_GPU_CORES, s->conf->getGpuCoreCount());
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_PROCESSING_TIME, s->m_Metrics.m_ProcTime);
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_NON_IDLE_ENERGY_CONSUMPTION, s->m_Metrics.m_EnergyConsumption);
-    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_POWER_IDLE, s->conf.getWattageIdle());
+    ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_POWER_IDLE, s->conf->getWattageIdle());
 
     /// Report to the node's metrics reports file this machine's metrics.
-    ispd::node_metrics::notifyReport(s->m_Metrics, s->conf, lp->gid);
+    ispd::node_metrics::notifyReport(s->m_Metrics, *s->conf, lp->gid);
 
     std::printf(
         "Machine Metrics (%lu)\n"
@@ -12,6 +12,7 @@
 #include <ispd/workload/workload.hpp>
 #include <ispd/scheduler/scheduler.hpp>
 #include <ispd/scheduler/round_robin.hpp>
+#include <ispd/route_selector/route_selector.hpp>
 #include <ispd/metrics/master_metrics.hpp>
 
 namespace ispd {
@@ -24,6 +25,10 @@ struct master_state {
   /// \brief Master's scheduler.
   ispd::scheduler::Scheduler *scheduler;
 
+  /// \brief Master's route selector, which selects among the alternative
+  ///        routes to the scheduled slave.
+  ispd::route_selector::RouteSelector *route_selector;
+
   /// \brief Master's workload generator.
   ispd::workload::Workload *workload;
 
@@ -34,21 +39,25 @@ struct master_state {
 struct master {
 
   static void init(master_state *s, tw_lp *lp) {
-    /// Fetch the service initializer from this logical process.
-    const auto &service_initializer = ispd::this_model::getServiceInitializer(lp->gid);
-
-    /// Call the service initializer for this logical process.
-    service_initializer(s);
+    /// Fetch the master's slaves, scheduler, route selector and workload from
+    /// its row of the masters table.
+    const auto &masters = ispd::this_model::getMasters();
+    const auto row = ispd::this_model::getServiceRow(lp->gid);
+
+    s->slaves = masters.getSlaves(row);
+    s->scheduler = masters.m_Scheduler[row];
+    s->route_selector = masters.m_RouteSelector[row];
+    s->workload = masters.m_Workload[row];
    
-    /// Initialize the scheduler.
+    /// Initialize the scheduler and the route selector.
     s->scheduler->initScheduler();
-
-    const uint32_t registered_routes_count = ispd::routing_table::countRoutes(lp->gid);
+    s->route_selector->initSelector();
 
     /// Early sanity check if the routes has been registered correctly. If not,
     /// the program is immediately aborted.
-    if (registered_routes_count != s->slaves.size())
-      ispd_error("There are %u registered routes starting from master with GID %lu but there are %lu slaves.", registered_routes_count, lp->gid, s->slaves.size());
+    for (const tw_lpid slave : s->slaves)
+      if (!ispd::routing_table::hasRoute(lp->gid, slave))
+        ispd_error("There is no route from master with GID %lu to its slave with GID %lu.", lp->gid, slave);
 
     /// Initialize the metrics.
     s->metrics.completed_tasks = 0;
@@ -152,12 +161,22 @@ private:
     /// Use the master's scheduling policy to the schedule the next slave.
     const tw_lpid scheduled_slave_id = s->scheduler->forwardSchedule(s->slaves, bf, msg, lp);
 
-    /// Fetch the route that connects this master with the scheduled slave.
-    const ispd::routing::Route *route = ispd::routing_table::getRoute(lp->gid, scheduled_slave_id);
+    /// Use the master's route selection policy to select one of the routes that
+    /// connects this master with the scheduled slave.
+    const ispd::routing::RouteList routes = ispd::routing_table::getRoutes(lp->gid, scheduled_slave_id);
+    const uint32_t route_index = s->route_selector->forwardSelect(scheduled_slave_id, routes.size(), bf, msg, lp);
+
+    /// Save the scheduled slave (for reverse computation).
+    msg->saved_route_dest = scheduled_slave_id;
+
+    /// Fetch the selected route. Its identifier is carried by the message, such
+    /// that the services along the route do not search for it again.
+    const ispd::routing::RouteId route_id = ispd::routing_table::getRouteId(lp->gid, scheduled_slave_id, route_index);
+    const ispd::routing::Route route = routes[route_index];
 
     /// @Todo: This zero-delay timestamped message, could affect the conservative synchronization.
     ///        This should be changed later.
-    tw_event *const e = tw_event_new(route->get(0), g_tw_lookahead, lp);
+    tw_event *const e = tw_event_new(route.get(0), g_tw_lookahead, lp);
     ispd_message *const m = static_cast<ispd_message *>(tw_event_data(e));
 
     m->type = message_type::ARRIVAL;
@@ -174,7 +193,10 @@ private:
     m->task.m_SubmitTime = tw_now(lp);
     m->task.m_Owner = s->workload->getOwner();
 
+    m->route_id = route_id;
     m->route_offset = 1;
+    m->route_index = route_index;
+    m->route_waiting_time = 0.0;
     m->previous_service_id = lp->gid;
     m->downward_direction = 1;
     m->task_processed = 0;
@@ -211,7 +233,8 @@ private:
   const auto start = std::chrono::high_resolution_clock::now();
 #endif // DEBUG_ON
 
-    /// Reverse the schedule.
+    /// Reverse the route selection and the schedule.
+    s->route_selector->reverseSelect(msg->saved_route_dest, bf, msg, lp);
     s->scheduler->reverseSchedule(s->slaves, bf, msg, lp);
 
     /// Reverse the workload generator.
@@ -242,6 +265,9 @@ private:
     /// Update the master's metrics.
     s->metrics.completed_tasks++;
     s->metrics.total_turnaround_time += turnaround_time;
+
+    /// Feed the waiting time along the followed route back to the selector.
+    s->route_selector->forwardFeedback(msg, lp);
   }
 
   static void arrival_rc(master_state *s, tw_bf *bf, ispd_message *msg, tw_lp *lp) {
@@ -251,6 +277,9 @@ private:
     /// Reverse the master's metrics.
     s->metrics.completed_tasks--;
     s->metrics.total_turnaround_time -= turnaround_time;
+
+    /// Reverse the route selector's feedback.
+    s->route_selector->reverseFeedback(msg, lp);
   }
 
 };
@@ -7,6 +7,7 @@
 #include <ispd/model/builder.hpp>
 #include <ispd/message/message.hpp>
 #include <ispd/routing/routing.hpp>
+#include <ispd/routing/forwarding.hpp>
 #include <ispd/metrics/metrics.hpp>
 #include <ispd/configuration/switch.hpp>
 #include <ispd/metrics/switch_metrics.hpp>
@@ -14,18 +15,25 @@
 namespace ispd::services {
 
 struct SwitchState {
-  ispd::configuration::SwitchConfiguration m_Conf;
+  /// \brief The switch's interned configuration, which is shared by the
+  ///        switches with the same hardware.
+  const ispd::configuration::SwitchConfiguration *m_Conf;
   ispd::metrics::SwitchMetrics m_Metrics;
+
+  /// \brief The switch's next-hop table, if the next-hop tables are enabled.
+  ispd::routing::NextHopTable m_NextHops;
 };
 
 struct Switch {
   static void init(SwitchState *s, tw_lp *lp) {
-    /// Fetch the service initializer from this logical process.
-    const auto &serviceInitializer =
-        ispd::this_model::getServiceInitializer(lp->gid);
+    /// Fetch the switch's configuration from its row of the switches table.
+    const auto &switches = ispd::this_model::getSwitches();
+    const auto row = ispd::this_model::getServiceRow(lp->gid);
+
+    s->m_Conf = &switches.getConfiguration(row);
 
-    /// Call the service initializer for this logical process.
-    serviceInitializer(s);
+    /// Fetch the switch's next-hop table.
+    s->m_NextHops = ispd::forwarding_table::getTable(lp->gid);
 
     /// Initialize the switch's metrics.
     s->m_Metrics.m_UpwardCommMbits = 0;
@@ -34,8 +42,8 @@ struct Switch {
     s->m_Metrics.m_DownwardCommPackets = 0;
 
     ispd_debug("Switch %lu has been initialized (B: %lf, L: %lf, LT: %lf).",
-               lp->gid, s->m_Conf.getBandwidth(), s->m_Conf.getLoad(),
-               s->m_Conf.getLatency());
+               lp->gid, s->m_Conf->getBandwidth(), s->m_Conf->getLoad(),
+               s->m_Conf->getLatency());
   }
 
   static void forward(SwitchState *s, tw_bf *bf, ispd_message *msg, tw_lp *lp) {
@@ -49,7 +57,7 @@ struct Switch {
 
     /// Fetch the communication size and calculate the communication time.
     const double commSize = msg->task.m_CommSize;
-    const double commTime = s->m_Conf.timeToCommunicate(commSize);
+    const double commTime = s->m_Conf->timeToCommunicate(commSize);
 
     /// Update the switch's metrics.
     if (msg->downward_direction) {
@@ -60,17 +68,24 @@ struct Switch {
       s->m_Metrics.m_UpwardCommPackets++;
     }
 
-    const ispd::routing::Route *route =
-        ispd::routing_table::getRoute(msg->task.m_Origin, msg->task.m_Dest);
+    /// Fetch the next link either from the switch's next-hop table or from
+    /// the route's full path.
+    const tw_lpid next =
+        ispd::forwarding_table::isEnabled()
+            ? s->m_NextHops.find(msg->route_id).get(msg->downward_direction)
+            : ispd::routing_table::getRouteById(msg->route_id)
+                  .get(msg->route_offset);
 
-    tw_event *const e =
-        tw_event_new(route->get(msg->route_offset), g_tw_lookahead + commTime, lp);
+    tw_event *const e = tw_event_new(next, g_tw_lookahead + commTime, lp);
     ispd_message *const m = static_cast<ispd_message *>(tw_event_data(e));
 
     m->type = message_type::ARRIVAL;
     m->task = msg->task; /// Copies the task information.
     m->task_processed = msg->task_processed;
     m->downward_direction = msg->downward_direction;
+    m->route_id = msg->route_id;
+    m->route_index = msg->route_index;
+    m->route_waiting_time = msg->route_waiting_time;
     m->route_offset = msg->downward_direction ? (msg->route_offset + 1)
                                               : (msg->route_offset - 1);
     m->previous_service_id = lp->gid;
@@ -95,7 +110,7 @@ struct Switch {
 #endif // DEBUG_ON
 
     const double commSize = msg->task.m_CommSize;
-    const double commTime = s->m_Conf.timeToCommunicate(commSize);
+    const double commTime = s->m_Conf->timeToCommunicate(commSize);
 
     /// Reverse the switch's metrics.
     if (msg->downward_direction) {
@@ -117,7 +132,7 @@ struct Switch {
 
   static void finish(SwitchState *s, tw_lp *lp) {
     ispd::node_metrics::notifyMetric(ispd::metrics::NodeMetricsFlag::NODE_TOTAL_MASTER_SERVICES);
-    ispd::node_metrics::notifyReport(s->m_Metrics, s->m_Conf, lp->gid);
+    ispd::node_metrics::notifyReport(s->m_Metrics, *s->m_Conf, lp->gid);
 
     std::printf("Switch Queue Info & Metrics (%lu)\n"
                 " - Downward Communicated Mbits..: %lf Mbits (%lu).\n"
@@ -42,6 +42,12 @@ public:
   ///            generator.
   virtual void reverseGenerateInterarrival(tw_rng_stream *const rng) = 0;
 
+  /// \brief Returns the mean interarrival time of the distribution.
+  ///
+  /// It is used to estimate how many tasks a workload generates before the
+  /// simulation ends, without generating them.
+  [[nodiscard]] virtual double getMean() const noexcept = 0;
+
   /// \brief Virtual destructor for the InterarrivalDistribution class.
   ///
   /// This virtual destructor ensures proper cleanup when objects of derived
@@ -85,6 +91,11 @@ public:
   ///            generator.
   void reverseGenerateInterarrival(
       [[maybe_unused]] tw_rng_stream *const rng) override;
+
+  /// \brief Returns the fixed interarrival interval, which is its mean.
+  [[nodiscard]] inline double getMean() const noexcept override {
+    return m_Interval;
+  }
 };
 
 /// \class ExponentialInterarrivalDistribution
@@ -123,6 +134,12 @@ public:
   /// \param rng A pointer to the logical process reversible-pseudorando number
   ///            generator.
   void reverseGenerateInterarrival(tw_rng_stream *const rng) override;
+
+  /// \brief Returns the mean interarrival time, which is the lambda
+  ///        parameter, since it is the mean given to `tw_rand_exponential`.
+  [[nodiscard]] inline double getMean() const noexcept override {
+    return m_Lambda;
+  }
 };
 
 /// \class PoissonInterarrivalDistribution
@@ -159,6 +176,12 @@ public:
   /// \param rng A pointer to the logical process reversible-pseudorandom number
   ///            generator.
   void reverseGenerateInterarrival(tw_rng_stream *const rng) override;
+
+  /// \brief Returns the mean interarrival time, which is the lambda
+  ///        parameter.
+  [[nodiscard]] inline double getMean() const noexcept override {
+    return m_Lambda;
+  }
 };
 
 /// \class WeibullInterarrivalDistribution
@@ -206,6 +229,11 @@ public:
   /// \param rng A pointer to the logical rocess reversible-pseudorandom number
   ///            generator.
   void reverseGenerateInterarrival(tw_rng_stream *const rng) override;
+
+  /// \brief Returns the mean interarrival time, which is the mean parameter.
+  [[nodiscard]] inline double getMean() const noexcept override {
+    return m_Mean;
+  }
 };
 
 } // namespace ispd::workload
@@ -179,6 +179,13 @@ public:
     return m_RemainingTasks;
   }
 
+  /// \brief Get the mean time between the arrivals of consecutive tasks.
+  ///
+  /// \returns The mean of the workload's interarrival distribution.
+  [[nodiscard]] inline double getInterarrivalMean() const noexcept {
+    return m_InterarrivalDist->getMean();
+  }
+
   /// \brief Get the computing offload ratio of the workload.
   ///
   /// Retrieves the computing offload ratio for GPU processing associated with
@@ -0,0 +1,106 @@
+#include <mpi.h>
+#include <ross.h>
+#include <limits>
+#include <fstream>
+#include <algorithm>
+#include <ispd/log/log.hpp>
+#include <ispd/input/input.hpp>
+
+namespace ispd::input {
+
+namespace {
+
+/// \brief The largest number of bytes sent by a single broadcast, since the
+///        MPI counts are `int`.
+constexpr std::size_t g_MaxBroadcastBytes = std::size_t{1} << 30;
+
+/// \brief Reads the whole file from the filesystem.
+auto readFile(const std::string &filepath) -> FileBuffer {
+  std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+
+  /// Check if the file could not be opened. If so, an error indicating the
+  /// case is sent and the program is immediately aborted.
+  if (!file.is_open()) [[unlikely]]
+    ispd_error("Input file %s could not be opened.", filepath.c_str());
+
+  FileBuffer buffer(static_cast<std::size_t>(file.tellg()));
+
+  file.seekg(0);
+  file.read(buffer.data(), buffer.size());
+
+  if (!file) [[unlikely]]
+    ispd_error("Input file %s could not be read.", filepath.c_str());
+
+  return buffer;
+}
+
+/// \brief Returns the communicator of the ranks that share a file read by
+///        their leader, which is its rank 0.
+auto getCommunicator(const ReadMode mode) -> MPI_Comm {
+  if (mode == ReadMode::LEADER)
+    return MPI_COMM_ROSS;
+
+  /// The ranks in the same host are split once and the communicator is kept
+  /// for the following files.
+  static MPI_Comm hostComm = MPI_COMM_NULL;
+
+  if (hostComm == MPI_COMM_NULL &&
+      MPI_SUCCESS != MPI_Comm_split_type(MPI_COMM_ROSS, MPI_COMM_TYPE_SHARED,
+                                         g_tw_mynode, MPI_INFO_NULL,
+                                         &hostComm))
+    ispd_error("The ranks could not be split by host, exiting...");
+
+  return hostComm;
+}
+
+}; // namespace
+
+auto read(const std::string &filepath, const ReadMode mode) -> FileBuffer {
+  if (mode == ReadMode::INDEPENDENT || tw_nnodes() == 1)
+    return readFile(filepath);
+
+  if (mode != ReadMode::LEADER && mode != ReadMode::HOST_LEADER)
+    ispd_error("Unknown input read mode (%u).", static_cast<unsigned>(mode));
+
+  const MPI_Comm comm = getCommunicator(mode);
+  int rank, rankCount;
+
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &rankCount);
+
+  FileBuffer buffer;
+  std::uint64_t size = 0;
+
+  if (rank == 0) {
+    buffer = readFile(filepath);
+    size = buffer.size();
+  }
+
+  /// Broadcast the file's size, such that the other ranks allocate their
+  /// buffers, and then its bytes.
+  if (MPI_SUCCESS != MPI_Bcast(&size, 1, MPI_UINT64_T, 0, comm))
+    ispd_error("Input file %s size could not be broadcast, exiting...",
+               filepath.c_str());
+
+  if (rank != 0)
+    buffer = FileBuffer(size);
+
+  for (std::size_t offset = 0; offset < size; offset += g_MaxBroadcastBytes) {
+    const std::size_t count = std::min(g_MaxBroadcastBytes, size - offset);
+
+    if (MPI_SUCCESS != MPI_Bcast(buffer.data() + offset,
+                                 static_cast<int>(count), MPI_BYTE, 0, comm))
+      ispd_error("Input file %s could not be broadcast, exiting...",
+                 filepath.c_str());
+  }
+
+  if (rank == 0)
+    ispd_info("Input file %s has been read at node %lu and broadcast to %d "
+              "rank(s) (Bytes: %lu).",
+              filepath.c_str(), static_cast<unsigned long>(g_tw_mynode),
+              rankCount, size);
+
+  return buffer;
+}
+
+}; // namespace ispd::input
@@ -1,8 +1,10 @@
 #include <iostream>
 #include <memory>
+#include <algorithm>
 #include <ross.h>
 #include <ross-extern.h>
 #include <ispd/log/log.hpp>
+#include <ispd/input/input.hpp>
 #include <ispd/model/builder.hpp>
 #include <ispd/services/link.hpp>
 #include <ispd/services/dummy.hpp>
@@ -11,15 +13,87 @@
 #include <ispd/services/machine.hpp>
 #include <ispd/message/message.hpp>
 #include <ispd/routing/routing.hpp>
+#include <ispd/routing/forwarding.hpp>
 #include <ispd/metrics/metrics.hpp>
+#include <ispd/profiler/profiler.hpp>
 #include <ispd/workload/workload.hpp>
 #include <ispd/workload/interarrival.hpp>
 #include <ispd/model_loader/model_loader.hpp>
+#include <ispd/model_checker/model_checker.hpp>
+#include <ispd/partitioning/lp_mapping.hpp>
 
 static unsigned g_star_machine_amount = 10;
 static unsigned g_star_task_amount = 100;
 
-tw_peid mapping(tw_lpid gid) { return (tw_peid)gid / g_tw_nlp; }
+/// \brief The route file path. It may be either a textual route file or a
+///        compiled route file generated by the `ispd_routec` tool.
+static char g_routes_path[1024] = "routes.route";
+
+/// \brief The number of threads that parse a textual route file or compute
+///        the routes, that check the model's consistency and that partition
+///        the logical processes. If zero, the hardware concurrency is used.
+static unsigned g_route_threads = 0;
+
+/// \brief If set, the shortest routes from the masters to their slaves are
+///        computed from the model's links instead of read from a file.
+static unsigned g_compute_routes = 0;
+
+/// \brief If set, the routes are stored in a prefix trie, such that the
+///        routes sharing a prefix share its memory.
+static unsigned g_share_route_prefixes = 0;
+
+/// \brief If set, each processing element keeps only the routes that may be
+///        looked up by the logical processes it hosts.
+static unsigned g_rank_local_routes = 0;
+
+/// \brief If set, each forwarding service looks up the next link of a task in
+///        its own next-hop table instead of in the route's full path.
+static unsigned g_next_hop_tables = 0;
+
+/// \brief How the model file and the route file are read by the ranks (see
+///        `ispd::input::ReadMode`). In the leader modes, they are read once,
+///        by rank 0 or by one rank per host, and broadcast to the others.
+static unsigned g_input_broadcast = 0;
+
+/// \brief If set, the model file is always parsed, and its binary snapshot is
+///        neither read nor written.
+static unsigned g_no_model_snapshot = 0;
+
+/// \brief If set, each processing element materializes only the state of the
+///        services it hosts, while still validating the whole model.
+static unsigned g_rank_local_model = 0;
+
+/// \brief If set, the services may be identified by sparse integers or by
+///        strings in the model file, which are remapped to dense global
+///        identifiers and reported with their model identifiers.
+static unsigned g_remap_ids = 0;
+
+/// \brief If set, the consistency of the loaded model and routes is not
+///        checked before the simulation starts.
+static unsigned g_no_model_check = 0;
+
+/// \brief If set, the logical processes (LP) are mapped to the processing
+///        elements (PE) by partitioning the graph of the services' links,
+///        weighted by the services' expected events, instead of in blocks of
+///        consecutive global identifiers.
+static unsigned g_partition_lps = 0;
+
+/// \brief The tolerated imbalance of the LPs' partition, in percent of the
+///        average number of expected events per PE.
+static unsigned g_partition_imbalance = 3;
+
+/// \brief Returns the number of logical processes (LP) per processing element
+///        (PE), such that the services are evenly distributed through the
+///        nodes.
+static unsigned getLpsPerPe(const std::size_t servicesSize) {
+  return (unsigned)ceil((double)servicesSize / tw_nnodes());
+}
+
+tw_peid mapping(tw_lpid gid) {
+  if (ispd::lp_mapping::isEnabled())
+    return ispd::lp_mapping::getPe(gid);
+  return (tw_peid)gid / g_tw_nlp;
+}
 
 tw_lptype lps_type[] = {
     {(init_f)ispd::services::master::init, (pre_run_f)NULL,
@@ -58,23 +132,104 @@ const tw_optdef opt[] = {
                "number of machines to simulate"),
     TWOPT_UINT("task-amount", g_star_task_amount,
                "number of tasks to simulate"),
+    TWOPT_CHAR("routes", g_routes_path,
+               "route file (textual or compiled by ispd_routec)"),
+    TWOPT_UINT("route-threads", g_route_threads,
+               "threads loading/checking routes, partitioning LPs (0 = all)"),
+    TWOPT_FLAG("compute-routes", g_compute_routes,
+               "compute the shortest routes from the model's links"),
+    TWOPT_FLAG("share-route-prefixes", g_share_route_prefixes,
+               "store the routes in a prefix trie to save memory"),
+    TWOPT_FLAG("rank-local-routes", g_rank_local_routes,
+               "keep only the routes used by the LPs of each PE"),
+    TWOPT_FLAG("next-hop-tables", g_next_hop_tables,
+               "forward through per-LP next-hop tables built at init"),
+    TWOPT_UINT("input-broadcast", g_input_broadcast,
+               "read the input files independently (0), at rank 0 (1) or "
+               "once per host (2)"),
+    TWOPT_FLAG("no-model-snapshot", g_no_model_snapshot,
+               "always parse the model file, ignoring its snapshot"),
+    TWOPT_FLAG("rank-local-model", g_rank_local_model,
+               "materialize only the services hosted by each PE"),
+    TWOPT_FLAG("remap-ids", g_remap_ids,
+               "accept sparse or string service identifiers in the model"),
+    TWOPT_FLAG("no-model-check", g_no_model_check,
+               "skip the consistency check of the model and the routes"),
+    TWOPT_FLAG("partition-lps", g_partition_lps,
+               "map the LPs to the PEs balancing their expected events"),
+    TWOPT_UINT("partition-imbalance", g_partition_imbalance,
+               "tolerated event imbalance of the partition (in percent)"),
     TWOPT_END(),
 };
 
 int main(int argc, char **argv) {
   ispd::log::setOutputFile(nullptr);
 
-  /// Read the routing table from a specified file.
-  ispd::routing_table::load("routes.route");
-
-  /// @Temporary: Must be removed.
-  ispd::model_loader::loadModel("model.json");
-
+  /// Each startup stage is measured as a phase, which are reduced through
+  /// the ranks and reported once the startup is over.
+  ///
   /// Remove the previously generated node-level aggreated report files.
+  ispd::profiler::beginPhase("purge_node_reports");
   ispd::global_metrics::purgeOldNodeReportFiles();
+  ispd::profiler::endPhase();
 
   tw_opt_add(opt);
+
+  ispd::profiler::beginPhase("tw_init");
   tw_init(&argc, &argv);
+  ispd::profiler::endPhase();
+
+  /// Check if an unknown input read mode has been specified. If so, the
+  /// program is immediately aborted.
+  if (g_input_broadcast > 2)
+    ispd_error("Unknown input read mode (%u).", g_input_broadcast);
+
+  const auto readMode = static_cast<ispd::input::ReadMode>(g_input_broadcast);
+
+  /// Check if the LPs are to be partitioned while the model is materialized
+  /// rank-locally. If so, the program is immediately aborted, since the
+  /// hosted services must be known before the model is loaded, while the
+  /// partition is computed from the loaded model.
+  if (g_partition_lps && g_rank_local_model && tw_nnodes() > 1)
+    ispd_error("The LPs cannot be partitioned if the model is materialized "
+               "rank-locally.");
+
+  /// @Temporary: Must be removed.
+  ///
+  /// The model is loaded after MPI has been initialized, since it may be
+  /// broadcast by the leaders.
+  ///
+  /// In the rank-local mode, a service is hosted by this node if it is mapped
+  /// to it, as the logical processes are defined below.
+  ispd::model_loader::HostPredicate isHosted = nullptr;
+
+  if (g_rank_local_model && tw_nnodes() > 1)
+    isHosted = [](const tw_lpid gid, const std::size_t servicesSize) {
+      return gid / getLpsPerPe(servicesSize) == g_tw_mynode;
+    };
+
+  if (g_remap_ids)
+    ispd::model_loader::enableIdentifierRemapping();
+
+  ispd::profiler::beginPhase("load_model");
+
+  if (readMode == ispd::input::ReadMode::INDEPENDENT)
+    ispd::model_loader::loadModel("model.json", !g_no_model_snapshot,
+                                  isHosted);
+  else
+    ispd::model_loader::loadModelFromMemory(
+        ispd::input::read("model.json", readMode).getText(), isHosted);
+
+  ispd::profiler::endPhase(ispd::model_loader::getServicesSize());
+
+  /// Check the references between the model's elements, such that a broken
+  /// model is rejected before the logical processes are defined.
+  if (!g_no_model_check) {
+    ispd::profiler::beginPhase("check_model");
+    ispd::model_checker::checkModel(g_route_threads);
+    ispd::profiler::endPhase(ispd::this_model::getLinks().size() +
+                             ispd::this_model::getMasters().m_Slaves.size());
+  }
 
   // If the synchronization protocol is different from conservative then,
   // there is no need to have a conservative lookahead different from 0.
@@ -89,8 +244,41 @@ int main(int argc, char **argv) {
   /// The amount of services to have its logical process type to be set.
   const auto servicesSize = ispd::model_loader::getServicesSize();
 
+  /// Distributed, with the partitioned mapping.
+  if (tw_nnodes() > 1 && g_partition_lps) {
+    ispd::profiler::beginPhase("partition_lps");
+    ispd::lp_mapping::build(tw_nnodes(), g_partition_imbalance / 100.0,
+                            g_route_threads);
+    ispd::profiler::endPhase(servicesSize);
+
+    /// The LPs are placed on this PE by the partitioned mapping, such that
+    /// each PE defines exactly the LPs mapped to it and no dummy is needed.
+    g_tw_mapping = CUSTOM;
+    g_tw_custom_initial_mapping = ispd::lp_mapping::mapLocalLps;
+    g_tw_custom_lp_global_to_local_map = ispd::lp_mapping::getLocalLp;
+
+    const tw_lpid lpCount = ispd::lp_mapping::getLocalLpCount();
+
+    ispd::profiler::beginPhase("tw_define_lps");
+    tw_define_lps(lpCount, sizeof(ispd_message));
+    ispd::profiler::endPhase(lpCount);
+    ispd::profiler::beginPhase("tw_lp_settype");
+
+    for (tw_lpid i = 0; i < lpCount; i++) {
+      /// The correspondent logical process type for the logical process
+      /// with the given local identifier.
+      const ispd::model_loader::LogicalProcessType type =
+          ispd::model_loader::getLogicalProcessType(
+              ispd::lp_mapping::getLocalGid(i));
+
+      /// Set the logical process type.
+      tw_lp_settype(i, &lps_type[type]);
+    }
+
+    ispd::profiler::endPhase(lpCount);
+  }
   /// Distributed.
-  if (tw_nnodes() > 1) {
+  else if (tw_nnodes() > 1) {
     /// Here, since we are distributing the logical processes through many
     /// nodes, the number of logical processes (LP) per process element (PE)
     /// should be calculated.
@@ -101,11 +289,13 @@ int main(int argc, char **argv) {
     /// lps (nlp). In this case, in the last node, after all the required
     /// logical processes be created, the remaining logical processes are going
     /// to be set as dummies.
-    const unsigned nlp_per_pe =
-        (unsigned)ceil((double)servicesSize / tw_nnodes());
+    const unsigned nlp_per_pe = getLpsPerPe(servicesSize);
 
     /// Set the number of logical processes (LP) per processing element (PE).
+    ispd::profiler::beginPhase("tw_define_lps");
     tw_define_lps(nlp_per_pe, sizeof(ispd_message));
+    ispd::profiler::endPhase(nlp_per_pe);
+    ispd::profiler::beginPhase("tw_lp_settype");
 
     /// Calculate the first logical processes global identifier in this node.
     /// With that, it can be track if the logical process with that global
@@ -137,13 +327,17 @@ int main(int argc, char **argv) {
       current_gid++;
     }
 
+    ispd::profiler::endPhase(nlp_per_pe);
     ispd_info("A total of %u dummies have been created at node %d.",
               dummy_count, g_tw_mynode);
   }
   /// Sequential.
   else {
     /// Set the total number of logical processes that should be created.
+    ispd::profiler::beginPhase("tw_define_lps");
     tw_define_lps(servicesSize, sizeof(ispd_message));
+    ispd::profiler::endPhase(servicesSize);
+    ispd::profiler::beginPhase("tw_lp_settype");
 
     for (size_t i = 0; i < servicesSize; i++) {
       /// The logical process global identifier to be registered.
@@ -157,8 +351,118 @@ int main(int argc, char **argv) {
       /// Set the logical process type.
       tw_lp_settype(gid, &lps_type[type]);
     }
+
+    ispd::profiler::endPhase(servicesSize);
   }
 
+  /// Populate the routing table. It is populated after the logical processes
+  /// have been defined, since the rank-local loading needs the logical
+  /// process mapping.
+  ispd::profiler::beginPhase("load_routes");
+
+  const auto &links = ispd::this_model::getLinks();
+  ispd::routing::VertexPredicate isRelevant = nullptr;
+
+  if (g_rank_local_routes && tw_nnodes() > 1) {
+    const auto isLocal = [](const tw_lpid gid) {
+      return mapping(gid) == g_tw_mynode;
+    };
+
+    /// A route is looked up by its source and by the services that forward
+    /// it, which are the ends of its links. Therefore, a link is relevant if
+    /// either the link or one of its ends is hosted by this node.
+    isRelevant = [&links, isLocal](const tw_lpid gid) {
+      if (isLocal(gid))
+        return true;
+
+      const auto row = ispd::this_model::findLink(gid);
+
+      return row != ispd::model::g_NoServiceRow &&
+             (isLocal(links.m_From[row]) || isLocal(links.m_To[row]));
+    };
+  }
+
+  if (g_share_route_prefixes)
+    ispd::routing_table::enablePrefixSharing();
+
+  std::vector<ispd::routing::RouteEdge> edges;
+  std::vector<ispd::routing::RouteDemand> demands;
+
+  if (g_compute_routes || g_next_hop_tables) {
+    /// Each link is weighted by the time to communicate one megabit through
+    /// it, which accounts for both its latency and its bandwidth.
+    edges.reserve(links.size());
+    for (std::size_t row = 0; row < links.size(); row++)
+      edges.push_back({links.m_Gid[row], links.m_From[row], links.m_To[row],
+                       links.getConfiguration(row).timeToCommunicate(1.0)});
+
+    const auto &masters = ispd::this_model::getMasters();
+
+    demands.reserve(masters.size());
+    for (std::size_t row = 0; row < masters.size(); row++)
+      demands.push_back({masters.m_Gid[row], masters.getSlaves(row)});
+
+    /// Sort the links and the masters, such that every rank computes the
+    /// same routes with the same identifiers.
+    std::sort(edges.begin(), edges.end(), [](const auto &a, const auto &b) {
+      return a.m_Link < b.m_Link;
+    });
+    std::sort(demands.begin(), demands.end(), [](const auto &a, const auto &b) {
+      return a.m_Src < b.m_Src;
+    });
+  }
+
+  /// Only the switches and the machines forward the tasks.
+  const auto isForwarding = [](const tw_lpid gid) {
+    const auto type = ispd::model_loader::getLogicalProcessType(gid);
+
+    return type == ispd::model_loader::LogicalProcessType::SWITCH ||
+           type == ispd::model_loader::LogicalProcessType::MACHINE;
+  };
+
+  if (ispd::routing_table::hasImplicitProvider()) {
+    /// The routes are computed on demand by the implicit provider selected
+    /// by the model, such that there is nothing to be loaded.
+  } else if (g_compute_routes) {
+    ispd::routing_table::compute(edges, demands, isForwarding,
+                                 g_route_threads, isRelevant);
+  } else if (readMode != ispd::input::ReadMode::INDEPENDENT) {
+    ispd::routing_table::load(g_routes_path,
+                              ispd::input::read(g_routes_path, readMode),
+                              g_route_threads, isRelevant);
+  } else {
+    ispd::routing_table::load(g_routes_path, g_route_threads, isRelevant);
+  }
+
+  ispd::profiler::endPhase(ispd::routing_table::getRouteCount());
+
+  /// Check the routes from the masters to their slaves. In distributed runs,
+  /// each node checks the routes from the masters it hosts, which are kept
+  /// even if the routes are loaded rank-locally.
+  if (!g_no_model_check) {
+    ispd::routing::VertexPredicate isLocal = nullptr;
+
+    if (tw_nnodes() > 1)
+      isLocal = [](const tw_lpid gid) { return mapping(gid) == g_tw_mynode; };
+
+    ispd::profiler::beginPhase("check_routes");
+    ispd::model_checker::checkRoutes(g_route_threads, isLocal);
+    ispd::profiler::endPhase();
+  }
+
+  /// Build the next-hop tables of the forwarding services hosted by this
+  /// node, which are fetched by the services at their initialization.
+  if (g_next_hop_tables) {
+    ispd::profiler::beginPhase("build_next_hop_tables");
+    ispd::forwarding_table::build(
+        demands, edges, [&isForwarding](const tw_lpid gid) {
+          return mapping(gid) == g_tw_mynode && isForwarding(gid);
+        });
+    ispd::profiler::endPhase();
+  }
+
+  ispd::profiler::reportPhases();
+
   tw_run();
   ispd::node_metrics::reportNodeMetrics();
   ispd::node_metrics::reportNodeMetricsToFile();
@@ -7,6 +7,8 @@
 #include <lib/nlohmann/json.hpp>
 #include <ispd/model/builder.hpp>
 #include <ispd/metrics/metrics.hpp>
+#include <ispd/model_loader/model_loader.hpp>
+#include <ispd/profiler/profiler.hpp>
 #include <ispd/metrics/machine_metrics.hpp>
 
 /// \brief Generates the file path for the report of a specific node.
@@ -30,11 +32,15 @@ void NodeMetricsCollector::reportNodeUserMetrics() {
   /// An alias for the global metrics collector.
   auto gmc = ispd::global_metrics::g_GlobalMetricsCollector;
 
-  /// Fetch the mapping containing all registered users in the system being simulated.
+  /// Fetch all registered users in the system being simulated.
   const auto& registeredUsers = ispd::this_model::getUsers();
 
+  /// The total user metrics are indexed by the users' identifiers.
+  gmc->m_GlobalUserMetrics.resize(registeredUsers.size());
+
   /// Report each user metrics.
-  for (const auto& [id, user] : registeredUsers) {
+  for (const auto& user : registeredUsers) {
+    const auto id = user.getId();
     const auto& metrics = user.getMetrics();
 
     #define REDUCE_USER_METRIC(op, type, field, fieldName) \
@@ -372,7 +378,8 @@ void GlobalMetricsCollector::reportGlobalMetrics() {
   ispd_info("");
   ispd_info("User Metrics");
   
-  for (const auto& [id, userMetrics] : m_GlobalUserMetrics) {
+  for (ispd::model::User::uid_t id = 0; id < m_GlobalUserMetrics.size(); id++) {
+    const auto& userMetrics = m_GlobalUserMetrics[id];
     const double userAvgProcTime = userMetrics.m_ProcTime / userMetrics.m_IssuedTasks;
     const double userAvgProcWaitingTime = userMetrics.m_ProcWaitingTime / userMetrics.m_IssuedTasks;
     const double userAvgCommTime = userMetrics.m_CommTime / userMetrics.m_IssuedTasks;
@@ -563,7 +570,8 @@ void GlobalMetricsCollector::reportGlobalMetricsToFile(
   /// Writing the user-related metrics.
   json users;
 
-  for (const auto& [id, userMetrics] : m_GlobalUserMetrics) {
+  for (ispd::model::User::uid_t id = 0; id < m_GlobalUserMetrics.size(); id++) {
+    const auto& userMetrics = m_GlobalUserMetrics[id];
     const double userAvgProcTime = userMetrics.m_ProcTime / userMetrics.m_IssuedTasks;
     const double userAvgProcWaitingTime = userMetrics.m_ProcWaitingTime / userMetrics.m_IssuedTasks;
     const double userAvgCommTime = userMetrics.m_CommTime / userMetrics.m_IssuedTasks;
@@ -588,6 +596,10 @@ void GlobalMetricsCollector::reportGlobalMetricsToFile(
   json services = aggregateNodeFileReport();
   data["services"] = services;
 
+  /// Writing the startup phases, if they have been reported.
+  if (const auto &startup = ispd::profiler::getPhasesReport(); !startup.is_null())
+    data["startup"] = startup;
+
   /// Write the JSON content into the file using the prettified format.
   out << std::setw(2) << data << std::endl;
 }
@@ -646,7 +658,8 @@ namespace ispd::node_metrics {
     report["simulated_on"] = "node_" + std::to_string(g_tw_mynode);
 
     /// Write the report of the current machine to the node metrics report.
-    g_NodeMetricsReport->emplace(std::to_string(gid), report);
+    g_NodeMetricsReport->emplace(
+        ispd::model_loader::getServiceIdentifier(gid), report);
   }
 
   void notifyReport(const ispd::metrics::LinkMetrics &metrics,
@@ -668,7 +681,8 @@ namespace ispd::node_metrics {
     report["simulated_on"] = "node_" + std::to_string(g_tw_mynode);
 
     /// Write the report of the current link to the node metrics report.
-    g_NodeMetricsReport->emplace(std::to_string(gid), report);
+    g_NodeMetricsReport->emplace(
+        ispd::model_loader::getServiceIdentifier(gid), report);
   }
 
   void notifyReport(const ispd::metrics::MasterMetrics &metrics,
@@ -685,7 +699,8 @@ namespace ispd::node_metrics {
     report["simulated_on"] = "node_" + std::to_string(g_tw_mynode);
 
     /// Write the report of the current master to the node metrics report.
-    g_NodeMetricsReport->emplace(std::to_string(gid), report);
+    g_NodeMetricsReport->emplace(
+        ispd::model_loader::getServiceIdentifier(gid), report);
   }
 
   void
@@ -700,7 +715,8 @@ namespace ispd::node_metrics {
     report["downward_communicated_packets"] = metrics.m_DownwardCommPackets;
 
     /// Write the report of the current switch to the node metrics report.
-    g_NodeMetricsReport->emplace(std::to_string(gid), report);
+    g_NodeMetricsReport->emplace(
+        ispd::model_loader::getServiceIdentifier(gid), report);
   }
 
   void reportNodeMetrics() {
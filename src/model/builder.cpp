@@ -2,10 +2,6 @@
 #include <string>
 #include <algorithm>
 #include <ispd/model/builder.hpp>
-#include <ispd/services/master.hpp>
-#include <ispd/services/link.hpp>
-#include <ispd/services/machine.hpp>
-#include <ispd/services/switch.hpp>
 #include <ispd/configuration/machine.hpp>
 
 static inline std::string firstSlaves(const std::vector<tw_lpid> &slaves) {
@@ -26,7 +22,7 @@ void SimulationModel::registerMachine(
     const tw_lpid gid, const double power, const double load,
     const unsigned coreCount, const double gpuPower,
     const unsigned gpuCoreCount, const double interconnectionBandwidth,
-    const double wattageIdle, const double wattageMax) {
+    const double wattageIdle, const double wattageMax, const tw_lpid count) {
   /// Check if the power is not positive. If so, an error indicating the
   /// case is sent and the program is immediately aborted.
   if (power <= 0.0)
@@ -57,23 +53,26 @@ void SimulationModel::registerMachine(
         "(Specified Interconnection Bandwidth: %lf).",
         gid, interconnectionBandwidth);
 
-  /// Register the service initializer for a machine with the specified
-  /// logical process global identifier (GID).
-  registerServiceInitializer(gid, [=](void *state) {
-    ispd::services::machine_state *s =
-        static_cast<ispd::services::machine_state *>(state);
-
-    /// Initialize machine's configuration.
-    s->conf = ispd::configuration::MachineConfiguration(
-        power, load, coreCount, gpuPower, gpuCoreCount,
-        interconnectionBandwidth, wattageIdle, wattageMax);
-    s->cores_free_time.resize(coreCount, 0.0);
-  });
+  /// Register the machines' configuration in a new row of the machines
+  /// table, which is shared by every machine in the range. The configuration
+  /// itself is interned, such that it is also shared by the other machines
+  /// with the same hardware.
+  for (tw_lpid i = 0; i < count; i++)
+    registerServiceRow(gid + i, m_Machines.size());
+
+  m_Machines.m_Gid.push_back(gid);
+  m_Machines.m_Configuration.push_back(m_Machines.m_Configurations.intern(
+      {power, load, static_cast<double>(coreCount), gpuPower,
+       static_cast<double>(gpuCoreCount), interconnectionBandwidth,
+       wattageIdle, wattageMax},
+      ispd::configuration::MachineConfiguration(
+          power, load, coreCount, gpuPower, gpuCoreCount,
+          interconnectionBandwidth, wattageIdle, wattageMax)));
 
   /// Print a debug indicating that a machine initializer has been registered.
-  ispd_debug(
-      "A machine with GID %lu has been registered (P: %lf, L: %lf, C: %u).",
-      gid, power, load, coreCount);
+  ispd_debug("A machine with GID %lu has been registered (P: %lf, L: %lf, C: "
+             "%u, N: %lu).",
+             gid, power, load, coreCount, count);
 }
 
 void SimulationModel::registerLink(const tw_lpid gid, const tw_lpid from,
@@ -100,19 +99,16 @@ void SimulationModel::registerLink(const tw_lpid gid, const tw_lpid from,
                "(Specified Latency: %lf).",
                gid, latency);
 
-  /// Register the service initializer for a link with the specified
-  /// logical process global identifier (GID).
-  registerServiceInitializer(gid, [=](void *state) {
-    ispd::services::link_state *s =
-        static_cast<ispd::services::link_state *>(state);
-
-    /// Initialize the link's ends.
-    s->from = from;
-    s->to = to;
-
-    /// Initialize the link's configuration.
-    s->conf = ispd::configuration::LinkConfiguration(bandwidth, load, latency);
-  });
+  /// Register the link's ends and configuration in a new row of the links
+  /// table, such that the link topology is known without initializing the
+  /// link.
+  registerServiceRow(gid, m_Links.size());
+  m_Links.m_Gid.push_back(gid);
+  m_Links.m_From.push_back(from);
+  m_Links.m_To.push_back(to);
+  m_Links.m_Configuration.push_back(m_Links.m_Configurations.intern(
+      {bandwidth, load, latency},
+      ispd::configuration::LinkConfiguration(bandwidth, load, latency)));
 
   /// Print a debug indicating that a link initializer has been registered.
   ispd_debug(
@@ -121,7 +117,8 @@ void SimulationModel::registerLink(const tw_lpid gid, const tw_lpid from,
 }
 
 void SimulationModel::registerSwitch(const tw_lpid gid, const double bandwidth,
-                                     const double load, const double latency) {
+                                     const double load, const double latency,
+                                     const tw_lpid count) {
   /// Check if the bandwidth is not positive. If so, an error indicating the
   /// case is sent and the program is immediately aborted.
   if (bandwidth <= 0.0)
@@ -143,26 +140,28 @@ void SimulationModel::registerSwitch(const tw_lpid gid, const double bandwidth,
                "(Specified Latency: %lf).",
                gid, latency);
 
-  /// Register the service initializer for a switch with the specified
-  /// logical process global identifier (GID).
-  registerServiceInitializer(gid, [=](void *state) {
-    ispd::services::SwitchState *s =
-        static_cast<ispd::services::SwitchState *>(state);
+  /// Register the switches' configuration in a new row of the switches table,
+  /// which is shared by every switch in the range. The configuration itself
+  /// is interned, such that it is also shared by the other switches with the
+  /// same hardware.
+  for (tw_lpid i = 0; i < count; i++)
+    registerServiceRow(gid + i, m_Switches.size());
 
-    /// Initialize the switch's configuration.
-    s->m_Conf =
-        ispd::configuration::SwitchConfiguration(bandwidth, load, latency);
-  });
+  m_Switches.m_Gid.push_back(gid);
+  m_Switches.m_Configuration.push_back(m_Switches.m_Configurations.intern(
+      {bandwidth, load, latency},
+      ispd::configuration::SwitchConfiguration(bandwidth, load, latency)));
 
   /// Print a debug indicating that a switch initializer has been registered.
-  ispd_debug(
-      "A switch with GID %lu has been registered (B: %lf, L: %lf, LT: %lf).",
-      gid, bandwidth, load, latency);
+  ispd_debug("A switch with GID %lu has been registered (B: %lf, L: %lf, LT: "
+             "%lf, N: %lu).",
+             gid, bandwidth, load, latency, count);
 }
 
 void SimulationModel::registerMaster(
     const tw_lpid gid, std::vector<tw_lpid> &&slaves,
     ispd::scheduler::Scheduler *const scheduler,
+    ispd::route_selector::RouteSelector *const routeSelector,
     ispd::workload::Workload *const workload) {
 
   /// Check if the scheduler has not been specified. If so, an error indicating
@@ -172,6 +171,13 @@ void SimulationModel::registerMaster(
         "At registering the master %lu the scheduler has not been specified.",
         gid);
 
+  /// Check if the route selector has not been specified. If so, an error
+  /// indicating the case is sent and the program is immediately aborted.
+  if (!routeSelector)
+    ispd_error("At registering the master %lu the route selector has not been "
+               "specified.",
+               gid);
+
   /// Check if the workload has not been specified. If so, an error indicating
   /// the case is sent and the program is immediately aborted.
   if (!workload)
@@ -182,19 +188,10 @@ void SimulationModel::registerMaster(
   const auto slaveCount = slaves.size();
   const auto someSlaves = firstSlaves(slaves);
 
-  /// Register the service initializer for a master with the specified
-  /// logical process global identifier.
-  registerServiceInitializer(gid, [workload, scheduler, slaves](void *state) {
-    ispd::services::master_state *s =
-        static_cast<ispd::services::master_state *>(state);
-
-    /// Specify the master's slaves.
-    s->slaves = slaves;
-
-    /// Specify the master's schedule and workload.
-    s->scheduler = scheduler;
-    s->workload = workload;
-  });
+  /// Register the master's components and slaves in a new row of the masters
+  /// table, such that the routes to its slaves can be computed without
+  /// initializing the master.
+  registerMasterRow(gid, slaves, scheduler, routeSelector, workload);
 
   /// Print a debug indicating that a master initializer has been registered.
   ispd_debug("A master with GID %lu has been registered (SC: %u, S: %s).", gid,
@@ -235,27 +232,64 @@ void SimulationModel::registerUser(const std::string &name,
     ispd_error("An invalid username has been specified. It must contain at "
                "least one letter.");
 
-  /// Assign automatically a user identifier.
+  /// Assign automatically a user identifier, which is the user's index in
+  /// the users vector.
   const uid_t id = static_cast<uid_t>(m_Users.size());
 
-  /// Construct the user and insert into the users mapping.
-  m_Users.emplace(id, User(id, name, energyConsumptionLimit));
+  /// Construct the user and index it by its name.
+  m_Users.emplace_back(id, name, energyConsumptionLimit);
+  m_UserIds.emplace(name, id);
 
   ispd_debug(
       "A user named %s with consumption limit of %.2lf has been registered.",
       name.c_str(), energyConsumptionLimit);
 }
 
-[[nodiscard]] const std::function<void(void *)> &
-SimulationModel::getServiceInitializer(const tw_lpid gid) noexcept {
-  /// Checks if a service initializer for the specified global identifier has
-  /// not been registered. If so, the program is immediately aborted, since
-  /// service initializer is mandatory for every service.
-  if (service_initializers.find(gid) == service_initializers.end())
-    ispd_error(
-        "A service initializer for service with GID %lu has not been found.",
-        gid);
-  return service_initializers.at(gid);
+void SimulationModel::registerRemoteService(const tw_lpid gid) {
+  registerServiceRow(gid, g_RemoteServiceRow);
+
+  ispd_debug("A remote service with GID %lu has been registered.", gid);
+}
+
+void SimulationModel::registerRemoteMaster(const tw_lpid gid,
+                                           std::vector<tw_lpid> &&slaves) {
+  registerMasterRow(gid, slaves, nullptr, nullptr, nullptr);
+
+  ispd_debug("A remote master with GID %lu has been registered (SC: %lu).",
+             gid, slaves.size());
+}
+
+[[nodiscard]] ServiceRow
+SimulationModel::getServiceRow(const tw_lpid gid) const noexcept {
+  /// Checks if a service with the specified global identifier has not been
+  /// registered. If so, the program is immediately aborted, since the
+  /// configuration is mandatory for every service.
+  if (gid >= m_Rows.size() || m_Rows[gid] == g_NoServiceRow)
+    ispd_error("A configuration for service with GID %lu has not been found.",
+               gid);
+
+  /// Checks if the service's configuration has not been materialized in this
+  /// node. If so, the program is immediately aborted, since only the hosted
+  /// services are initialized.
+  if (m_Rows[gid] == g_RemoteServiceRow)
+    ispd_error("The configuration for service with GID %lu has not been "
+               "materialized at node %lu.",
+               gid, g_tw_mynode);
+  return m_Rows[gid];
+}
+
+[[nodiscard]] ServiceRow
+SimulationModel::findLink(const tw_lpid gid) const noexcept {
+  if (gid >= m_Rows.size())
+    return g_NoServiceRow;
+
+  const ServiceRow row = m_Rows[gid];
+
+  /// The rows are per service type, such that the row must be checked to be
+  /// the specified link's row.
+  if (row < m_Links.size() && m_Links.m_Gid[row] == gid)
+    return row;
+  return g_NoServiceRow;
 }
 }; // namespace ispd::model
 
@@ -268,10 +302,12 @@ void registerMachine(const tw_lpid gid, const double power, const double load,
                      const unsigned coreCount, const double gpuPower,
                      const unsigned gpuCoreCount,
                      const double interconnectionBandwidth,
-                     const double wattageIdle, const double wattageMax) {
+                     const double wattageIdle, const double wattageMax,
+                     const tw_lpid count) {
   /// Forward the machine registration to the global model.
   g_Model->registerMachine(gid, power, load, coreCount, gpuPower, gpuCoreCount,
-                           interconnectionBandwidth, wattageIdle, wattageMax);
+                           interconnectionBandwidth, wattageIdle, wattageMax,
+                           count);
 }
 
 void registerLink(const tw_lpid gid, const tw_lpid from, const tw_lpid to,
@@ -282,16 +318,19 @@ void registerLink(const tw_lpid gid, const tw_lpid from, const tw_lpid to,
 }
 
 void registerSwitch(const tw_lpid gid, const double bandwidth,
-                    const double load, const double latency) {
+                    const double load, const double latency,
+                    const tw_lpid count) {
   /// Forward the switch registration to the global model.
-  g_Model->registerSwitch(gid, bandwidth, load, latency);
+  g_Model->registerSwitch(gid, bandwidth, load, latency, count);
 }
 
 void registerMaster(const tw_lpid gid, std::vector<tw_lpid> &&slaves,
                     ispd::scheduler::Scheduler *const scheduler,
+                    ispd::route_selector::RouteSelector *const routeSelector,
                     ispd::workload::Workload *const workload) {
   /// Forward the master registration to the global model.
-  g_Model->registerMaster(gid, std::move(slaves), scheduler, workload);
+  g_Model->registerMaster(gid, std::move(slaves), scheduler, routeSelector,
+                          workload);
 }
 
 void registerUser(const std::string &name,
@@ -300,14 +339,27 @@ void registerUser(const std::string &name,
   g_Model->registerUser(name, energyConsumptionLimit);
 }
 
-[[nodiscard]] const std::function<void(void *)> &
-getServiceInitializer(const tw_lpid gid) {
-  /// Forward the service initializer query to the global model.
-  return g_Model->getServiceInitializer(gid);
+void registerRemoteService(const tw_lpid gid) {
+  /// Forward the remote service registration to the global model.
+  g_Model->registerRemoteService(gid);
+}
+
+void registerRemoteMaster(const tw_lpid gid, std::vector<tw_lpid> &&slaves) {
+  /// Forward the remote master registration to the global model.
+  g_Model->registerRemoteMaster(gid, std::move(slaves));
+}
+
+[[nodiscard]] ispd::model::ServiceRow getServiceRow(const tw_lpid gid) {
+  /// Forward the service row query to the global model.
+  return g_Model->getServiceRow(gid);
+}
+
+[[nodiscard]] ispd::model::ServiceRow findLink(const tw_lpid gid) {
+  /// Forward the link row query to the global model.
+  return g_Model->findLink(gid);
 }
 
-[[nodiscard]] const std::unordered_map<ispd::model::User::uid_t,
-                                       ispd::model::User> &
+[[nodiscard]] const ispd::model::SimulationModel::user_vector_type &
 getUsers() {
   /// Forward the users query to the global model.
   return g_Model->getUsers();
@@ -318,9 +370,29 @@ getUsers() {
   return g_Model->getUserById(id);
 }
 
-[[nodiscard]] const std::unordered_map<ispd::model::User::uid_t,
-                                       ispd::model::User>::const_iterator
-getUserByName(const std::string &name) {
+[[nodiscard]] const ispd::model::MachineTable &getMachines() {
+  /// Forward the machines query to the global model.
+  return g_Model->getMachines();
+}
+
+[[nodiscard]] const ispd::model::LinkTable &getLinks() {
+  /// Forward the links query to the global model.
+  return g_Model->getLinks();
+}
+
+[[nodiscard]] const ispd::model::SwitchTable &getSwitches() {
+  /// Forward the switches query to the global model.
+  return g_Model->getSwitches();
+}
+
+[[nodiscard]] const ispd::model::MasterTable &getMasters() {
+  /// Forward the masters query to the global model.
+  return g_Model->getMasters();
+}
+
+[[nodiscard]] const ispd::model::SimulationModel::user_vector_type::
+    const_iterator
+    getUserByName(const std::string &name) {
   /// Forward the user query by name to the global model.
   return g_Model->getUserByName(name);
 }
@@ -0,0 +1,917 @@
+/// \file modelgen.cpp
+///
+/// \brief The synthetic model generator.
+///
+/// This tool generates a consistent model specification (`model.json`), with
+/// its users, workloads and services, and its route file (`routes.route`) for
+/// a parameterized star, tree, fat-tree or torus topology, such that the
+/// engine can be benchmarked with models of millions of services that would
+/// never be written by hand.
+///
+/// The services are numbered as documented by the implicit routing provider
+/// of the topology (see `ispd::routing_provider`), whose routes are the ones
+/// written to the route file. Therefore, the same model is simulated with the
+/// same routes whether they are read from the route file, computed on demand
+/// by the implicit provider or computed from the links. Every master has a
+/// uniform workload and every machine as its slave.
+///
+/// The model and the routes are streamed to their files as they are
+/// generated, through large buffers and without any intermediate document,
+/// such that the memory held does not depend on the model's size. The output
+/// only depends on the arguments, such that a scaling benchmark is
+/// reproduced by regenerating its models.
+///
+/// Usage: ispd_modelgen [options] <topology> <arguments...>
+///
+///   - `star <masters> <machines>`
+///   - `tree <masters> <arity> <depth>`
+///   - `fat_tree <masters> <k>`
+///   - `torus <masters> <size>[x<size>...]`
+///
+/// Options:
+///
+///   - `--routes <text|compiled|implicit|links>`: How the routes are given
+///     (default: `compiled`). The textual and the compiled route files are
+///     both written to `routes.route`, since the routing table tells them
+///     apart by their contents. With `implicit`, the model selects the
+///     topology's implicit provider and no route file is written. With
+///     `links`, no route file is written and the simulator must be run with
+///     `--compute-routes`.
+///   - `--ranges`: Declares the services as ranges (see `loadModel`) instead
+///     of one by one, which keeps the model file small.
+///   - `--users <count>`: The number of users, which own the workloads in
+///     turns (default: 1).
+///   - `--tasks <count>`: The number of tasks of each workload (default: 100).
+///   - `--route-selection <policy>`: The masters' route selection policy
+///     (default: `First`).
+///   - `--output <directory>`: The directory of the generated files (default:
+///     the current directory).
+#include <cerrno>
+#include <chrono>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ispd/log/log.hpp>
+#include <ispd/routing/route_file.hpp>
+#include <ispd/routing_provider/star.hpp>
+#include <ispd/routing_provider/tree.hpp>
+#include <ispd/routing_provider/fat_tree.hpp>
+#include <ispd/routing_provider/torus.hpp>
+
+namespace {
+
+using ispd::routing_provider::FatTree;
+using ispd::routing_provider::Star;
+using ispd::routing_provider::Torus;
+using ispd::routing_provider::Tree;
+
+/// \brief The size of the output files' buffers, in bytes.
+constexpr std::size_t g_OutputBufferSize = 8 << 20;
+
+/// \brief The services' hardware and the workloads' parameters, which are the
+///        same for every generated model, such that the models of a scaling
+///        benchmark only differ in their size.
+constexpr std::string_view g_UserAttributes =
+    "\"energy_consumption_limit\": 1000000000.0";
+constexpr std::string_view g_WorkloadAttributes =
+    "\"type\": \"uniform\", \"computing_offload\": 0.0, "
+    "\"interarrival_type\": {\"type\": \"poisson\", \"lambda\": 1.0}, "
+    "\"min_proc_size\": 100.0, \"max_proc_size\": 200.0, "
+    "\"min_comm_size\": 10.0, \"max_comm_size\": 20.0";
+constexpr std::string_view g_MachineAttributes =
+    "\"power\": 2000.0, \"load\": 0.0, \"core_count\": 8, "
+    "\"gpu_power\": 0.0, \"gpu_core_count\": 0, "
+    "\"gpu_interconnection_bandwidth\": 1.0, \"wattage_idle\": 100.0, "
+    "\"wattage_max\": 200.0";
+constexpr std::string_view g_LinkAttributes =
+    "\"bandwidth\": 10000.0, \"load\": 0.0, \"latency\": 0.001";
+constexpr std::string_view g_SwitchAttributes =
+    "\"bandwidth\": 100000.0, \"load\": 0.0, \"latency\": 0.0001";
+
+/// \brief How the routes of the generated model are given.
+enum class RouteOutput { TEXT, COMPILED, IMPLICIT, LINKS };
+
+/// \brief The generator's options (see the usage above).
+struct Options final {
+  RouteOutput m_Routes = RouteOutput::COMPILED;
+  bool m_Ranges = false;
+  std::uint64_t m_UserCount = 1;
+  std::uint64_t m_TaskCount = 100;
+  std::string m_RouteSelection = "First";
+  std::filesystem::path m_Output = ".";
+};
+
+/// \class OutputFile
+///
+/// \brief A file written through a large buffer, in which the numbers are
+///        formatted in place with `std::to_chars`.
+class OutputFile final {
+  std::string m_Path;
+  std::FILE *m_File;
+  std::vector<char> m_Buffer;
+  std::size_t m_Size = 0;
+  std::uint64_t m_Written = 0;
+
+  auto flush() -> void {
+    if (std::fwrite(m_Buffer.data(), 1, m_Size, m_File) != m_Size)
+      ispd_error("File %s could not be written (%s).", m_Path.c_str(),
+                 std::strerror(errno));
+
+    m_Written += m_Size;
+    m_Size = 0;
+  }
+
+  /// \brief Returns where the specified number of bytes is written next.
+  [[nodiscard]] inline auto reserve(const std::size_t size) -> char * {
+    if (m_Size + size > m_Buffer.size())
+      flush();
+    return m_Buffer.data() + m_Size;
+  }
+
+public:
+  explicit OutputFile(const std::filesystem::path &path)
+      : m_Path(path.string()), m_File(std::fopen(m_Path.c_str(), "wb")),
+        m_Buffer(g_OutputBufferSize) {
+    if (!m_File)
+      ispd_error("File %s could not be created (%s).", m_Path.c_str(),
+                 std::strerror(errno));
+  }
+
+  OutputFile(const OutputFile &) = delete;
+  auto operator=(const OutputFile &) -> OutputFile & = delete;
+
+  ~OutputFile() {
+    if (m_File)
+      close();
+  }
+
+  inline auto write(const std::string_view text) -> void {
+    writeBytes(text.data(), text.size());
+  }
+
+  /// \brief Writes the number in decimal.
+  inline auto write(const std::uint64_t value) -> void {
+    char *const first = reserve(20);
+
+    m_Size += std::to_chars(first, first + 20, value).ptr - first;
+  }
+
+  /// \brief Writes the number as a 64-bit word.
+  inline auto writeWord(const std::uint64_t value) -> void {
+    std::memcpy(reserve(sizeof(value)), &value, sizeof(value));
+    m_Size += sizeof(value);
+  }
+
+  inline auto writeBytes(const void *const data, const std::size_t size)
+      -> void {
+    /// The data that does not fit in the buffer is written directly.
+    if (size > m_Buffer.size()) {
+      flush();
+      if (std::fwrite(data, 1, size, m_File) != size)
+        ispd_error("File %s could not be written (%s).", m_Path.c_str(),
+                   std::strerror(errno));
+      m_Written += size;
+      return;
+    }
+
+    std::memcpy(reserve(size), data, size);
+    m_Size += size;
+  }
+
+  /// \brief Closes the file and returns the number of bytes written to it.
+  auto close() -> std::uint64_t {
+    flush();
+
+    if (std::fclose(m_File) != 0)
+      ispd_error("File %s could not be closed (%s).", m_Path.c_str(),
+                 std::strerror(errno));
+    m_File = nullptr;
+    return m_Written;
+  }
+};
+
+/// \brief The ranges of the masters, machines and switches of a topology,
+///        which are numbered consecutively by their implicit provider.
+struct Layout final {
+  tw_lpid m_MasterCount;
+  tw_lpid m_FirstMachine;
+  tw_lpid m_MachineCount;
+  tw_lpid m_FirstSwitch;
+  tw_lpid m_SwitchCount;
+};
+
+/// \brief A run of links with consecutive identifiers, whose ends advance by
+///        a constant stride, as declared by a link range in the model.
+struct LinkRun final {
+  tw_lpid m_Id;
+  tw_lpid m_Count;
+  tw_lpid m_From;
+  tw_lpid m_FromStride;
+  tw_lpid m_To;
+  tw_lpid m_ToStride;
+};
+
+/// \brief Returns `base^exponent`.
+auto power(const tw_lpid base, const unsigned exponent) noexcept -> tw_lpid {
+  tw_lpid result = 1;
+
+  for (unsigned i = 0; i < exponent; i++)
+    result *= base;
+  return result;
+}
+
+/// \class StarTopology
+///
+/// \brief Generates a star topology with the numbering of `Star`.
+class StarTopology final {
+  tw_lpid m_MasterCount;
+  tw_lpid m_MachineCount;
+
+public:
+  const Star m_Provider;
+
+  StarTopology(const tw_lpid masterCount, const tw_lpid machineCount)
+      : m_MasterCount(masterCount), m_MachineCount(machineCount),
+        m_Provider(masterCount, machineCount) {}
+
+  [[nodiscard]] auto getLayout() const noexcept -> Layout {
+    return {m_MasterCount, m_MasterCount, m_MachineCount,
+            m_MasterCount + m_MachineCount, 1};
+  }
+
+  template <typename Function>
+  auto forEachLinkRun(Function &&function) const -> void {
+    const tw_lpid hub = m_MasterCount + m_MachineCount;
+
+    function(LinkRun{hub + 1, m_MasterCount, 0, 1, hub, 0});
+    function(LinkRun{hub + 1 + m_MasterCount, m_MachineCount, hub, 0,
+                     m_MasterCount, 1});
+  }
+
+  auto writeRouting(OutputFile &file) const -> void {
+    file.write("\"provider\": \"star\", \"masters\": ");
+    file.write(m_MasterCount);
+    file.write(", \"machines\": ");
+    file.write(m_MachineCount);
+  }
+};
+
+/// \class TreeTopology
+///
+/// \brief Generates a complete tree topology with the numbering of `Tree`.
+class TreeTopology final {
+  tw_lpid m_MasterCount;
+  tw_lpid m_Arity;
+  unsigned m_Depth;
+  tw_lpid m_LeafCount;
+  tw_lpid m_SwitchCount;
+
+public:
+  const Tree m_Provider;
+
+  TreeTopology(const tw_lpid masterCount, const tw_lpid arity,
+               const unsigned depth)
+      : m_MasterCount(masterCount), m_Arity(arity), m_Depth(depth),
+        m_Provider(masterCount, arity, depth) {
+    /// The provider has already checked the arity and the depth.
+    m_LeafCount = power(arity, depth);
+    m_SwitchCount = (m_LeafCount - 1) / (arity - 1);
+  }
+
+  [[nodiscard]] auto getLayout() const noexcept -> Layout {
+    return {m_MasterCount, m_MasterCount, m_LeafCount,
+            m_MasterCount + m_LeafCount, m_SwitchCount};
+  }
+
+  template <typename Function>
+  auto forEachLinkRun(Function &&function) const -> void {
+    const tw_lpid root = m_MasterCount + m_LeafCount;
+    const tw_lpid masterLinks = root + m_SwitchCount;
+    const tw_lpid switchLinks = masterLinks + m_MasterCount;
+    const tw_lpid machineLinks = switchLinks + m_SwitchCount - 1;
+    const tw_lpid lastLevel = (power(m_Arity, m_Depth - 1) - 1) / (m_Arity - 1);
+
+    function(LinkRun{masterLinks, m_MasterCount, 0, 1, root, 0});
+
+    /// The links to the children of each switch above the last level.
+    for (tw_lpid parent = 0; parent < lastLevel; parent++)
+      function(LinkRun{switchLinks + parent * m_Arity, m_Arity, root + parent,
+                       0, root + parent * m_Arity + 1, 1});
+
+    /// The links to the machines of each switch of the last level.
+    for (tw_lpid parent = 0; parent < m_LeafCount / m_Arity; parent++)
+      function(LinkRun{machineLinks + parent * m_Arity, m_Arity,
+                       root + lastLevel + parent, 0,
+                       m_MasterCount + parent * m_Arity, 1});
+  }
+
+  auto writeRouting(OutputFile &file) const -> void {
+    file.write("\"provider\": \"tree\", \"masters\": ");
+    file.write(m_MasterCount);
+    file.write(", \"arity\": ");
+    file.write(m_Arity);
+    file.write(", \"depth\": ");
+    file.write(std::uint64_t{m_Depth});
+  }
+};
+
+/// \class FatTreeTopology
+///
+/// \brief Generates a k-ary fat-tree topology with the numbering of
+///        `FatTree`.
+class FatTreeTopology final {
+  tw_lpid m_MasterCount;
+  tw_lpid m_K;
+  tw_lpid m_Half;
+  tw_lpid m_HostCount;
+
+public:
+  const FatTree m_Provider;
+
+  FatTreeTopology(const tw_lpid masterCount, const tw_lpid k)
+      : m_MasterCount(masterCount), m_K(k), m_Half(k / 2),
+        m_HostCount(k * k * k / 4), m_Provider(masterCount, k) {}
+
+  [[nodiscard]] auto getLayout() const noexcept -> Layout {
+    return {m_MasterCount, m_MasterCount, m_HostCount - m_MasterCount,
+            m_HostCount, 2 * m_K * m_Half + m_Half * m_Half};
+  }
+
+  template <typename Function>
+  auto forEachLinkRun(Function &&function) const -> void {
+    const tw_lpid h = m_Half;
+    const tw_lpid hosts = m_HostCount;
+    const tw_lpid edges = hosts;
+    const tw_lpid aggs = edges + m_K * h;
+    const tw_lpid cores = aggs + m_K * h;
+    const tw_lpid links = cores + h * h;
+
+    /// The host links of each edge switch.
+    for (tw_lpid edge = 0; edge < m_K * h; edge++) {
+      function(LinkRun{links + edge * h, h, edge * h, 1, edges + edge, 0});
+      function(LinkRun{links + hosts + edge * h, h, edges + edge, 0, edge * h,
+                       1});
+    }
+
+    for (tw_lpid pod = 0; pod < m_K; pod++) {
+      for (tw_lpid i = 0; i < h; i++) {
+        const tw_lpid row = pod * h + i;
+
+        /// The links from the i-th edge switch of the pod to its
+        /// aggregation switches, and from the i-th aggregation switch of the
+        /// pod to its edge switches and to its core switches.
+        function(LinkRun{links + 2 * hosts + row * h, h, edges + row, 0,
+                         aggs + pod * h, 1});
+        function(LinkRun{links + 3 * hosts + row * h, h, aggs + row, 0,
+                         edges + pod * h, 1});
+        function(LinkRun{links + 4 * hosts + row * h, h, aggs + row, 0,
+                         cores + i * h, 1});
+      }
+    }
+
+    /// The links from each core switch to the aggregation switch of its
+    /// group in every pod.
+    for (tw_lpid core = 0; core < h * h; core++)
+      function(LinkRun{links + 5 * hosts + core * m_K, m_K, cores + core, 0,
+                       aggs + core / h, h});
+  }
+
+  auto writeRouting(OutputFile &file) const -> void {
+    file.write("\"provider\": \"fat_tree\", \"masters\": ");
+    file.write(m_MasterCount);
+    file.write(", \"k\": ");
+    file.write(m_K);
+  }
+};
+
+/// \class TorusTopology
+///
+/// \brief Generates a multidimensional torus topology with the numbering of
+///        `Torus`.
+class TorusTopology final {
+  tw_lpid m_MasterCount;
+  std::vector<tw_lpid> m_Sizes;
+  tw_lpid m_SwitchCount;
+
+public:
+  const Torus m_Provider;
+
+  TorusTopology(const tw_lpid masterCount, const std::vector<tw_lpid> &sizes)
+      : m_MasterCount(masterCount), m_Sizes(sizes),
+        m_Provider(masterCount, sizes) {
+    m_SwitchCount = 1;
+    for (const tw_lpid size : m_Sizes)
+      m_SwitchCount *= size;
+  }
+
+  [[nodiscard]] auto getLayout() const noexcept -> Layout {
+    return {m_MasterCount, m_MasterCount, m_SwitchCount - m_MasterCount,
+            m_SwitchCount, m_SwitchCount};
+  }
+
+  template <typename Function>
+  auto forEachLinkRun(Function &&function) const -> void {
+    const tw_lpid n = m_SwitchCount;
+    const tw_lpid dimensions = m_Sizes.size();
+
+    function(LinkRun{2 * n, n, 0, 1, n, 1});
+    function(LinkRun{3 * n, n, n, 1, 0, 1});
+
+    /// The ring links of a switch have consecutive identifiers, but their
+    /// ends do not advance by a constant stride. Therefore, each ring link
+    /// is a run of its own.
+    for (tw_lpid node = 0; node < n; node++) {
+      tw_lpid stride = 1;
+
+      for (tw_lpid d = 0; d < dimensions; d++) {
+        const tw_lpid size = m_Sizes[d];
+        const tw_lpid coordinate = (node / stride) % size;
+        const tw_lpid base = node - coordinate * stride;
+        const tw_lpid next = base + (coordinate + 1) % size * stride;
+        const tw_lpid previous = base + (coordinate + size - 1) % size * stride;
+        const tw_lpid link = 4 * n + (node * dimensions + d) * 2;
+
+        function(LinkRun{link, 1, n + node, 0, n + next, 0});
+        function(LinkRun{link + 1, 1, n + node, 0, n + previous, 0});
+        stride *= size;
+      }
+    }
+  }
+
+  auto writeRouting(OutputFile &file) const -> void {
+    file.write("\"provider\": \"torus\", \"masters\": ");
+    file.write(m_MasterCount);
+    file.write(", \"dimensions\": [");
+    for (std::size_t d = 0; d < m_Sizes.size(); d++) {
+      if (d)
+        file.write(", ");
+      file.write(m_Sizes[d]);
+    }
+    file.write("]");
+  }
+};
+
+/// \brief Writes an array element on its own line, separated from the
+///        previous one, and indented as a section's element or, if nested,
+///        as a service.
+inline auto beginElement(OutputFile &file, bool &first,
+                         const bool nested = false) -> void {
+  if (!first)
+    file.write(",");
+  file.write(nested ? "\n      {" : "\n    {");
+  first = false;
+}
+
+/// \brief Writes the elements of the specified range of services, either one
+///        by one or as a single range.
+auto writeServices(OutputFile &file, const tw_lpid firstId,
+                   const tw_lpid count, const std::string_view attributes,
+                   const bool ranges) -> void {
+  bool first = true;
+
+  for (tw_lpid i = 0; i < count; i += ranges ? count : 1) {
+    beginElement(file, first, true);
+    file.write("\"id\": ");
+    file.write(firstId + i);
+    if (ranges && count > 1) {
+      file.write(", \"count\": ");
+      file.write(count);
+    }
+    file.write(", ");
+    file.write(attributes);
+    file.write("}");
+  }
+}
+
+/// \brief Writes the model specification of the topology.
+template <typename Topology>
+auto writeModel(const Topology &topology, const Options &options,
+                const std::filesystem::path &path) -> std::uint64_t {
+  const Layout layout = topology.getLayout();
+  OutputFile file(path);
+  bool first = true;
+
+  file.write("{\n  \"users\": [");
+  for (std::uint64_t user = 0; user < options.m_UserCount; user++) {
+    beginElement(file, first);
+    file.write("\"name\": \"user");
+    file.write(user);
+    file.write("\", ");
+    file.write(g_UserAttributes);
+    file.write("}");
+  }
+
+  /// Every master has a single workload, which is owned by the users in
+  /// turns.
+  file.write("\n  ],\n  \"workloads\": [");
+  first = true;
+  for (tw_lpid master = 0; master < layout.m_MasterCount; master++) {
+    beginElement(file, first);
+    file.write("\"owner\": \"user");
+    file.write(master % options.m_UserCount);
+    file.write("\", \"remaining_tasks\": ");
+    file.write(options.m_TaskCount);
+    file.write(", \"master_id\": ");
+    file.write(master);
+    file.write(", ");
+    file.write(g_WorkloadAttributes);
+    file.write("}");
+  }
+
+  file.write("\n  ],\n  \"services\": {\n    \"masters\": [");
+  first = true;
+  for (tw_lpid master = 0; master < layout.m_MasterCount; master++) {
+    beginElement(file, first, true);
+    file.write("\"id\": ");
+    file.write(master);
+    file.write(", \"scheduler\": \"RoundRobin\", \"route_selection\": \"");
+    file.write(options.m_RouteSelection);
+    file.write("\", \"slaves\": [");
+
+    if (options.m_Ranges) {
+      file.write("{\"first\": ");
+      file.write(layout.m_FirstMachine);
+      file.write(", \"count\": ");
+      file.write(layout.m_MachineCount);
+      file.write("}");
+    } else {
+      for (tw_lpid i = 0; i < layout.m_MachineCount; i++) {
+        if (i)
+          file.write(", ");
+        file.write(layout.m_FirstMachine + i);
+      }
+    }
+    file.write("]}");
+  }
+
+  file.write("\n    ],\n    \"machines\": [");
+  writeServices(file, layout.m_FirstMachine, layout.m_MachineCount,
+                g_MachineAttributes, options.m_Ranges);
+
+  file.write("\n    ],\n    \"links\": [");
+  first = true;
+  topology.forEachLinkRun([&](const LinkRun &run) {
+    const tw_lpid step = options.m_Ranges ? run.m_Count : 1;
+
+    for (tw_lpid i = 0; i < run.m_Count; i += step) {
+      beginElement(file, first, true);
+      file.write("\"id\": ");
+      file.write(run.m_Id + i);
+      file.write(", \"from\": ");
+      file.write(run.m_From + i * run.m_FromStride);
+      file.write(", \"to\": ");
+      file.write(run.m_To + i * run.m_ToStride);
+      if (step > 1) {
+        file.write(", \"count\": ");
+        file.write(run.m_Count);
+        file.write(", \"from_stride\": ");
+        file.write(run.m_FromStride);
+        file.write(", \"to_stride\": ");
+        file.write(run.m_ToStride);
+      }
+      file.write(", ");
+      file.write(g_LinkAttributes);
+      file.write("}");
+    }
+  });
+
+  file.write("\n    ],\n    \"switches\": [");
+  writeServices(file, layout.m_FirstSwitch, layout.m_SwitchCount,
+                g_SwitchAttributes, options.m_Ranges);
+
+  file.write("\n    ]\n  },\n  \"routing\": {");
+  if (options.m_Routes == RouteOutput::IMPLICIT)
+    topology.writeRouting(file);
+  else
+    file.write("\"provider\": \"table\"");
+  file.write("}\n}\n");
+
+  return file.close();
+}
+
+/// \brief Calls the function with the number of routes from each master to
+///        each of its slaves, in the order of the route file.
+template <typename Topology, typename Function>
+auto forEachPair(const Topology &topology, Function &&function) -> void {
+  const Layout layout = topology.getLayout();
+
+  for (tw_lpid src = 0; src < layout.m_MasterCount; src++)
+    for (tw_lpid dest = layout.m_FirstMachine;
+         dest < layout.m_FirstMachine + layout.m_MachineCount; dest++)
+      function(src, dest,
+               topology.m_Provider.countAlternatives(src, dest));
+}
+
+/// \brief Writes the routes of the topology as a textual route file, with
+///        a line for each alternative route of each pair.
+template <typename Topology>
+auto writeTextRoutes(const Topology &topology,
+                     const std::filesystem::path &path) -> std::uint64_t {
+  const auto &provider = topology.m_Provider;
+  OutputFile file(path);
+
+  forEachPair(topology, [&](const tw_lpid src, const tw_lpid dest,
+                            const std::uint64_t alternatives) {
+    for (std::uint64_t alternative = 0; alternative < alternatives;
+         alternative++) {
+      const std::size_t length = provider.getPathLength(src, dest, alternative);
+
+      file.write(src);
+      file.write(" ");
+      file.write(dest);
+      for (std::size_t i = 0; i < length; i++) {
+        file.write(" ");
+        file.write(provider.getPathHop(src, dest, alternative, i));
+      }
+      file.write("\n");
+    }
+  });
+
+  return file.close();
+}
+
+/// \brief Writes the routes of the topology as a compiled route file (see
+///        `RouteFileHeader`).
+///
+/// The sections are written one after the other, each by a pass over the
+/// routes, such that no section is ever held in memory.
+template <typename Topology>
+auto writeCompiledRoutes(const Topology &topology,
+                         const std::filesystem::path &path) -> std::uint64_t {
+  const auto &provider = topology.m_Provider;
+  const Layout layout = topology.getLayout();
+  std::vector<std::uint64_t> sourcePairs(layout.m_MasterCount);
+  ispd::routing::RouteFileHeader header = {};
+
+  std::memcpy(header.m_Magic, ispd::routing::g_RouteFileMagic,
+              sizeof(header.m_Magic));
+  header.m_Version = ispd::routing::g_RouteFileVersion;
+  header.m_HopWidth = sizeof(tw_lpid);
+  header.m_ByteOrder = ispd::routing::g_RouteFileByteOrderMark;
+
+  /// Count the pairs of each source, the routes and the hops.
+  forEachPair(topology, [&](const tw_lpid src, const tw_lpid dest,
+                            const std::uint64_t alternatives) {
+    if (alternatives == 0)
+      return;
+
+    sourcePairs[src]++;
+    header.m_PairCount++;
+    header.m_RouteCount += alternatives;
+    for (std::uint64_t alternative = 0; alternative < alternatives;
+         alternative++)
+      header.m_HopCount += provider.getPathLength(src, dest, alternative);
+  });
+
+  for (const std::uint64_t pairs : sourcePairs)
+    header.m_SourceCount += pairs > 0;
+
+  OutputFile file(path);
+  std::uint64_t offset = 0;
+
+  file.writeBytes(&header, sizeof(header));
+
+  for (tw_lpid src = 0; src < layout.m_MasterCount; src++)
+    if (sourcePairs[src])
+      file.writeWord(src);
+
+  file.writeWord(0);
+  for (const std::uint64_t pairs : sourcePairs) {
+    if (!pairs)
+      continue;
+    offset += pairs;
+    file.writeWord(offset);
+  }
+
+  forEachPair(topology, [&](const tw_lpid src, const tw_lpid dest,
+                            const std::uint64_t alternatives) {
+    if (alternatives)
+      file.writeWord(dest);
+  });
+
+  offset = 0;
+  file.writeWord(0);
+  forEachPair(topology, [&](const tw_lpid src, const tw_lpid dest,
+                            const std::uint64_t alternatives) {
+    if (!alternatives)
+      return;
+    offset += alternatives;
+    file.writeWord(offset);
+  });
+
+  offset = 0;
+  file.writeWord(0);
+  forEachPair(topology, [&](const tw_lpid src, const tw_lpid dest,
+                            const std::uint64_t alternatives) {
+    for (std::uint64_t alternative = 0; alternative < alternatives;
+         alternative++) {
+      offset += provider.getPathLength(src, dest, alternative);
+      file.writeWord(offset);
+    }
+  });
+
+  forEachPair(topology, [&](const tw_lpid src, const tw_lpid dest,
+                            const std::uint64_t alternatives) {
+    for (std::uint64_t alternative = 0; alternative < alternatives;
+         alternative++) {
+      const std::size_t length = provider.getPathLength(src, dest, alternative);
+
+      for (std::size_t i = 0; i < length; i++)
+        file.writeWord(provider.getPathHop(src, dest, alternative, i));
+    }
+  });
+
+  const std::uint64_t written = file.close();
+
+  /// Check if the sections do not match the header, in which case the
+  /// routing table would refuse the file.
+  if (written != header.getFileSize())
+    ispd_error("Compiled route file %s has %lu bytes, but its header "
+               "describes %lu bytes.",
+               path.c_str(), written, header.getFileSize());
+  return written;
+}
+
+/// \brief Generates the model and the routes of the topology.
+template <typename Topology>
+auto generate(const Topology &topology, const Options &options) -> void {
+  const Layout layout = topology.getLayout();
+  const tw_lpid serviceCount = topology.m_Provider.getVertexCount();
+  tw_lpid linkCount = 0;
+
+  topology.forEachLinkRun(
+      [&linkCount](const LinkRun &run) { linkCount += run.m_Count; });
+
+  /// Checks if the generated services do not match the provider's
+  /// numbering. If so, the program is immediately aborted.
+  if (layout.m_MasterCount + layout.m_MachineCount + layout.m_SwitchCount +
+          linkCount !=
+      serviceCount)
+    ispd_error("The generated services do not match the topology's %lu "
+               "services.",
+               serviceCount);
+
+  const auto start = std::chrono::steady_clock::now();
+  const std::filesystem::path modelPath = options.m_Output / "model.json";
+  const std::filesystem::path routesPath = options.m_Output / "routes.route";
+  const std::uint64_t modelBytes = writeModel(topology, options, modelPath);
+  std::uint64_t routeBytes = 0;
+
+  if (options.m_Routes == RouteOutput::TEXT)
+    routeBytes = writeTextRoutes(topology, routesPath);
+  else if (options.m_Routes == RouteOutput::COMPILED)
+    routeBytes = writeCompiledRoutes(topology, routesPath);
+
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+
+  ispd_info("Model %s has been generated (Services: %lu, Masters: %lu, "
+            "Machines: %lu, Switches: %lu, Links: %lu, Bytes: %lu).",
+            modelPath.c_str(), serviceCount, layout.m_MasterCount,
+            layout.m_MachineCount, layout.m_SwitchCount, linkCount,
+            modelBytes);
+
+  if (routeBytes) {
+    ispd_info("Route file %s has been generated (Bytes: %lu).",
+              routesPath.c_str(), routeBytes);
+  } else if (options.m_Routes == RouteOutput::LINKS) {
+    ispd_info("No route file has been generated, the simulator must be run "
+              "with --compute-routes.");
+  }
+
+  ispd_info("The generation has taken %lf seconds (%.1lf MiB/s).", seconds,
+            (modelBytes + routeBytes) / seconds / (1024.0 * 1024.0));
+}
+
+[[noreturn]] auto usage(const char *const program) -> void {
+  std::fprintf(
+      stderr,
+      "Usage: %s [options] <topology> <arguments...>\n"
+      "\n"
+      "Topologies:\n"
+      "  star <masters> <machines>\n"
+      "  tree <masters> <arity> <depth>\n"
+      "  fat_tree <masters> <k>\n"
+      "  torus <masters> <size>[x<size>...]\n"
+      "\n"
+      "Options:\n"
+      "  --routes <text|compiled|implicit|links>  (default: compiled)\n"
+      "  --ranges                                 Declare services as ranges\n"
+      "  --users <count>                          (default: 1)\n"
+      "  --tasks <count>                          (default: 100)\n"
+      "  --route-selection <policy>               (default: First)\n"
+      "  --output <directory>                     (default: .)\n",
+      program);
+  std::exit(1);
+}
+
+/// \brief Parses the number, which must fill the whole argument.
+auto parseNumber(const char *const program, const std::string_view argument)
+    -> std::uint64_t {
+  std::uint64_t value = 0;
+  const auto [next, ec] = std::from_chars(
+      argument.data(), argument.data() + argument.size(), value);
+
+  if (ec != std::errc() || next != argument.data() + argument.size())
+    usage(program);
+  return value;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ispd::log::setOutputFile(nullptr);
+
+  Options options;
+  std::vector<std::string_view> arguments;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string_view argument = argv[i];
+
+    if (argument == "--ranges") {
+      options.m_Ranges = true;
+      continue;
+    }
+
+    if (argument.substr(0, 2) != "--") {
+      arguments.push_back(argument);
+      continue;
+    }
+
+    /// Every other option has a value.
+    if (i + 1 == argc)
+      usage(argv[0]);
+
+    const std::string_view value = argv[++i];
+
+    if (argument == "--routes") {
+      if (value == "text")
+        options.m_Routes = RouteOutput::TEXT;
+      else if (value == "compiled")
+        options.m_Routes = RouteOutput::COMPILED;
+      else if (value == "implicit")
+        options.m_Routes = RouteOutput::IMPLICIT;
+      else if (value == "links")
+        options.m_Routes = RouteOutput::LINKS;
+      else
+        usage(argv[0]);
+    } else if (argument == "--users") {
+      options.m_UserCount = parseNumber(argv[0], value);
+    } else if (argument == "--tasks") {
+      options.m_TaskCount = parseNumber(argv[0], value);
+    } else if (argument == "--route-selection") {
+      options.m_RouteSelection = value;
+    } else if (argument == "--output") {
+      options.m_Output = value;
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if (arguments.size() < 3 || options.m_UserCount == 0)
+    usage(argv[0]);
+
+  const std::string_view topology = arguments[0];
+  const tw_lpid masterCount = parseNumber(argv[0], arguments[1]);
+
+  /// Checks if there is no master, since every master is the source of the
+  /// routes and the model must have at least one workload.
+  if (masterCount == 0)
+    ispd_error("The topology must have at least one master.");
+
+  if (topology == "star" && arguments.size() == 3) {
+    generate(StarTopology(masterCount, parseNumber(argv[0], arguments[2])),
+             options);
+  } else if (topology == "tree" && arguments.size() == 4) {
+    generate(TreeTopology(masterCount, parseNumber(argv[0], arguments[2]),
+                          parseNumber(argv[0], arguments[3])),
+             options);
+  } else if (topology == "fat_tree" && arguments.size() == 3) {
+    generate(FatTreeTopology(masterCount, parseNumber(argv[0], arguments[2])),
+             options);
+  } else if (topology == "torus" && arguments.size() == 3) {
+    std::vector<tw_lpid> sizes;
+    std::string_view dimensions = arguments[2];
+
+    for (;;) {
+      const std::size_t separator = dimensions.find('x');
+
+      sizes.push_back(parseNumber(argv[0], dimensions.substr(0, separator)));
+      if (separator == std::string_view::npos)
+        break;
+      dimensions.remove_prefix(separator + 1);
+    }
+
+    generate(TorusTopology(masterCount, sizes), options);
+  } else {
+    usage(argv[0]);
+  }
+
+  return 0;
+}
@@ -0,0 +1,330 @@
+#include <ross.h>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <ispd/log/log.hpp>
+#include <ispd/model/builder.hpp>
+#include <ispd/routing/routing.hpp>
+#include <ispd/workload/workload.hpp>
+#include <ispd/model_loader/model_loader.hpp>
+#include <ispd/model_checker/model_checker.hpp>
+
+using ispd::model_loader::LogicalProcessType;
+
+namespace ispd::model_checker {
+
+namespace {
+
+/// \brief The maximum number of violations that are listed. The remaining
+///        ones are only counted.
+constexpr std::size_t g_MaxListedViolations = 64;
+
+/// \brief The minimum number of items checked by each thread, such that
+///        small models are not split into useless shares.
+constexpr std::size_t g_MinItemsPerThread = 4096;
+
+/// \struct Violations
+///
+/// \brief The consistency violations found by a single thread.
+struct Violations final {
+  std::vector<std::string> m_Listed; ///< The first violations' descriptions.
+  std::uint64_t m_Count = 0;         ///< The number of violations found.
+
+  /// \brief Records a violation with the specified printf-like description.
+  template <typename... Args>
+  auto add(const char *const format, const Args... args) -> void {
+    if (m_Count++ >= g_MaxListedViolations)
+      return;
+
+    char description[512];
+
+    std::snprintf(description, sizeof(description), format, args...);
+    m_Listed.emplace_back(description);
+  }
+};
+
+/// \brief Returns the model identifier of the specified service, with which
+///        the violations are reported.
+auto id(const tw_lpid gid) -> std::string {
+  return ispd::model_loader::getServiceIdentifier(gid);
+}
+
+/// \brief Returns true if the specified service has been registered with the
+///        specified type.
+auto isOfType(const tw_lpid gid, const LogicalProcessType type) noexcept
+    -> bool {
+  return gid < ispd::model_loader::getServicesSize() &&
+         ispd::model_loader::getLogicalProcessType(gid) == type;
+}
+
+/// \brief Checks the items `[0, itemCount)` in parallel.
+///
+/// The items are split into contiguous shares, one per thread, and each share
+/// is checked by `check(first, last, violations)`. The first share is checked
+/// by the calling thread. The violations of each thread are appended, in the
+/// items' order, to the specified violations.
+template <typename Check>
+auto checkInParallel(const std::size_t itemCount, unsigned threadCount,
+                     const Check &check, std::vector<Violations> &violations)
+    -> void {
+  if (threadCount == 0)
+    threadCount = std::max(1U, std::thread::hardware_concurrency());
+  threadCount = static_cast<unsigned>(std::max<std::size_t>(
+      1, std::min<std::size_t>(threadCount, itemCount / g_MinItemsPerThread)));
+
+  std::vector<Violations> shares(threadCount);
+
+  const auto checkShare = [&](const unsigned i) {
+    check(itemCount * i / threadCount, itemCount * (i + 1) / threadCount,
+          shares[i]);
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount - 1);
+
+  for (unsigned i = 1; i < threadCount; i++)
+    workers.emplace_back(checkShare, i);
+  checkShare(0);
+
+  for (auto &worker : workers)
+    worker.join();
+
+  for (auto &share : shares)
+    violations.push_back(std::move(share));
+}
+
+/// \brief Calls `visit(masterRow, slave)` for every slave in
+///        `[first, last)` of the masters' pooled slaves.
+template <typename Visit>
+auto forEachSlave(const ispd::model::MasterTable &masters,
+                  const std::size_t first, const std::size_t last,
+                  const Visit &visit) -> void {
+  if (first >= last)
+    return;
+
+  /// Find the master owning the first slave of the share. The masters with no
+  /// slaves are skipped, since their slave ranges are empty.
+  std::size_t row = static_cast<std::size_t>(
+      std::upper_bound(masters.m_SlaveOffsets.cbegin(),
+                       masters.m_SlaveOffsets.cend(), first) -
+      masters.m_SlaveOffsets.cbegin() - 1);
+
+  for (std::size_t i = first; i < last; i++) {
+    while (i >= masters.m_SlaveOffsets[row + 1])
+      row++;
+    visit(row, masters.m_Slaves[i]);
+  }
+}
+
+/// \brief Lists the specified violations and, if any has been found, aborts
+///        the program.
+auto report(const char *const subject,
+            const std::vector<Violations> &violations) noexcept -> void {
+  std::uint64_t count = 0;
+  std::size_t listed = 0;
+
+  for (const auto &share : violations) {
+    count += share.m_Count;
+
+    for (const auto &description : share.m_Listed) {
+      if (listed < g_MaxListedViolations) {
+        ispd_info("%s", description.c_str());
+        listed++;
+      }
+    }
+  }
+
+  if (count == 0)
+    return;
+
+  if (count > listed)
+    ispd_info("... and %lu more violations.", count - listed);
+  ispd_error("The %s have %lu consistency violations at node %lu, exiting...",
+             subject, count, g_tw_mynode);
+}
+
+}; // namespace
+
+auto checkModel(const unsigned threadCount) noexcept -> void {
+  const auto &links = ispd::this_model::getLinks();
+  const auto &masters = ispd::this_model::getMasters();
+  std::vector<Violations> violations;
+
+  /// Check the links' ends. A link must connect two distinct services, which
+  /// must be masters, machines or switches.
+  const auto checkLinks = [&links](const std::size_t first,
+                                   const std::size_t last,
+                                   Violations &found) {
+    const auto isEnd = [](const tw_lpid gid) {
+      return isOfType(gid, LogicalProcessType::MASTER) ||
+             isOfType(gid, LogicalProcessType::MACHINE) ||
+             isOfType(gid, LogicalProcessType::SWITCH);
+    };
+
+    for (std::size_t row = first; row < last; row++) {
+      const tw_lpid gid = links.m_Gid[row];
+      const tw_lpid from = links.m_From[row];
+      const tw_lpid to = links.m_To[row];
+
+      if (!isEnd(from))
+        found.add("Link %s leaves %s, which is not a registered master, "
+                  "machine or switch.",
+                  id(gid).c_str(), id(from).c_str());
+      if (!isEnd(to))
+        found.add("Link %s arrives at %s, which is not a registered master, "
+                  "machine or switch.",
+                  id(gid).c_str(), id(to).c_str());
+      if (from == to)
+        found.add("Link %s leaves and arrives at the same service %s.",
+                  id(gid).c_str(), id(from).c_str());
+    }
+  };
+
+  checkInParallel(links.size(), threadCount, checkLinks, violations);
+
+  /// Check the masters' components. The components are only checked for the
+  /// materialized masters, which are the ones with a scheduler.
+  const auto userCount = ispd::this_model::getUsers().size();
+  Violations &found = violations.emplace_back();
+
+  for (std::size_t row = 0; row < masters.size(); row++) {
+    const tw_lpid gid = masters.m_Gid[row];
+
+    if (masters.m_SlaveOffsets[row] == masters.m_SlaveOffsets[row + 1])
+      found.add("Master %s has no slaves.", id(gid).c_str());
+
+    if (!masters.m_Scheduler[row])
+      continue;
+
+    if (!masters.m_RouteSelector[row])
+      found.add("Master %s has no route selector.", id(gid).c_str());
+
+    const auto *const workload = masters.m_Workload[row];
+
+    if (!workload)
+      found.add("Master %s has no workload.", id(gid).c_str());
+    else if (workload->getOwner() >= userCount)
+      found.add("The workload of master %s is owned by an unregistered user "
+                "(%u).",
+                id(gid).c_str(), static_cast<unsigned>(workload->getOwner()));
+  }
+
+  for (const auto &[masterId, workload] : ispd::model_loader::getWorkloads())
+    if (!isOfType(masterId, LogicalProcessType::MASTER))
+      found.add("A workload has been assigned to %s, which is not a "
+                "registered master.",
+                id(masterId).c_str());
+
+  /// Check the masters' slaves, which are split by slave instead of by
+  /// master, since a single master may have most of the model's machines as
+  /// its slaves.
+  const auto checkSlaves = [&masters](const std::size_t first,
+                                      const std::size_t last,
+                                      Violations &found) {
+    forEachSlave(masters, first, last,
+                 [&masters, &found](const std::size_t row, const tw_lpid slave) {
+                   if (!isOfType(slave, LogicalProcessType::MACHINE))
+                     found.add("Master %s has %s as a slave, which is not a "
+                               "registered machine.",
+                               id(masters.m_Gid[row]).c_str(),
+                               id(slave).c_str());
+                 });
+  };
+
+  checkInParallel(masters.m_Slaves.size(), threadCount, checkSlaves,
+                  violations);
+
+  report("model's services", violations);
+}
+
+auto checkRoutes(const unsigned threadCount,
+                 const ispd::routing::VertexPredicate &isLocal) noexcept
+    -> void {
+  const auto &links = ispd::this_model::getLinks();
+  const auto &masters = ispd::this_model::getMasters();
+  const auto &provider = ispd::routing_table::getProvider();
+  std::vector<Violations> violations;
+
+  /// Only the switches and the machines forward the tasks.
+  const auto isForwarding = [](const tw_lpid gid) {
+    return isOfType(gid, LogicalProcessType::SWITCH) ||
+           isOfType(gid, LogicalProcessType::MACHINE);
+  };
+
+  /// Check the routes from each master to each of its slaves.
+  const auto checkRoute = [&](const std::size_t row, const tw_lpid slave,
+                              Violations &found) {
+    const tw_lpid master = masters.m_Gid[row];
+
+    if (isLocal && !isLocal(master))
+      return;
+
+    if (!provider.hasRoute(master, slave)) {
+      found.add("There is no route from master %s to its slave %s.",
+                id(master).c_str(), id(slave).c_str());
+      return;
+    }
+
+    const auto routes = provider.getRoutes(master, slave);
+
+    for (std::size_t k = 0; k < routes.size(); k++) {
+      const auto route = routes[k];
+      const std::size_t length = route.getLength();
+
+      /// Follow the route's links, tracking the service at which the
+      /// previous link has arrived.
+      tw_lpid at = master;
+      bool broken = false;
+
+      for (std::size_t i = 0; i < length && !broken; i++) {
+        const tw_lpid hop = route.get(i);
+        const auto linkRow = ispd::this_model::findLink(hop);
+
+        if (linkRow == ispd::model::g_NoServiceRow) {
+          found.add("Hop %zu of route %zu from %s to %s is %s, which is not "
+                    "a registered link.",
+                    i, k, id(master).c_str(), id(slave).c_str(),
+                    id(hop).c_str());
+          broken = true;
+        } else if (links.m_From[linkRow] != at) {
+          found.add("Hop %zu of route %zu from %s to %s is link %s, which "
+                    "does not leave %s.",
+                    i, k, id(master).c_str(), id(slave).c_str(),
+                    id(hop).c_str(), id(at).c_str());
+          broken = true;
+        } else {
+          at = links.m_To[linkRow];
+
+          if (i + 1 < length && !isForwarding(at)) {
+            found.add("Hop %zu of route %zu from %s to %s arrives at %s, "
+                      "which is neither a switch nor a machine.",
+                      i, k, id(master).c_str(), id(slave).c_str(),
+                      id(at).c_str());
+            broken = true;
+          }
+        }
+      }
+
+      if (!broken && at != slave)
+        found.add("Route %zu from %s to %s ends at %s.", k,
+                  id(master).c_str(), id(slave).c_str(), id(at).c_str());
+    }
+  };
+
+  const auto checkSlaves = [&](const std::size_t first,
+                               const std::size_t last, Violations &found) {
+    forEachSlave(masters, first, last,
+                 [&](const std::size_t row, const tw_lpid slave) {
+                   checkRoute(row, slave, found);
+                 });
+  };
+
+  checkInParallel(masters.m_Slaves.size(), threadCount, checkSlaves,
+                  violations);
+
+  report("routes", violations);
+}
+
+}; // namespace ispd::model_checker
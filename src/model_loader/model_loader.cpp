@@ -1,16 +1,32 @@
 #include <ross.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <limits>
 #include <memory>
 #include <vector>
-#include <fstream>
+#include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
 #include <ispd/log/log.hpp>
 #include <lib/nlohmann/json.hpp>
 #include <ispd/model/builder.hpp>
 #include <ispd/workload/workload.hpp>
 #include <ispd/scheduler/scheduler.hpp>
 #include <ispd/scheduler/round_robin.hpp>
+#include <ispd/route_selector/first.hpp>
+#include <ispd/route_selector/ecmp.hpp>
+#include <ispd/route_selector/round_robin.hpp>
+#include <ispd/route_selector/least_waited.hpp>
+#include <ispd/routing/routing.hpp>
+#include <ispd/routing_provider/star.hpp>
+#include <ispd/routing_provider/tree.hpp>
+#include <ispd/routing_provider/fat_tree.hpp>
+#include <ispd/routing_provider/torus.hpp>
 #include <ispd/workload/interarrival.hpp>
 #include <ispd/model_loader/model_loader.hpp>
+#include <ispd/model_loader/snapshot.hpp>
 
 /// \brief User - Keys.
 #define MODEL_USERS_SECTION ("users")
@@ -46,6 +62,15 @@
 #define MODEL_SERVICE_MASTER_ID_KEY ("id")
 #define MODEL_SERVICE_MASTER_SCHEDULER_KEY ("scheduler")
 #define MODEL_SERVICE_MASTER_SLAVES_KEY ("slaves")
+#define MODEL_SERVICE_MASTER_ROUTESELECTION_KEY ("route_selection")
+#define MODEL_SERVICE_MASTER_SLAVES_FIRST_KEY ("first")
+#define MODEL_SERVICE_MASTER_SLAVES_COUNT_KEY ("count")
+
+/// \brief The number of identical services declared by a single machine,
+///        link or switch element, whose global identifiers are consecutive,
+///        starting at the element's `id`. If it is absent, a single service is
+///        declared.
+#define MODEL_SERVICE_COUNT_KEY ("count")
 
 #define MODEL_SERVICE_MACHINE_ID_KEY ("id")
 #define MODEL_SERVICE_MACHINE_POWER_KEY ("power")
@@ -65,109 +90,467 @@
 #define MODEL_SERVICE_LINK_LOAD_KEY ("load")
 #define MODEL_SERVICE_LINK_LATENCY_KEY ("latency")
 
+/// \brief The increments of the ends from a link to the next one in a range of
+///        links. If they are absent, every link in the range has the same end.
+#define MODEL_SERVICE_LINK_FROMSTRIDE_KEY ("from_stride")
+#define MODEL_SERVICE_LINK_TOSTRIDE_KEY ("to_stride")
+
 #define MODEL_SERVICE_SWITCH_ID_KEY ("id")
 #define MODEL_SERVICE_SWITCH_BANDWIDTH_KEY ("bandwidth")
 #define MODEL_SERVICE_SWITCH_LOAD_KEY ("load")
 #define MODEL_SERVICE_SWITCH_LATENCY_KEY ("latency")
 
+/// \brief Routing - Keys.
+#define MODEL_ROUTING_SECTION ("routing")
+#define MODEL_ROUTING_PROVIDER_KEY ("provider")
+#define MODEL_ROUTING_MASTERS_KEY ("masters")
+#define MODEL_ROUTING_STAR_MACHINES_KEY ("machines")
+#define MODEL_ROUTING_TREE_ARITY_KEY ("arity")
+#define MODEL_ROUTING_TREE_DEPTH_KEY ("depth")
+#define MODEL_ROUTING_FATTREE_K_KEY ("k")
+#define MODEL_ROUTING_TORUS_DIMENSIONS_KEY ("dimensions")
+
 using json = nlohmann::json;
 
 namespace ispd::model_loader {
 
 std::unordered_map<tw_lpid, ispd::workload::Workload *> g_ModelLoader_Workloads;
 
+/// \brief The masters to which a workload has been loaded from the model
+///        specification, which are known even if the workloads have not been
+///        materialized.
+static std::unordered_set<tw_lpid> g_ModelLoader_WorkloadMasters;
+
 /// \brief Global Identifier to Logical Process Type Mapping.
 ///
-/// This unordered map is designed to store the mapping between global logical
-/// process identifiers and their corresponding logical process types. In a
-/// discrete-event simulation, each logical process has a unique global
-/// identifier (tw_lpid), and associating it with a logical process type
-/// provides information about its role or purpose within the simulation.
+/// This array stores the logical process type of each service, indexed by
+/// its global identifier, such that the type of every logical process is
+/// fetched by a single load while the logical processes are set up. The
+/// global identifiers that have not been registered are marked by
+/// `g_NoLogicalProcessType`.
 ///
 /// \see tw_lpid
 /// \see LogicalProcessType
-///
-/// \note The usage of an unordered map allows for efficient retrieval of
-///       logical process types based on their global identifiers.
-///
-/// \note This global map is typically utilized during the simulation setup
-///       phase to establish the characteristics of each logical process.
-std::unordered_map<tw_lpid, LogicalProcessType> g_GidToType;
+static std::vector<std::uint8_t> g_GidToType;
+
+/// \brief The marker of the unregistered global identifiers.
+static constexpr std::uint8_t g_NoLogicalProcessType = 0xFF;
+
+/// \brief The number of global identifiers that have been registered.
+static std::size_t g_RegisteredServiceCount = 0;
+
+/// \brief If set, the services' model identifiers are remapped to dense
+///        global identifiers (see `enableIdentifierRemapping`).
+static bool g_RemapIdentifiers = false;
+
+/// \brief The model identifier of each remapped global identifier.
+static std::vector<std::string> g_Identifiers;
+
+/// \brief The global identifier assigned to each model identifier, which is
+///        only kept while the model specification is parsed.
+static std::unordered_map<std::string, tw_lpid> g_IdentifierToGid;
 
 static auto registerGidToType(const tw_lpid gid,
                               const LogicalProcessType type) noexcept -> void {
+  if (gid >= g_GidToType.size()) {
+    // Checks if the global identifier cannot be stored in the dense tables,
+    // which is most likely a sparse identifier.
+    if (gid >= std::numeric_limits<ispd::model::ServiceRow>::max() - 1)
+      ispd_error("The global logical process identifier %lu is too large. "
+                 "Enable the identifier remapping to use sparse identifiers.",
+                 gid);
+    g_GidToType.resize(gid + 1, g_NoLogicalProcessType);
+  }
+
   // Checks if a mapping has already been registered for the specified global
   // identifier.
-  if (g_GidToType.find(gid) != g_GidToType.cend()) [[unlikely]]
+  if (g_GidToType[gid] != g_NoLogicalProcessType) [[unlikely]]
     ispd_error("A logical process type mapping for the global logical process "
-               "identifier %lu has already been made.",
-               gid);
-  g_GidToType.emplace(gid, type);
+               "identifier %s has already been made.",
+               getServiceIdentifier(gid).c_str());
+  g_GidToType[gid] = static_cast<std::uint8_t>(type);
+  g_RegisteredServiceCount++;
+}
+
+/// \brief The snapshot of the model being loaded, which records every element
+///        as it is registered.
+static ModelSnapshot *g_Snapshot = nullptr;
+
+/// \brief The predicate of the services hosted by this node, if the model is
+///        materialized rank-locally.
+static const HostPredicate *g_IsHosted = nullptr;
+
+/// \brief The number of services in the model being materialized.
+static std::size_t g_ServiceCount = 0;
+
+/// \brief Returns true if the specified service is hosted by this node, such
+///        that its state must be materialized.
+static auto isHosted(const tw_lpid gid) -> bool {
+  return !g_IsHosted || (*g_IsHosted)(gid, g_ServiceCount);
+}
+
+/// \brief The names of the routing providers, as in the model specification.
+static const char *const g_RoutingProviderNames[] = {"star", "tree",
+                                                     "fat_tree", "torus"};
+
+static auto makeInterarrivalDist(const WorkloadRecord &record)
+    -> std::unique_ptr<ispd::workload::InterarrivalDistribution> {
+  switch (record.m_InterarrivalKind) {
+  case InterarrivalKind::POISSON:
+    return std::make_unique<ispd::workload::PoissonInterarrivalDistribution>(
+        record.m_InterarrivalMean);
+  case InterarrivalKind::FIXED:
+    return std::make_unique<ispd::workload::FixedInterarrivalDistribution>(
+        record.m_InterarrivalMean);
+  case InterarrivalKind::EXPONENTIAL:
+    return std::make_unique<
+        ispd::workload::ExponentialInterarrivalDistribution>(
+        record.m_InterarrivalMean);
+  case InterarrivalKind::WEIBULL:
+    return std::make_unique<ispd::workload::WeibullInterarrivalDistribution>(
+        record.m_InterarrivalMean, record.m_InterarrivalShape);
+  }
+  ispd_error("Unexpected interarrival distribution kind %u.",
+             static_cast<unsigned>(record.m_InterarrivalKind));
+  return nullptr;
+}
+
+static auto makeScheduler(const SchedulerKind kind)
+    -> ispd::scheduler::Scheduler * {
+  switch (kind) {
+  case SchedulerKind::ROUND_ROBIN:
+    return new ispd::scheduler::RoundRobin;
+  }
+  ispd_error("Unexpected scheduler kind %u.", static_cast<unsigned>(kind));
+  return nullptr;
+}
+
+static auto makeRouteSelector(const RouteSelectorKind kind)
+    -> ispd::route_selector::RouteSelector * {
+  switch (kind) {
+  case RouteSelectorKind::FIRST:
+    return new ispd::route_selector::First;
+  case RouteSelectorKind::ECMP:
+    return new ispd::route_selector::Ecmp;
+  case RouteSelectorKind::ROUND_ROBIN:
+    return new ispd::route_selector::RoundRobin;
+  case RouteSelectorKind::LEAST_WAITED:
+    return new ispd::route_selector::LeastWaited;
+  }
+  ispd_error("Unexpected route selector kind %u.", static_cast<unsigned>(kind));
+  return nullptr;
 }
 
-/// \brief Loads user information from a JSON data structure and registers
-///        users in the simulation model.
+/// \brief Registers the validated elements in the simulation model.
 ///
-/// This function is responsible for parsing user information from a JSON
-/// data structure and registering each user in the simulation model.
+/// These functions are called both when an element is loaded from the model
+/// specification and when it is restored from a model snapshot.
+static auto apply(const ModelSnapshot &snapshot, const UserRecord &record)
+    -> void {
+  ispd::this_model::registerUser(snapshot.getString(record.m_Name),
+                                 record.m_EnergyConsumptionLimit);
+}
+
+static auto apply(const ModelSnapshot &snapshot, const WorkloadRecord &record)
+    -> void {
+  const std::string owner = snapshot.getString(record.m_Owner);
+
+  // Checks if the workload's master is not hosted by this node. If so, the
+  // workload is not created, but its owner must still have been registered.
+  if (!isHosted(record.m_MasterId)) {
+    if (ispd::this_model::getUserByName(owner) ==
+        ispd::this_model::getUsers().cend())
+      ispd_error("Creating a workload with an unregistered user: %s.",
+                 owner.c_str());
+    return;
+  }
+
+  ispd::workload::Workload *w;
+
+  if (record.m_Kind == WorkloadKind::UNIFORM)
+    w = new ispd::workload::UniformWorkload(
+        owner, record.m_RemainingTasks, record.m_MinProcSize,
+        record.m_MaxProcSize, record.m_MinCommSize, record.m_MaxCommSize,
+        record.m_ComputingOffload, makeInterarrivalDist(record));
+  else
+    w = new ispd::workload::ConstantWorkload(
+        owner, record.m_RemainingTasks, record.m_MaxProcSize,
+        record.m_MaxCommSize, record.m_ComputingOffload,
+        makeInterarrivalDist(record));
+
+  // Register the workload in a temporary storage, because this will be
+  // fetched after to register them with the masters.
+  g_ModelLoader_Workloads.insert(std::make_pair<>(record.m_MasterId, w));
+}
+
+static auto apply(const ModelSnapshot &snapshot, const MasterRecord &record)
+    -> void {
+  registerGidToType(record.m_Id, LogicalProcessType::MASTER);
+
+  if (!isHosted(record.m_Id)) {
+    ispd::this_model::registerRemoteMaster(record.m_Id,
+                                           snapshot.getLpids(record.m_Slaves));
+    return;
+  }
+
+  ispd::this_model::registerMaster(
+      record.m_Id, snapshot.getLpids(record.m_Slaves),
+      makeScheduler(record.m_Scheduler),
+      makeRouteSelector(record.m_RouteSelector),
+      g_ModelLoader_Workloads.at(record.m_Id));
+}
+
+/// \brief Registers the range of services with the specified type.
 ///
-/// \param data The JSON data containing the model specification.
+/// The range is split into runs of consecutive hosted services, which are
+/// registered at once by `registerHosted(first, count)`, while the services
+/// that are not hosted are registered as remote services.
+template <typename RegisterHosted>
+static auto registerRange(const tw_lpid first, const tw_lpid count,
+                          const LogicalProcessType type,
+                          RegisterHosted &&registerHosted) -> void {
+  tw_lpid runFirst = first;
+
+  for (tw_lpid gid = first; gid < first + count; gid++) {
+    registerGidToType(gid, type);
+
+    if (!isHosted(gid)) {
+      if (runFirst < gid)
+        registerHosted(runFirst, gid - runFirst);
+      ispd::this_model::registerRemoteService(gid);
+      runFirst = gid + 1;
+    }
+  }
+
+  if (runFirst < first + count)
+    registerHosted(runFirst, first + count - runFirst);
+}
+
+static auto apply(const ModelSnapshot &, const MachineRecord &record)
+    -> void {
+  registerRange(record.m_Id, record.m_Count, LogicalProcessType::MACHINE,
+                [&record](const tw_lpid first, const tw_lpid count) {
+                  ispd::this_model::registerMachine(
+                      first, record.m_Power, record.m_Load,
+                      record.m_CoreCount, record.m_GpuPower,
+                      record.m_GpuCoreCount,
+                      record.m_InterconnectionBandwidth, record.m_WattageIdle,
+                      record.m_WattageMax, count);
+                });
+}
+
+static auto apply(const ModelSnapshot &, const LinkRecord &record) -> void {
+  // Every link is registered, since the routes are computed from the links.
+  for (tw_lpid i = 0; i < record.m_Count; i++) {
+    registerGidToType(record.m_Id + i, LogicalProcessType::LINK);
+    ispd::this_model::registerLink(
+        record.m_Id + i, record.m_From + i * record.m_FromStride,
+        record.m_To + i * record.m_ToStride, record.m_Bandwidth, record.m_Load,
+        record.m_Latency);
+  }
+}
+
+static auto apply(const ModelSnapshot &, const SwitchRecord &record) -> void {
+  registerRange(record.m_Id, record.m_Count, LogicalProcessType::SWITCH,
+                [&record](const tw_lpid first, const tw_lpid count) {
+                  ispd::this_model::registerSwitch(first, record.m_Bandwidth,
+                                                   record.m_Load,
+                                                   record.m_Latency, count);
+                });
+}
+
+static auto apply(const ModelSnapshot &snapshot, const RoutingRecord &record)
+    -> void {
+  const char *const provider =
+      g_RoutingProviderNames[static_cast<unsigned>(record.m_Kind)];
+  tw_lpid vertexCount;
+  const ispd::routing::RoutingProvider *p;
+
+  if (record.m_Kind == RoutingProviderKind::STAR) {
+    const auto *star = new ispd::routing_provider::Star(record.m_MasterCount,
+                                                        record.m_MachineCount);
+
+    vertexCount = star->getVertexCount();
+    p = star;
+  } else if (record.m_Kind == RoutingProviderKind::TREE) {
+    const auto *tree = new ispd::routing_provider::Tree(
+        record.m_MasterCount, record.m_Arity, record.m_Depth);
+
+    vertexCount = tree->getVertexCount();
+    p = tree;
+  } else if (record.m_Kind == RoutingProviderKind::FAT_TREE) {
+    const auto *fatTree =
+        new ispd::routing_provider::FatTree(record.m_MasterCount, record.m_K);
+
+    vertexCount = fatTree->getVertexCount();
+    p = fatTree;
+  } else {
+    const auto *torus = new ispd::routing_provider::Torus(
+        record.m_MasterCount, snapshot.getLpids(record.m_Dimensions));
+
+    vertexCount = torus->getVertexCount();
+    p = torus;
+  }
+
+  // Checks if the services' identifiers have been remapped. If so, the
+  // program is immediately aborted, since the provider relies on the
+  // services being numbered as it documents.
+  if (g_RemapIdentifiers)
+    ispd_error("The `%s` routing provider cannot be used with the identifier "
+               "remapping.",
+               provider);
+
+  // Checks if the model's services do not match the provider's topology. If
+  // so, the program is immediately aborted, since the computed routes would
+  // traverse services that do not exist.
+  if (vertexCount != g_RegisteredServiceCount)
+    ispd_error("The `%s` routing provider expects %lu services, but the model "
+               "has %lu services.",
+               provider, vertexCount, g_RegisteredServiceCount);
+
+  ispd::routing_table::setProvider(p);
+  ispd_info("Routes are served by the implicit `%s` routing provider.",
+            provider);
+}
+
+/// \brief Records the validated element in the model snapshot and registers
+///        it in the simulation model.
 ///
-/// \note The function assumes a specific structure in the JSON data, where
-///       users are listed under the "users" section. Each user is expected
-///       to have attributes like "name" (MODEL_USER_NAME_KEY) and
-///       "energy_limit_consumption" (MODEL_USER_ENERGYLIMIT_KEY).
+/// \note If the model is materialized rank-locally, the element is only
+///       registered once the whole model has been parsed, since the hosted
+///       services are only known once the number of services is known.
+template <typename Record> static auto commit(const Record &record) -> void {
+  g_Snapshot->add(record);
+
+  if (!g_IsHosted)
+    apply(*g_Snapshot, record);
+}
+
+/// \brief Returns the global identifier of the service with the specified
+///        model identifier, assigning the next dense global identifier to it
+///        if it has not been seen yet.
+static auto resolveIdentifier(std::string &&identifier) -> tw_lpid {
+  const auto [it, inserted] =
+      g_IdentifierToGid.try_emplace(std::move(identifier), g_Identifiers.size());
+
+  if (inserted) {
+    g_Identifiers.push_back(it->first);
+    g_Snapshot->addIdentifier(it->first);
+  }
+  return it->second;
+}
+
+/// \brief Returns the global identifier of the service with the specified
+///        model identifier, either declared or referenced.
+///
+/// If the identifiers are not remapped, the model identifier must be the
+/// global identifier itself. Otherwise, it may be any non-negative integer or
+/// string, and the integer and the string with the same digits identify the
+/// same service.
+static auto resolveIdentifier(const json &id) -> tw_lpid {
+  if (!id.is_number_unsigned() && !(g_RemapIdentifiers && id.is_string()))
+    ispd_error("Service identifier %s is neither a non-negative integer nor, "
+               "with the identifier remapping enabled, a string.",
+               id.dump().c_str());
+
+  if (!g_RemapIdentifiers)
+    return id.get<tw_lpid>();
+  if (id.is_string())
+    return resolveIdentifier(id.get<std::string>());
+  return resolveIdentifier(std::to_string(id.get<tw_lpid>()));
+}
+
+/// \brief Returns the global identifier of the `index`-th service of a range,
+///        whose model identifiers advance by `stride` from `first`.
 ///
-/// \warning If the "users" section is missing in the provided JSON data,
-///          the function will log an error using the ispd_error macro.
-///          If any user is missing the required attributes, an error will
-///          be logged as well.
+/// \note If the identifiers are remapped, the range's identifiers are
+///       remapped one by one, such that a range with a nonzero stride must be
+///       identified by integers.
+static auto resolveIdentifier(const json &first, const tw_lpid index,
+                              const tw_lpid stride) -> tw_lpid {
+  if (!g_RemapIdentifiers)
+    return resolveIdentifier(first) + index * stride;
+  if (index == 0 || stride == 0)
+    return resolveIdentifier(first);
+
+  // Checks if the range is identified by a string, which cannot be advanced.
+  if (!first.is_number_unsigned())
+    ispd_error("The range of services starting at %s must be identified by "
+               "an integer.",
+               first.dump().c_str());
+  return resolveIdentifier(
+      std::to_string(first.get<tw_lpid>() + index * stride));
+}
+
+/// \brief Commits the record of the range of `count` machines or switches
+///        whose model identifiers are consecutive, starting at `id`.
+///
+/// If the identifiers are remapped, the range is split into the runs of
+/// services whose global identifiers are consecutive, each with its record.
+template <typename Record>
+static auto commitRange(Record record, const json &id, const tw_lpid count)
+    -> void {
+  if (!g_RemapIdentifiers) {
+    record.m_Id = resolveIdentifier(id);
+    record.m_Count = count;
+    commit(record);
+    return;
+  }
+
+  record.m_Count = 0;
+
+  for (tw_lpid i = 0; i < count; i++) {
+    const tw_lpid gid = resolveIdentifier(id, i, 1);
+
+    if (record.m_Count && gid == record.m_Id + record.m_Count) {
+      record.m_Count++;
+      continue;
+    }
+
+    if (record.m_Count)
+      commit(record);
+    record.m_Id = gid;
+    record.m_Count = 1;
+  }
+  commit(record);
+}
+
+/// \brief Loads a user from its JSON specification and registers it in the
+///        simulation model.
 ///
-/// \details The function iterates over each user in the "users" section
-///          of the JSON data, checks for the presence of required attributes,
-///          and registers the user in the simulation model using the
-///          ispd::this_model::registerUser function.
+/// \param user The JSON specification of the user, listed under the "users"
+///             section. It is expected to have attributes like "name"
+///             (MODEL_USER_NAME_KEY) and "energy_limit_consumption"
+///             (MODEL_USER_ENERGYLIMIT_KEY).
+/// \param userIndex The index of the user in the "users" section.
 ///
-/// \warning If any user is missing the required attributes, an error will be
+/// \warning If the user is missing the required attributes, an error will be
 ///          logged using the ispd_error macro, specifying the index of the
 ///          user in the "users" section and the missing attribute.
 ///
 /// \note The function is marked as noexcept to indicate that it does not
 ///       throw exceptions. Instead, it relies on error logging using the
 ///       ispd_error macro for error reporting.
-static auto loadUsers(const json &data) noexcept -> void {
-  // Checks if there is no users section in the model to be loaded.
-  if (!data.contains(MODEL_USERS_SECTION))
-    ispd_error("Model must have `users` section.");
-
-  const json &users = data[MODEL_USERS_SECTION];
-  size_t userIndex = 0;
-
-  for (const auto &user : users) {
-    // Check if the model specification does not specify the name of the user
-    // to be registered in the model to be simulated.
-    if (!user.contains(MODEL_USER_NAME_KEY))
-      ispd_error("User listed at index %lu in model specification does not "
-                 "have the `%s` attribute.",
-                 userIndex, MODEL_USER_NAME_KEY);
-
-    // Check if the model specification does not specify the energy consumption
-    // of the user to be registered in the model to be simulated.
-    if (!user.contains(MODEL_USER_ENERGYLIMIT_KEY))
-      ispd_error("User listed at index %lu in model specification does noot "
-                 "have the `%s` attribute.",
-                 userIndex, MODEL_USER_ENERGYLIMIT_KEY);
-
-    // Register the user in the model to be simulated.
-    ispd::this_model::registerUser(user[MODEL_USER_NAME_KEY],
-                                   user[MODEL_USER_ENERGYLIMIT_KEY]);
+static auto loadUser(const json &user, const size_t userIndex) noexcept
+    -> void {
+  // Check if the model specification does not specify the name of the user
+  // to be registered in the model to be simulated.
+  if (!user.contains(MODEL_USER_NAME_KEY))
+    ispd_error("User listed at index %lu in model specification does not "
+               "have the `%s` attribute.",
+               userIndex, MODEL_USER_NAME_KEY);
 
-    userIndex++;
-  }
+  // Check if the model specification does not specify the energy consumption
+  // of the user to be registered in the model to be simulated.
+  if (!user.contains(MODEL_USER_ENERGYLIMIT_KEY))
+    ispd_error("User listed at index %lu in model specification does noot "
+               "have the `%s` attribute.",
+               userIndex, MODEL_USER_ENERGYLIMIT_KEY);
 
-  ispd_debug(
-      "An amount of %lu users have been loaded from the model specification.",
-      userIndex);
+  // Register the user in the model to be simulated.
+  commit(UserRecord{
+      g_Snapshot->addString(user[MODEL_USER_NAME_KEY].get<std::string>()),
+      user[MODEL_USER_ENERGYLIMIT_KEY].get<double>()});
 }
 
 /// \brief Loads an Interarrival Distribution from a JSON workload specification.
@@ -175,11 +558,13 @@ static auto loadUsers(const json &data) noexcept -> void {
 /// This function parses and loads an Interarrival Distribution from a JSON
 /// workload specification. The Interarrival Distribution type is specified
 /// under the "interarrival_type" attribute in the workload JSON. Based on the
-/// specified type, the function creates an instance of the corresponding
-/// InterarrivalDistribution subclass and returns it as a unique pointer.
+/// specified type, the function sets the kind and the parameters of the
+/// distribution in the workload's record, from which the corresponding
+/// InterarrivalDistribution subclass is instantiated.
 ///
 /// \param workload The JSON workload specification containing interarrival type.
 /// \param workloadIndex The index of the workload in the model specification.
+/// \param record The workload's record.
 ///
 /// \note The function assumes that the workload JSON contains the
 ///       "interarrival_type" attribute, specifying the type of interarrival
@@ -188,15 +573,10 @@ static auto loadUsers(const json &data) noexcept -> void {
 ///
 /// \note The function assumes that the interarrival type is specified as a
 ///       sub-object under the "interarrival_type" attribute. The type of
-///       distribution is extracted from this sub-object, and based on the type,
-///       an instance of the corresponding InterarrivalDistribution subclass is
-///       created.
-///
-/// \return A unique pointer to an instance of the InterarrivalDistribution
-///         subclass based on the specified type.
+///       distribution is extracted from this sub-object.
 static auto loadInterarrivalDist(const json &workload,
-                                 const size_t workloadIndex)
-    -> std::unique_ptr<ispd::workload::InterarrivalDistribution> {
+                                 const size_t workloadIndex,
+                                 WorkloadRecord &record) -> void {
   // Checks if the current workload does not have the interarrival type
   // atttribute.
   if (!workload.contains(MODEL_WORKLOAD_INTERARRIVALTYPE_KEY))
@@ -208,205 +588,226 @@ static auto loadInterarrivalDist(const json &workload,
   const auto &type = interarrival[MODEL_INTERARRIVAL_TYPE_KEY];
 
   if (type == "poisson") {
-    const auto &lambda = interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
+    record.m_InterarrivalKind = InterarrivalKind::POISSON;
+    record.m_InterarrivalMean =
+        interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
     ispd_debug("poisson interarrival distribution");
-    return std::make_unique<ispd::workload::PoissonInterarrivalDistribution>(
-        lambda);
   }
   else if (type == "fixed")
   {
-    const auto &lambda = interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
+    record.m_InterarrivalKind = InterarrivalKind::FIXED;
+    record.m_InterarrivalMean =
+        interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
     ispd_debug("fixed interarrival distribution");
-
-    return std::make_unique<ispd::workload::FixedInterarrivalDistribution>(lambda);
   }
   else if (type == "exponential"){
-    const auto &lambda = interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
+    record.m_InterarrivalKind = InterarrivalKind::EXPONENTIAL;
+    record.m_InterarrivalMean =
+        interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
     ispd_debug("exponential interarrival distribution");
-
-    return std::make_unique<ispd::workload::ExponentialInterarrivalDistribution>(lambda);
   }
   else if (type == "weibull")
   {
-      const auto &mean = interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
-      const auto &shape = interarrival[MODEL_INTERARRIVAL_WEIBULL_SHAPE_KEY];
+      record.m_InterarrivalKind = InterarrivalKind::WEIBULL;
+      record.m_InterarrivalMean =
+          interarrival[MODEL_INTERARRIVAL_POISSON_LAMBDA_KEY];
+      record.m_InterarrivalShape =
+          interarrival[MODEL_INTERARRIVAL_WEIBULL_SHAPE_KEY];
       ispd_debug("weibull interarrival distribution");
-      return std::make_unique<ispd::workload::WeibullInterarrivalDistribution>(mean,shape);
   }
   else {
     ispd_error("Unexpected `%s` interarrival distribution type.",
                type.get<std::string>().c_str());
-    throw std::runtime_error("Unreachable!"); // Make the compiler happy!
   }
 }
 
-/// \brief Loads Workloads from a JSON model specification.
-///
-/// This function is responsible for parsing and loading Workloads from a JSON
-/// model specification. Workloads are expected to be listed under the
-/// "workloads" section in the provided JSON data. The function iterates over
-/// each workload, checking for the presence of required attributes, and then
-/// creates corresponding Workload objects based on the specified type.
+/// \brief Loads a Workload from its JSON specification.
 ///
-/// \param data The JSON data representing the model specification.
+/// This function is responsible for parsing and loading a Workload listed
+/// under the "workloads" section of the model specification. It checks for
+/// the presence of required attributes, and then creates the corresponding
+/// Workload object based on the specified type.
 ///
-/// \note The function assumes that the model specification contains the
-///       "workloads" section, where each workload is specified as an object.
-///       If this section is missing, an error is logged using the ispd_error
-///       macro.
+/// \param workload The JSON specification of the workload.
+/// \param workloadIndex The index of the workload in the "workloads" section.
 ///
 /// \note The function assumes that each workload specification includes
 ///       attributes such as "type," "owner," "remainingTasks," and
 ///       "masterId." It also extracts additional attributes based on the
 ///       workload type.
 ///
-/// \note Currently, the function supports the "uniform" workload type. For
-///       each uniform workload, it checks for additional attributes specific
-///       to the uniform workload type. If an unexpected type is encountered,
-///       an error is logged using the ispd_error macro.
+/// \note Currently, the function supports the "uniform" and "constant"
+///       workload types. For each of them, it checks for additional
+///       attributes specific to the workload type. If an unexpected type is
+///       encountered, an error is logged using the ispd_error macro.
 ///
 /// \note The function uses the loadInterarrivalDist function to load the
 ///       Interarrival Distribution for each workload.
 ///
-/// \note The loaded Workloads are registered in a temporary storage
-///       (g_ModelLoader_Workloads) with master IDs as keys, as these will be
-///       fetched later to register them with the masters.
+/// \note The loaded Workload is registered in a temporary storage
+///       (g_ModelLoader_Workloads) with its master ID as key, as it will be
+///       fetched later to register it with the master.
 ///
-/// \note The function logs debug messages indicating the successful loading
-///       of each workload, including details such as the type, sizes, and
-///       owner.
-static auto loadWorkloads(const json &data) noexcept -> void {
-  // Checks if there is no workloads section in the model to be loaded.
-  if (!data.contains(MODEL_WORKLOADS_SECTION))
-    ispd_error("Model must have `%s` section.", MODEL_WORKLOADS_SECTION);
-
-  const json &workloads = data[MODEL_WORKLOADS_SECTION];
-  size_t workloadIndex = 0;
-
-  for (const auto &workload : workloads) {
-    const auto &workloadRequiredAttributes = {
-        MODEL_WORKLOAD_TYPE_KEY, MODEL_WORKLOAD_OWNER_KEY,
-        MODEL_WORKLOAD_REMAININGTASKS_KEY, MODEL_WORKLOAD_MASTERID_KEY};
-
-    // Checks if the current workload specifications has all the required
-    // attributes.
-    for (const auto &attribute : workloadRequiredAttributes)
+/// \note The workload's owner must have already been registered.
+static auto loadWorkload(const json &workload,
+                         const size_t workloadIndex) noexcept -> void {
+  const auto &workloadRequiredAttributes = {
+      MODEL_WORKLOAD_TYPE_KEY, MODEL_WORKLOAD_OWNER_KEY,
+      MODEL_WORKLOAD_REMAININGTASKS_KEY, MODEL_WORKLOAD_MASTERID_KEY};
+
+  // Checks if the current workload specifications has all the required
+  // attributes.
+  for (const auto &attribute : workloadRequiredAttributes)
+    if (!workload.contains(attribute))
+      ispd_error(
+          "Workload listed at index %lu in model specification does not "
+          "have the `%s` attribute.",
+          workloadIndex, attribute);
+
+  const auto &type = workload[MODEL_WORKLOAD_TYPE_KEY];
+  const auto &masterId = workload[MODEL_WORKLOAD_MASTERID_KEY];
+
+  WorkloadRecord record = {};
+
+  record.m_MasterId = resolveIdentifier(masterId);
+  record.m_Owner = g_Snapshot->addString(
+      workload[MODEL_WORKLOAD_OWNER_KEY].get<std::string>());
+  record.m_RemainingTasks = workload[MODEL_WORKLOAD_REMAININGTASKS_KEY];
+  record.m_ComputingOffload = workload[MODEL_WORKLOAD_COMPUTINGOFFLOAD_KEY];
+
+  loadInterarrivalDist(workload, workloadIndex, record);
+  g_ModelLoader_WorkloadMasters.insert(record.m_MasterId);
+
+  if (type == "uniform") {
+    const auto &uniformWorkloadRequiredAttributes = {
+        MODEL_WORKLOAD_UNIFORM_MINPROCSIZE_KEY,
+        MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY,
+        MODEL_WORKLOAD_UNIFORM_MINCOMMSIZE_KEY,
+        MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY};
+
+    // Checks if the current uniform workload specifications has all the
+    // required attributes.
+    for (const auto &attribute : uniformWorkloadRequiredAttributes)
       if (!workload.contains(attribute))
-        ispd_error(
-            "Workload listed at index %lu in model specification does not "
-            "have the `%s` attribute.",
-            workloadIndex, attribute);
-
-    const auto &type = workload[MODEL_WORKLOAD_TYPE_KEY];
-    const auto &owner = workload[MODEL_WORKLOAD_OWNER_KEY];
-    const auto &remainingTasks = workload[MODEL_WORKLOAD_REMAININGTASKS_KEY];
-    const auto &masterId = workload[MODEL_WORKLOAD_MASTERID_KEY];
-    const auto &computingOffload =
-        workload[MODEL_WORKLOAD_COMPUTINGOFFLOAD_KEY];
-
-    ispd::workload::Workload *w;
-    std::unique_ptr<ispd::workload::InterarrivalDistribution> interarrivalDist =
-        loadInterarrivalDist(workload, workloadIndex);
-
-    if (type == "uniform") {
-      const auto &uniformWorkloadRequiredAttributes = {
-          MODEL_WORKLOAD_UNIFORM_MINPROCSIZE_KEY,
-          MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY,
-          MODEL_WORKLOAD_UNIFORM_MINCOMMSIZE_KEY,
-          MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY};
-
-      // Checks if the current uniform workload specifications has all the
-      // required attributes.
-      for (const auto &attribute : uniformWorkloadRequiredAttributes)
-        if (!workload.contains(attribute))
-          ispd_error("Uniform Workload listed at index %lu in model "
-                     "specification does not "
-                     "have the `%s` attribute.",
-                     workloadIndex, attribute);
-
-      const auto minProcSize =
-          workload[MODEL_WORKLOAD_UNIFORM_MINPROCSIZE_KEY].get<double>();
-      const auto maxProcSize =
-          workload[MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY].get<double>();
-      const auto minCommSize =
-          workload[MODEL_WORKLOAD_UNIFORM_MINCOMMSIZE_KEY].get<double>();
-      const auto maxCommSize =
-          workload[MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY].get<double>();
-
-      w = new ispd::workload::UniformWorkload(
-          owner, remainingTasks, minProcSize, maxProcSize, minCommSize,
-          maxCommSize, computingOffload, std::move(interarrivalDist));
-
-      ispd_debug("Uniform Workload (%.2lf, %.2lf, %.2lf, %.2lf) for master "
-                 "with id %lu has been loaded from the model specification.",
-                 minProcSize, maxProcSize, minCommSize, maxCommSize,
-                 masterId.get<tw_lpid>());
-    }
-    else if (type == "constant")
-    {
-      const auto &uniformWorkloadRequiredAttributes = {
-          MODEL_WORKLOAD_UNIFORM_MINPROCSIZE_KEY,
-          MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY,
-          MODEL_WORKLOAD_UNIFORM_MINCOMMSIZE_KEY,
-          MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY};
-
-      // Checks if the current uniform workload specifications has all the
-      // required attributes.
-      for (const auto &attribute : uniformWorkloadRequiredAttributes)
-        if (!workload.contains(attribute))
-          ispd_error("Constant Workload listed at index %lu in model "
-                     "specification does not "
-                     "have the `%s` attribute.",
-                     workloadIndex, attribute);
-
-      const auto maxProcSize =
-          workload[MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY].get<double>();
-
-      const auto maxCommSize =
-          workload[MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY].get<double>();
-
-
-
-      w = new ispd::workload::ConstantWorkload(owner, remainingTasks, maxProcSize,
-                                               maxCommSize, computingOffload, std::move(interarrivalDist));
-
-      ispd_debug("Constant Workload (%.2lf, %.2lf) for master "
-                 "with id %lu has been loaded from the model specification.",
-                 maxProcSize, maxCommSize,
-                 masterId.get<tw_lpid>());
-    }
-    else {
-      ispd_error("Unexpected workload type %s.",
-                 type.get<std::string>().c_str());
-    }
+        ispd_error("Uniform Workload listed at index %lu in model "
+                   "specification does not "
+                   "have the `%s` attribute.",
+                   workloadIndex, attribute);
+
+    const auto minProcSize =
+        workload[MODEL_WORKLOAD_UNIFORM_MINPROCSIZE_KEY].get<double>();
+    const auto maxProcSize =
+        workload[MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY].get<double>();
+    const auto minCommSize =
+        workload[MODEL_WORKLOAD_UNIFORM_MINCOMMSIZE_KEY].get<double>();
+    const auto maxCommSize =
+        workload[MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY].get<double>();
+
+    record.m_Kind = WorkloadKind::UNIFORM;
+    record.m_MinProcSize = minProcSize;
+    record.m_MaxProcSize = maxProcSize;
+    record.m_MinCommSize = minCommSize;
+    record.m_MaxCommSize = maxCommSize;
+
+    ispd_debug("Uniform Workload (%.2lf, %.2lf, %.2lf, %.2lf) for master "
+               "with id %lu has been loaded from the model specification.",
+               minProcSize, maxProcSize, minCommSize, maxCommSize,
+               record.m_MasterId);
+  }
+  else if (type == "constant")
+  {
+    const auto &uniformWorkloadRequiredAttributes = {
+        MODEL_WORKLOAD_UNIFORM_MINPROCSIZE_KEY,
+        MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY,
+        MODEL_WORKLOAD_UNIFORM_MINCOMMSIZE_KEY,
+        MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY};
+
+    // Checks if the current uniform workload specifications has all the
+    // required attributes.
+    for (const auto &attribute : uniformWorkloadRequiredAttributes)
+      if (!workload.contains(attribute))
+        ispd_error("Constant Workload listed at index %lu in model "
+                   "specification does not "
+                   "have the `%s` attribute.",
+                   workloadIndex, attribute);
 
-    // Register the workload in a temporary storage, because this will be
-    // fetched after to register them with the masters.
-    g_ModelLoader_Workloads.insert(std::make_pair<>(masterId.get<tw_lpid>(), w));
+    const auto maxProcSize =
+        workload[MODEL_WORKLOAD_UNIFORM_MAXPROCSIZE_KEY].get<double>();
 
-    workloadIndex++;
+    const auto maxCommSize =
+        workload[MODEL_WORKLOAD_UNIFORM_MAXCOMMSIZE_KEY].get<double>();
+
+    record.m_Kind = WorkloadKind::CONSTANT;
+    record.m_MaxProcSize = maxProcSize;
+    record.m_MaxCommSize = maxCommSize;
+
+    ispd_debug("Constant Workload (%.2lf, %.2lf) for master "
+               "with id %lu has been loaded from the model specification.",
+               maxProcSize, maxCommSize,
+               record.m_MasterId);
+  }
+  else {
+    ispd_error("Unexpected workload type %s.",
+               type.get<std::string>().c_str());
   }
 
-  ispd_debug("An amount of %lu workloads have been loaded from the model "
-             "specification.",
-             workloadIndex);
+  commit(record);
 }
 
-static auto loadMasterScheduler(const json &type) noexcept
-    -> ispd::scheduler::Scheduler * {
+static auto loadMasterScheduler(const json &type) noexcept -> SchedulerKind {
   if (type == "RoundRobin") {
-    return new ispd::scheduler::RoundRobin;
+    return SchedulerKind::ROUND_ROBIN;
   } else {
     ispd_error("Unexepected %s scheduler.", type.get<std::string>().c_str());
   }
-  return nullptr;
+  return SchedulerKind::ROUND_ROBIN;
 }
 
-static auto loadMasterSlaves(const json &slavesArray) noexcept
+static auto loadMasterRouteSelector(const json &type) noexcept
+    -> RouteSelectorKind {
+  if (type == "First") {
+    return RouteSelectorKind::FIRST;
+  } else if (type == "ECMP") {
+    return RouteSelectorKind::ECMP;
+  } else if (type == "RoundRobin") {
+    return RouteSelectorKind::ROUND_ROBIN;
+  } else if (type == "LeastWaited") {
+    return RouteSelectorKind::LEAST_WAITED;
+  } else {
+    ispd_error("Unexepected %s route selection.",
+               type.get<std::string>().c_str());
+  }
+  return RouteSelectorKind::FIRST;
+}
+
+/// \brief Loads the master's slaves, which are listed either one by one or as
+///        ranges of consecutive identifiers, such as `{"first": 10, "count":
+///        1000}`, and resolves their global identifiers.
+static auto loadMasterSlaves(const json &slavesArray,
+                             const size_t masterIndex) noexcept
     -> std::vector<tw_lpid> {
   std::vector<tw_lpid> slaves;
-  for (const auto &slaveId : slavesArray)
-    slaves.emplace_back(slaveId.get<tw_lpid>());
+  for (const auto &slave : slavesArray) {
+    if (!slave.is_object()) {
+      slaves.emplace_back(resolveIdentifier(slave));
+      continue;
+    }
+
+    // Checks if the slaves range has not been fully specified.
+    if (!slave.contains(MODEL_SERVICE_MASTER_SLAVES_FIRST_KEY) ||
+        !slave.contains(MODEL_SERVICE_MASTER_SLAVES_COUNT_KEY))
+      ispd_error("Master listed at index %lu in model specification has a "
+                 "slaves range without the `%s` and `%s` attributes.",
+                 masterIndex, MODEL_SERVICE_MASTER_SLAVES_FIRST_KEY,
+                 MODEL_SERVICE_MASTER_SLAVES_COUNT_KEY);
+
+    const auto &first = slave[MODEL_SERVICE_MASTER_SLAVES_FIRST_KEY];
+    const auto count =
+        slave[MODEL_SERVICE_MASTER_SLAVES_COUNT_KEY].get<tw_lpid>();
+
+    for (tw_lpid i = 0; i < count; i++)
+      slaves.emplace_back(resolveIdentifier(first, i, 1));
+  }
   return slaves;
 }
 
@@ -424,44 +825,52 @@ static auto loadMaster(const json &master, const size_t masterIndex) noexcept
                  "have the `%s` attribute.",
                  masterIndex, attribute);
 
-  const tw_lpid id = master[MODEL_SERVICE_MASTER_ID_KEY];
+  const tw_lpid id = resolveIdentifier(master[MODEL_SERVICE_MASTER_ID_KEY]);
 
   // Checks if there is no workloads registered to this master.
-  if (g_ModelLoader_Workloads.find(id) == g_ModelLoader_Workloads.cend())
+  if (g_ModelLoader_WorkloadMasters.find(id) ==
+      g_ModelLoader_WorkloadMasters.cend())
     ispd_error("No workloads have been loaded to master listed at %lu with "
-               "identifier %lu.",
-               masterIndex, id);
+               "identifier %s.",
+               masterIndex, getServiceIdentifier(id).c_str());
 
-  ispd::scheduler::Scheduler *scheduler =
+  const SchedulerKind scheduler =
       loadMasterScheduler(master[MODEL_SERVICE_MASTER_SCHEDULER_KEY]);
-  std::vector<tw_lpid> slaves =
-      loadMasterSlaves(master[MODEL_SERVICE_MASTER_SLAVES_KEY]);
-  ispd::workload::Workload *workload = g_ModelLoader_Workloads.at(id);
+  const std::vector<tw_lpid> slaves =
+      loadMasterSlaves(master[MODEL_SERVICE_MASTER_SLAVES_KEY], masterIndex);
+
+  // The route selection is optional, and the first route to each slave is
+  // always selected if it is not specified.
+  const RouteSelectorKind routeSelector =
+      master.contains(MODEL_SERVICE_MASTER_ROUTESELECTION_KEY)
+          ? loadMasterRouteSelector(
+                master[MODEL_SERVICE_MASTER_ROUTESELECTION_KEY])
+          : RouteSelectorKind::FIRST;
 
   // Register the master.
-  ispd::this_model::registerMaster(id, std::move(slaves), scheduler, workload);
-  registerGidToType(id, LogicalProcessType::MASTER);
+  commit(MasterRecord{id, scheduler, routeSelector,
+                      g_Snapshot->addLpids(slaves)});
 
   ispd_debug("Master listed at %lu with identifier %lu has been loaded from "
              "the model specification.",
              masterIndex, id);
 }
 
-static auto loadMasters(const json &services) noexcept -> void {
-  // Checks if there is no masters subsection in the services section.
-  if (!services.contains(MODEL_SERVICES_MASTER_SUBSECTION))
-    ispd_error("Services section must have `%s` subsection.",
-               MODEL_SERVICES_MASTER_SUBSECTION);
-
-  const auto &masters = services[MODEL_SERVICES_MASTER_SUBSECTION];
-  size_t masterIndex = 0;
-
-  for (const auto &master : masters) {
-    loadMaster(master, masterIndex);
-    masterIndex++;
-  }
-
-  ispd_debug("An amount of %lu masters have been loaded from the model specification.", masterIndex);
+/// \brief Loads the number of services declared by the service element.
+///
+/// \note If the number is not positive, the program is immediately aborted.
+static auto loadServiceCount(const json &service, const char *const kind,
+                             const size_t serviceIndex) noexcept -> tw_lpid {
+  if (!service.contains(MODEL_SERVICE_COUNT_KEY))
+    return 1;
+
+  const auto count = service[MODEL_SERVICE_COUNT_KEY].get<tw_lpid>();
+
+  if (count == 0)
+    ispd_error("%s listed at index %lu in model specification must have a "
+               "positive `%s`.",
+               kind, serviceIndex, MODEL_SERVICE_COUNT_KEY);
+  return count;
 }
 
 static auto loadMachine(const json &machine, const size_t machineIndex) noexcept
@@ -487,7 +896,7 @@ static auto loadMachine(const json &machine, const size_t machineIndex) noexcept
                  "have the `%s` attribute.",
                  machineIndex, attribute);
 
-  const tw_lpid id = machine[MODEL_SERVICE_MACHINE_ID_KEY].get<tw_lpid>();
+  const json &id = machine[MODEL_SERVICE_MACHINE_ID_KEY];
   const double power = machine[MODEL_SERVICE_MACHINE_POWER_KEY].get<double>();
   const double load = machine[MODEL_SERVICE_MACHINE_LOAD_KEY].get<double>();
   const unsigned coreCount =
@@ -503,35 +912,17 @@ static auto loadMachine(const json &machine, const size_t machineIndex) noexcept
       machine[MODEL_SERVICE_MACHINE_WATTAGEIDLE_KEY].get<double>();
   const double wattageMax =
       machine[MODEL_SERVICE_MACHINE_WATTAGEMAX_KEY].get<double>();
+  const tw_lpid count = loadServiceCount(machine, "Machine", machineIndex);
 
   // Registter the machine.
-  ispd::this_model::registerMachine(id, power, load, coreCount, gpuPower,
-                                    gpuCoreCount, interconnectionBandwidth,
-                                    wattageIdle, wattageMax);
-  registerGidToType(id, LogicalProcessType::MACHINE);
+  commitRange(MachineRecord{0, count, power, load, coreCount, gpuCoreCount,
+                            gpuPower, interconnectionBandwidth, wattageIdle,
+                            wattageMax},
+              id, count);
 
-  ispd_debug("Machine listed at %lu with identifier %lu has been loaded from "
+  ispd_debug("Machine listed at %lu with identifier %s has been loaded from "
              "the model specification.",
-             machineIndex, id);
-}
-
-static auto loadMachines(const json &services) noexcept -> void {
-  // Checks if there is no machines subsection in the services section.
-  if (!services.contains(MODEL_SERVICES_MACHINES_SUBSECTION))
-    ispd_error("Services section must have `%s` subsection.",
-               MODEL_SERVICES_MACHINES_SUBSECTION);
-
-  const auto &machines = services[MODEL_SERVICES_MACHINES_SUBSECTION];
-  size_t machineIndex = 0;
-
-  for (const auto &machine : machines) {
-    loadMachine(machine, machineIndex);
-    machineIndex++;
-  }
-
-  ispd_debug("An amount of %lu machines have been loaded from the model "
-             "specification.",
-             machineIndex);
+             machineIndex, id.dump().c_str());
 }
 
 static auto loadLink(const json &link, const size_t linkIndex) noexcept
@@ -554,39 +945,58 @@ static auto loadLink(const json &link, const size_t linkIndex) noexcept
                  "have the `%s` attribute.",
                  linkIndex, attribute);
 
-  const tw_lpid id = link[MODEL_SERVICE_LINK_ID_KEY].get<tw_lpid>();
-  const tw_lpid from = link[MODEL_SERVICE_LINK_FROM_KEY].get<tw_lpid>();
-  const tw_lpid to = link[MODEL_SERVICE_LINK_TO_KEY].get<tw_lpid>();
+  const json &id = link[MODEL_SERVICE_LINK_ID_KEY];
+  const json &from = link[MODEL_SERVICE_LINK_FROM_KEY];
+  const json &to = link[MODEL_SERVICE_LINK_TO_KEY];
   const double bandwidth = link[MODEL_SERVICE_LINK_BANDWIDTH_KEY].get<double>();
   const double load = link[MODEL_SERVICE_LINK_LOAD_KEY].get<double>();
   const double latency = link[MODEL_SERVICE_LINK_LATENCY_KEY].get<double>();
+  const tw_lpid count = loadServiceCount(link, "Link", linkIndex);
+  const tw_lpid fromStride =
+      link.value(MODEL_SERVICE_LINK_FROMSTRIDE_KEY, tw_lpid{0});
+  const tw_lpid toStride = link.value(MODEL_SERVICE_LINK_TOSTRIDE_KEY, tw_lpid{0});
 
   // Register the link.
-  ispd::this_model::registerLink(id, from, to, bandwidth, load, latency);
-  registerGidToType(id, LogicalProcessType::LINK);
-
-  ispd_debug("Link listed at %lu with identifier %lu has been loaded from "
-             "the model specification.",
-             linkIndex, id);
-}
-
-static auto loadLinks(const json &services) noexcept -> void {
-  // Checks if there is no links subsection in the services section.
-  if (!services.contains(MODEL_SERVICES_LINKS_SUBSECTION))
-    ispd_error("Services section must have `%s` subsection.",
-               MODEL_SERVICES_LINKS_SUBSECTION);
-
-  const auto &links = services[MODEL_SERVICES_LINKS_SUBSECTION];
-  size_t linkIndex = 0;
-
-  for (const auto &link : links) {
-    loadLink(link, linkIndex);
-    linkIndex++;
+  if (!g_RemapIdentifiers) {
+    commit(LinkRecord{resolveIdentifier(id), count, resolveIdentifier(from),
+                      resolveIdentifier(to), fromStride, toStride, bandwidth,
+                      load, latency});
+  } else {
+    // The range of links is split into the runs of links whose global
+    // identifiers are consecutive and whose ends' global identifiers advance
+    // by a constant stride, each with its record.
+    LinkRecord record{0, 0, 0, 0, 0, 0, bandwidth, load, latency};
+
+    for (tw_lpid i = 0; i < count; i++) {
+      const tw_lpid gid = resolveIdentifier(id, i, 1);
+      const tw_lpid fromGid = resolveIdentifier(from, i, fromStride);
+      const tw_lpid toGid = resolveIdentifier(to, i, toStride);
+
+      if (record.m_Count == 1 && gid == record.m_Id + 1) {
+        record.m_FromStride = fromGid - record.m_From;
+        record.m_ToStride = toGid - record.m_To;
+        record.m_Count++;
+        continue;
+      }
+
+      if (record.m_Count > 1 && gid == record.m_Id + record.m_Count &&
+          fromGid == record.m_From + record.m_Count * record.m_FromStride &&
+          toGid == record.m_To + record.m_Count * record.m_ToStride) {
+        record.m_Count++;
+        continue;
+      }
+
+      if (record.m_Count)
+        commit(record);
+      record = LinkRecord{gid, 1, fromGid, toGid, 0, 0, bandwidth, load,
+                          latency};
+    }
+    commit(record);
   }
 
-  ispd_debug("An amount of %lu links have been loaded from the model "
-             "specification.",
-             linkIndex);
+  ispd_debug("Link listed at %lu with identifier %s has been loaded from "
+             "the model specification.",
+             linkIndex, id.dump().c_str());
 }
 
 static auto loadSwitch(const json &switch_, const size_t switchIndex) noexcept
@@ -604,78 +1014,702 @@ static auto loadSwitch(const json &switch_, const size_t switchIndex) noexcept
                  "have the `%s` attribute.",
                  switchIndex, attribute);
 
-  const tw_lpid id = switch_[MODEL_SERVICE_SWITCH_ID_KEY];
+  const json &id = switch_[MODEL_SERVICE_SWITCH_ID_KEY];
   const double bandwidth = switch_[MODEL_SERVICE_SWITCH_BANDWIDTH_KEY];
   const double load = switch_[MODEL_SERVICE_SWITCH_LOAD_KEY];
   const double latency = switch_[MODEL_SERVICE_SWITCH_LATENCY_KEY];
+  const tw_lpid count = loadServiceCount(switch_, "Switch", switchIndex);
 
   // Register the switch.
-  ispd::this_model::registerSwitch(id, bandwidth, load, latency);
-  registerGidToType(id, LogicalProcessType::SWITCH);
+  commitRange(SwitchRecord{0, count, bandwidth, load, latency}, id, count);
 
-  ispd_debug("Switch listed at %lu with identifier %lu has been loaded from "
+  ispd_debug("Switch listed at %lu with identifier %s has been loaded from "
              "the model specification.",
-             switchIndex, id);
+             switchIndex, id.dump().c_str());
 }
 
-static auto loadSwitches(const json &services) noexcept -> void {
-  // Checks if there is no switches subsection in the services section.
-  if (!services.contains(MODEL_SERVICES_SWITCHES_SUBSECTION))
-    ispd_error("Services section must have `%s` subsection.",
-               MODEL_SERVICES_SWITCHES_SUBSECTION);
+/// \brief Checks if the routing section has the specified attributes. If not,
+///        the program is immediately aborted.
+static auto checkRoutingAttributes(
+    const json &routing, const std::string &provider,
+    const std::initializer_list<const char *> &attributes) noexcept -> void {
+  for (const auto &attribute : attributes)
+    if (!routing.contains(attribute))
+      ispd_error("The `%s` routing provider requires the `%s` attribute.",
+                 provider.c_str(), attribute);
+}
 
-  const auto &switches = services[MODEL_SERVICES_SWITCHES_SUBSECTION];
-  size_t switchIndex = 0;
+/// \brief Loads the routing provider from the routing section.
+///
+/// If the section is missing or its provider is `table`, the routes are
+/// served by the global routing table, which is populated from a route file
+/// or computed from the links. Otherwise, an implicit provider computes the
+/// routes of a regular topology whose services must be numbered as documented
+/// by the provider (see `ispd::routing_provider`), and no route file is
+/// needed at all.
+static auto loadRouting(const json &routing) noexcept -> void {
+  if (!routing.contains(MODEL_ROUTING_PROVIDER_KEY))
+    ispd_error("Routing section must have the `%s` attribute.",
+               MODEL_ROUTING_PROVIDER_KEY);
+
+  const auto provider = routing[MODEL_ROUTING_PROVIDER_KEY].get<std::string>();
+
+  if (provider == "table")
+    return;
+
+  checkRoutingAttributes(routing, provider, {MODEL_ROUTING_MASTERS_KEY});
+
+  RoutingRecord record = {};
+
+  record.m_MasterCount = routing[MODEL_ROUTING_MASTERS_KEY].get<tw_lpid>();
+
+  if (provider == "star") {
+    checkRoutingAttributes(routing, provider,
+                           {MODEL_ROUTING_STAR_MACHINES_KEY});
+
+    record.m_Kind = RoutingProviderKind::STAR;
+    record.m_MachineCount =
+        routing[MODEL_ROUTING_STAR_MACHINES_KEY].get<tw_lpid>();
+  } else if (provider == "tree") {
+    checkRoutingAttributes(
+        routing, provider,
+        {MODEL_ROUTING_TREE_ARITY_KEY, MODEL_ROUTING_TREE_DEPTH_KEY});
+
+    record.m_Kind = RoutingProviderKind::TREE;
+    record.m_Arity = routing[MODEL_ROUTING_TREE_ARITY_KEY].get<tw_lpid>();
+    record.m_Depth = routing[MODEL_ROUTING_TREE_DEPTH_KEY].get<unsigned>();
+  } else if (provider == "fat_tree") {
+    checkRoutingAttributes(routing, provider, {MODEL_ROUTING_FATTREE_K_KEY});
+
+    record.m_Kind = RoutingProviderKind::FAT_TREE;
+    record.m_K = routing[MODEL_ROUTING_FATTREE_K_KEY].get<tw_lpid>();
+  } else if (provider == "torus") {
+    checkRoutingAttributes(routing, provider,
+                           {MODEL_ROUTING_TORUS_DIMENSIONS_KEY});
+
+    record.m_Kind = RoutingProviderKind::TORUS;
+    record.m_Dimensions = g_Snapshot->addLpids(
+        routing[MODEL_ROUTING_TORUS_DIMENSIONS_KEY]
+            .get<std::vector<tw_lpid>>());
+  } else {
+    ispd_error("Unexpected %s routing provider.", provider.c_str());
+    return;
+  }
 
-  for (const auto &switch_ : switches) {
-    loadSwitch(switch_, switchIndex);
-    switchIndex++;
+  commit(record);
+}
+
+/// \brief The sections of the model specification whose elements are loaded
+///        one at a time, in their loading order, followed by the routing
+///        section, which is loaded as a whole.
+enum ModelSection : unsigned {
+  USERS,
+  WORKLOADS,
+  MASTERS,
+  MACHINES,
+  LINKS,
+  SWITCHES,
+  SECTION_COUNT,
+  ROUTING = SECTION_COUNT,
+  NO_SECTION
+};
+
+/// \brief The attribute that lists the elements of each section.
+static const char *const g_SectionKeys[SECTION_COUNT] = {
+    MODEL_USERS_SECTION,
+    MODEL_WORKLOADS_SECTION,
+    MODEL_SERVICES_MASTER_SUBSECTION,
+    MODEL_SERVICES_MACHINES_SUBSECTION,
+    MODEL_SERVICES_LINKS_SUBSECTION,
+    MODEL_SERVICES_SWITCHES_SUBSECTION};
+
+/// \brief The element names of each section, as printed in the debug messages.
+static const char *const g_SectionElements[SECTION_COUNT] = {
+    "users", "workloads", "masters", "machines", "links", "switches"};
+
+/// \class ModelSaxHandler
+///
+/// \brief Loads the model specification as it is parsed, without ever
+///        building the whole document.
+///
+/// The handler receives the parser's events and builds a JSON value only for
+/// the element being parsed, that is, a user, a workload or a service. As
+/// soon as the element is closed, it is loaded by the same function that
+/// validates and registers it, such that the validation errors are kept, and
+/// then it is released. Thus, the memory held while loading a model with
+/// millions of services is bounded by its largest element.
+///
+/// A workload is registered with its owner, which must have been registered,
+/// and a master with its workload. Therefore, if a section is listed before
+/// the sections it depends on, its elements are kept until they are loaded.
+/// The routing section, which is small and depends on the services, is
+/// loaded at the end.
+class ModelSaxHandler final : public nlohmann::json_sax<json> {
+  /// \brief The number of open containers, not counting the element's and the
+  ///        skipped ones. The root is at depth 1, the sections' attributes
+  ///        are at depth 2 and the services' attributes are at depth 3.
+  std::size_t m_Depth = 0;
+
+  /// \brief The number of open containers of an unknown attribute, whose
+  ///        contents are skipped.
+  std::size_t m_SkipDepth = 0;
+
+  /// \brief The last attribute key read.
+  std::string m_Key;
+
+  /// \brief If set, the services section is open.
+  bool m_InServices = false;
+
+  /// \brief The section whose elements are open, or `NO_SECTION`.
+  unsigned m_OpenSection = NO_SECTION;
+
+  /// \brief The section of the element being built, or `NO_SECTION` if no
+  ///        element is being built.
+  unsigned m_ElementSection = NO_SECTION;
+
+  /// \brief The element being built and its open containers.
+  json m_Element;
+  std::vector<json *> m_ElementStack;
+
+  /// \brief If each section and the services section have been listed.
+  bool m_Listed[SECTION_COUNT] = {};
+  bool m_ServicesListed = false;
+
+  /// \brief If each section has been parsed and if all its elements have
+  ///        been loaded.
+  bool m_Parsed[SECTION_COUNT] = {};
+  bool m_Loaded[SECTION_COUNT] = {};
+
+  /// \brief The number of elements parsed in each section.
+  std::size_t m_Counts[SECTION_COUNT] = {};
+
+  /// \brief The elements that wait for the sections they depend on.
+  std::vector<std::pair<json, std::size_t>> m_Pending[SECTION_COUNT];
+
+  /// \brief The routing section, if listed.
+  json m_Routing;
+  bool m_RoutingListed = false;
+
+  /// \brief Returns true if the sections the specified section depends on
+  ///        have been loaded.
+  [[nodiscard]] auto isReady(const unsigned section) const noexcept -> bool {
+    if (section == WORKLOADS)
+      return m_Loaded[USERS];
+    if (section == MASTERS)
+      return m_Loaded[WORKLOADS];
+    return true;
   }
 
-  ispd_debug("An amount of %lu switches have been loaded from the model "
-             "specification.",
-             switchIndex);
+  static auto loadElement(const unsigned section, const json &element,
+                          const std::size_t index) noexcept -> void {
+    switch (section) {
+    case USERS:
+      loadUser(element, index);
+      break;
+    case WORKLOADS:
+      loadWorkload(element, index);
+      break;
+    case MASTERS:
+      loadMaster(element, index);
+      break;
+    case MACHINES:
+      loadMachine(element, index);
+      break;
+    case LINKS:
+      loadLink(element, index);
+      break;
+    case SWITCHES:
+      loadSwitch(element, index);
+      break;
+    }
+  }
+
+  /// \brief Loads the pending elements of the sections that became ready,
+  ///        in the sections' loading order.
+  auto loadPending() noexcept -> void {
+    for (unsigned section = 0; section < SECTION_COUNT; section++) {
+      if (!isReady(section))
+        continue;
+
+      for (const auto &[element, index] : m_Pending[section])
+        loadElement(section, element, index);
+      m_Pending[section].clear();
+
+      if (m_Parsed[section] && !m_Loaded[section]) {
+        m_Loaded[section] = true;
+        ispd_debug("An amount of %lu %s have been loaded from the model "
+                   "specification.",
+                   m_Counts[section], g_SectionElements[section]);
+      }
+    }
+  }
+
+  /// \brief Loads the element that has just been built, or keeps it until
+  ///        the sections it depends on have been loaded.
+  auto finishElement() noexcept -> void {
+    const unsigned section = m_ElementSection;
+
+    m_ElementSection = NO_SECTION;
+
+    if (section == ROUTING) {
+      m_Routing = std::move(m_Element);
+      return;
+    }
+
+    const std::size_t index = m_Counts[section]++;
+
+    if (isReady(section) && m_Pending[section].empty())
+      loadElement(section, m_Element, index);
+    else
+      m_Pending[section].emplace_back(std::move(m_Element), index);
+
+    m_Element = json();
+  }
+
+  /// \brief Adds the value to the element being built.
+  ///
+  /// \returns The added value.
+  auto addToElement(json &&value) -> json * {
+    if (m_ElementStack.empty()) {
+      m_Element = std::move(value);
+      return &m_Element;
+    }
+
+    json &parent = *m_ElementStack.back();
+
+    if (parent.is_array()) {
+      parent.push_back(std::move(value));
+      return &parent.back();
+    }
+    return &(parent[m_Key] = std::move(value));
+  }
+
+  /// \brief Returns the section listed by the attribute whose value starts,
+  ///        if any. Otherwise, `NO_SECTION` is returned.
+  [[nodiscard]] auto findSection() const noexcept -> unsigned {
+    /// The users and the workloads are listed by the root, and the services
+    /// are listed by the services section.
+    if (m_Depth != 1 && !(m_Depth == 2 && m_InServices))
+      return NO_SECTION;
+
+    const unsigned first = m_Depth == 1 ? USERS : MASTERS;
+    const unsigned last = m_Depth == 1 ? MASTERS : SECTION_COUNT;
+
+    for (unsigned section = first; section < last; section++)
+      if (m_Key == g_SectionKeys[section])
+        return section;
+    return NO_SECTION;
+  }
+
+  /// \brief Handles a scalar or the start of a container.
+  auto onValue(json &&value) -> void {
+    const bool container = value.is_structured();
+
+    if (m_SkipDepth) {
+      m_SkipDepth += container;
+      return;
+    }
+
+    /// The value belongs to the element being built.
+    if (m_ElementSection != NO_SECTION) {
+      json *const added = addToElement(std::move(value));
+
+      if (container)
+        m_ElementStack.push_back(added);
+      else if (m_ElementStack.empty())
+        finishElement();
+      return;
+    }
+
+    /// The value is an element of the open section.
+    if (m_OpenSection != NO_SECTION) {
+      m_ElementSection = m_OpenSection;
+      onValue(std::move(value));
+      return;
+    }
+
+    /// The value is the root.
+    if (m_Depth == 0) {
+      if (!value.is_object())
+        m_SkipDepth += container;
+      else
+        m_Depth++;
+      return;
+    }
+
+    /// The value is a section's list of elements.
+    if (const unsigned section = findSection(); section != NO_SECTION) {
+      m_Listed[section] = true;
+
+      if (container) {
+        m_OpenSection = section;
+        m_Depth++;
+      }
+      return;
+    }
+
+    if (m_Depth == 1 && m_Key == MODEL_SERVICES_SECTION) {
+      m_ServicesListed = true;
+
+      if (value.is_object()) {
+        m_InServices = true;
+        m_Depth++;
+      } else {
+        m_SkipDepth += container;
+      }
+      return;
+    }
+
+    if (m_Depth == 1 && m_Key == MODEL_ROUTING_SECTION) {
+      m_RoutingListed = true;
+      m_ElementSection = ROUTING;
+      onValue(std::move(value));
+      return;
+    }
+
+    /// The value is an unknown attribute, which is skipped.
+    m_SkipDepth += container;
+  }
+
+  /// \brief Handles the end of a container.
+  auto onEnd() noexcept -> void {
+    if (m_SkipDepth) {
+      m_SkipDepth--;
+      return;
+    }
+
+    if (m_ElementSection != NO_SECTION) {
+      m_ElementStack.pop_back();
+
+      if (m_ElementStack.empty())
+        finishElement();
+      return;
+    }
+
+    if (m_OpenSection != NO_SECTION) {
+      m_Parsed[m_OpenSection] = true;
+      m_OpenSection = NO_SECTION;
+      loadPending();
+    } else if (m_InServices && m_Depth == 2) {
+      m_InServices = false;
+    }
+
+    m_Depth--;
+  }
+
+public:
+  bool null() override {
+    onValue(json());
+    return true;
+  }
+
+  bool boolean(bool val) override {
+    onValue(json(val));
+    return true;
+  }
+
+  bool number_integer(number_integer_t val) override {
+    onValue(json(val));
+    return true;
+  }
+
+  bool number_unsigned(number_unsigned_t val) override {
+    onValue(json(val));
+    return true;
+  }
+
+  bool number_float(number_float_t val, const string_t &) override {
+    onValue(json(val));
+    return true;
+  }
+
+  bool string(string_t &val) override {
+    onValue(json(std::move(val)));
+    return true;
+  }
+
+  bool binary(binary_t &val) override {
+    onValue(json::binary(std::move(val)));
+    return true;
+  }
+
+  bool start_object(std::size_t) override {
+    onValue(json::object());
+    return true;
+  }
+
+  bool key(string_t &val) override {
+    m_Key = std::move(val);
+    return true;
+  }
+
+  bool end_object() override {
+    onEnd();
+    return true;
+  }
+
+  bool start_array(std::size_t) override {
+    onValue(json::array());
+    return true;
+  }
+
+  bool end_array() override {
+    onEnd();
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &,
+                   const json::exception &ex) override {
+    ispd_error("Model specification could not be parsed: %s", ex.what());
+    return false;
+  }
+
+  /// \brief Loads the remaining elements once the whole specification has
+  ///        been parsed.
+  ///
+  /// \note If a required section is missing, the program is immediately
+  ///       aborted.
+  auto finish() noexcept -> void {
+    // Checks if there is no users section in the model to be loaded.
+    if (!m_Listed[USERS])
+      ispd_error("Model must have `users` section.");
+
+    // Checks if there is no workloads section in the model to be loaded.
+    if (!m_Listed[WORKLOADS])
+      ispd_error("Model must have `%s` section.", MODEL_WORKLOADS_SECTION);
+
+    // Checks if there is no services section in the model to be loaded.
+    if (!m_ServicesListed)
+      ispd_error("Model must have `%s` section.", MODEL_SERVICES_SECTION);
+
+    // Checks if there is a missing subsection in the services section.
+    for (unsigned section = MASTERS; section < SECTION_COUNT; section++)
+      if (!m_Listed[section])
+        ispd_error("Services section must have `%s` subsection.",
+                   g_SectionKeys[section]);
+
+    // The sections that are not lists have no elements at all.
+    for (unsigned section = 0; section < SECTION_COUNT; section++)
+      m_Parsed[section] = true;
+    loadPending();
+
+    if (m_RoutingListed)
+      loadRouting(m_Routing);
+  }
+};
+
+/// \brief Parses the model specification, registering each element as it is
+///        validated and recording it in the specified snapshot.
+static auto parseModel(const std::string_view contents,
+                       ModelSnapshot &snapshot) noexcept -> void {
+  ModelSaxHandler handler;
+
+  g_Snapshot = &snapshot;
+
+  // The model is loaded as it is streamed from the contents.
+  if (json::sax_parse(contents.begin(), contents.end(), &handler))
+    handler.finish();
+
+  g_Snapshot = nullptr;
+  g_IdentifierToGid = {};
 }
 
-static auto loadServices(const json &data) noexcept -> void {
-  // Checks if there is no services section in the model to be loaded.
-  if (!data.contains(MODEL_SERVICES_SECTION))
-    ispd_error("Model must have `%s` section.", MODEL_SERVICES_SECTION);
+/// \brief Registers the elements recorded in the snapshot, in the same order
+///        in which they have been registered when the snapshot was taken.
+static auto replayModel(const ModelSnapshot &snapshot) noexcept -> void {
+  // The model identifiers are restored first, since they are already known
+  // if the model has just been parsed.
+  if (g_Identifiers.empty())
+    for (const auto &range : snapshot.getIdentifiers())
+      g_Identifiers.emplace_back(snapshot.getString(range));
+
+  // The number of services counts every service in the recorded ranges.
+  g_ServiceCount = snapshot.getMasters().size();
+
+  for (const auto &record : snapshot.getMachines())
+    g_ServiceCount += record.m_Count;
+  for (const auto &record : snapshot.getLinks())
+    g_ServiceCount += record.m_Count;
+  for (const auto &record : snapshot.getSwitches())
+    g_ServiceCount += record.m_Count;
+
+  for (const auto &record : snapshot.getUsers())
+    apply(snapshot, record);
+  for (const auto &record : snapshot.getWorkloads())
+    apply(snapshot, record);
+  for (const auto &record : snapshot.getMasters())
+    apply(snapshot, record);
+  for (const auto &record : snapshot.getMachines())
+    apply(snapshot, record);
+  for (const auto &record : snapshot.getLinks())
+    apply(snapshot, record);
+  for (const auto &record : snapshot.getSwitches())
+    apply(snapshot, record);
+  for (const auto &record : snapshot.getRoutings())
+    apply(snapshot, record);
+}
+
+/// \brief Parses the model specification and, if the model is materialized
+///        rank-locally, registers its elements once it has been parsed.
+static auto parseAndMaterializeModel(const std::string_view contents,
+                                     ModelSnapshot &snapshot) noexcept
+    -> void {
+  parseModel(contents, snapshot);
+
+  if (g_IsHosted)
+    replayModel(snapshot);
+}
+
+/// \brief Prints how many services have been materialized by this node.
+static auto reportMaterialization() noexcept -> void {
+  if (!g_IsHosted)
+    return;
+
+  std::size_t hostedCount = 0;
 
-  const auto &services = data[MODEL_SERVICES_SECTION];
+  for (tw_lpid gid = 0; gid < g_GidToType.size(); gid++)
+    hostedCount += isHosted(gid);
 
-  loadMasters(services);
-  loadMachines(services);
-  loadLinks(services);
-  loadSwitches(services);
+  ispd_info("The model has been materialized for %lu of %lu services at node "
+            "%lu.",
+            hostedCount, g_GidToType.size(), g_tw_mynode);
 }
 
-auto loadModel(const std::filesystem::path modelPath) noexcept -> void {
+/// \brief Checks if the services' global identifiers are dense, that is, if
+///        a service has been declared with every global identifier below the
+///        number of global identifiers. If not, the program is immediately
+///        aborted, since every logical process must have a type.
+static auto checkDenseIdentifiers() noexcept -> void {
+  // The services that have been referenced, but never declared, have been
+  // assigned a global identifier as well.
+  if (g_Identifiers.size() > g_GidToType.size())
+    g_GidToType.resize(g_Identifiers.size(), g_NoLogicalProcessType);
+
+  if (g_RegisteredServiceCount == g_GidToType.size())
+    return;
+
+  const tw_lpid gid =
+      std::find(g_GidToType.cbegin(), g_GidToType.cend(),
+                g_NoLogicalProcessType) -
+      g_GidToType.cbegin();
+
+  if (g_RemapIdentifiers)
+    ispd_error("Service %s has been referenced, but it has not been declared.",
+               g_Identifiers[gid].c_str());
+  ispd_error("The services' identifiers must be dense, but no service has "
+             "been declared with identifier %lu, while the largest identifier "
+             "is %lu. Enable the identifier remapping to use sparse "
+             "identifiers.",
+             gid, g_GidToType.size() - 1);
+}
+
+auto loadModel(const std::filesystem::path modelPath, const bool useSnapshot,
+               const HostPredicate &isHosted) noexcept -> void {
   // Checks if the specified model file path does not exists.
   if (!std::filesystem::exists(modelPath))
     ispd_error("Model path %s does not exists.", modelPath.c_str());
 
-  std::ifstream f(modelPath);
-  json data = json::parse(f);
+  const int fd = open(modelPath.c_str(), O_RDONLY);
+
+  // Checks if the model file could not be opened. If so, the program is
+  // immediately aborted.
+  if (fd < 0)
+    ispd_error("Model file %s could not be opened.", modelPath.c_str());
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0)
+    ispd_error("Model file %s could not be inspected.", modelPath.c_str());
+
+  const std::size_t size = st.st_size;
+
+  // Map the model file, such that it is hashed and parsed in place without
+  // being copied into a buffer first.
+  void *const mapping =
+      size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+
+  close(fd);
 
-  loadUsers(data);
-  loadWorkloads(data);
-  loadServices(data);
+  if (mapping == MAP_FAILED)
+    ispd_error("Model file %s could not be mapped.", modelPath.c_str());
+
+  const std::string_view contents(static_cast<const char *>(mapping), size);
+  g_IsHosted = isHosted ? &isHosted : nullptr;
+
+  std::filesystem::path snapshotPath = modelPath;
+  snapshotPath += ".snapshot";
+
+  ModelSnapshot snapshot;
+  const std::uint64_t hash =
+      useSnapshot ? ModelSnapshot::hash(contents.data(), size) : 0;
+  const std::uint64_t options =
+      g_RemapIdentifiers ? g_SnapshotRemappedIdentifiers : 0;
+
+  // Checks if a snapshot of this very model specification has already been
+  // taken. If so, the model is restored from the snapshot without parsing the
+  // specification at all.
+  if (useSnapshot && snapshot.load(snapshotPath, hash, size, options)) {
+    replayModel(snapshot);
+    ispd_info("Model has been restored from the snapshot %s.",
+              snapshotPath.c_str());
+  } else {
+    parseAndMaterializeModel(contents, snapshot);
+
+    // The snapshot is written by a single rank. If it could not be written,
+    // the model is parsed again in the next run.
+    if (useSnapshot && g_tw_mynode == 0 &&
+        !snapshot.save(snapshotPath, hash, size, options))
+      ispd_info("Model snapshot %s could not be written.",
+                snapshotPath.c_str());
+  }
+
+  if (mapping)
+    munmap(mapping, size);
+
+  checkDenseIdentifiers();
+  reportMaterialization();
+  g_IsHosted = nullptr;
+}
+
+auto loadModelFromMemory(const std::string_view contents,
+                         const HostPredicate &isHosted) noexcept -> void {
+  ModelSnapshot snapshot;
+
+  g_IsHosted = isHosted ? &isHosted : nullptr;
+  parseAndMaterializeModel(contents, snapshot);
+  checkDenseIdentifiers();
+  reportMaterialization();
+  g_IsHosted = nullptr;
+}
+
+auto enableIdentifierRemapping() noexcept -> void {
+  g_RemapIdentifiers = true;
 }
 
 [[nodiscard]] auto getLogicalProcessType(const tw_lpid gid) noexcept
     -> LogicalProcessType {
   /// Checks if no logical process type has been registered for the
   /// specified logical process global identifier.
-  if (g_GidToType.find(gid) == g_GidToType.cend())
+  if (gid >= g_GidToType.size() ||
+      g_GidToType[gid] == g_NoLogicalProcessType) [[unlikely]]
     ispd_error("getLogicalProcessType: Trying to fetch the logical process "
                "type to an unregistered identifier (%lu) at node (%lu).", gid, g_tw_mynode);
-  return g_GidToType.at(gid);
+  return static_cast<LogicalProcessType>(g_GidToType[gid]);
+}
+
+[[nodiscard]] auto getServicesSize() noexcept -> std::size_t {
+  return g_RegisteredServiceCount;
+}
+
+[[nodiscard]] auto getServiceIdentifier(const tw_lpid gid) -> std::string {
+  if (g_RemapIdentifiers && gid < g_Identifiers.size())
+    return g_Identifiers[gid];
+  return std::to_string(gid);
 }
 
-[[nodiscard]] auto getServicesSize() noexcept
-    -> std::unordered_map<tw_lpid, LogicalProcessType>::size_type {
-  return g_GidToType.size();
+[[nodiscard]] auto getWorkloads() noexcept
+    -> const std::unordered_map<tw_lpid, ispd::workload::Workload *> & {
+  return g_ModelLoader_Workloads;
 }
 
 } // namespace ispd::model_loader
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include <unistd.h>
+#include <fstream>
+#include <system_error>
+#include <ispd/model_loader/snapshot.hpp>
+
+namespace ispd::model_loader {
+
+namespace {
+
+/// \brief Returns the size in bytes of a section with the specified number of
+///        items, padded to a multiple of eight bytes.
+template <typename T>
+constexpr auto getSectionSize(const std::uint64_t count) noexcept
+    -> std::uint64_t {
+  return (count * sizeof(T) + 7) / 8 * 8;
+}
+
+/// \brief Writes the section, padded to a multiple of eight bytes.
+template <typename T>
+auto writeSection(std::ofstream &file, const T *const items,
+                  const std::uint64_t count) -> void {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "The snapshot records must be trivially copyable.");
+
+  constexpr char padding[8] = {};
+  const std::uint64_t size = count * sizeof(T);
+
+  file.write(reinterpret_cast<const char *>(items), size);
+  file.write(padding, getSectionSize<T>(count) - size);
+}
+
+/// \brief Reads the section, skipping its padding.
+template <typename T>
+auto readSection(std::ifstream &file, T *const items,
+                 const std::uint64_t count) -> void {
+  const std::uint64_t size = count * sizeof(T);
+
+  file.read(reinterpret_cast<char *>(items), size);
+  file.ignore(getSectionSize<T>(count) - size);
+}
+
+}; // namespace
+
+auto ModelSnapshot::save(const std::filesystem::path &path,
+                         const std::uint64_t sourceHash,
+                         const std::uint64_t sourceSize,
+                         const std::uint64_t options) const -> bool {
+  /// The temporary file is unique to this process, such that concurrent
+  /// writers do not write to the same file.
+  std::filesystem::path temporaryPath = path;
+  temporaryPath += ".tmp." + std::to_string(getpid());
+
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+      return false;
+
+    SnapshotHeader header;
+
+    std::memcpy(header.m_Magic, g_SnapshotMagic, sizeof(header.m_Magic));
+    header.m_Version = g_SnapshotVersion;
+    header.m_LpidWidth = sizeof(tw_lpid);
+    header.m_ByteOrder = g_SnapshotByteOrderMark;
+    header.m_SourceHash = sourceHash;
+    header.m_SourceSize = sourceSize;
+    header.m_Options = options;
+    header.m_Counts[0] = m_Users.size();
+    header.m_Counts[1] = m_Workloads.size();
+    header.m_Counts[2] = m_Masters.size();
+    header.m_Counts[3] = m_Machines.size();
+    header.m_Counts[4] = m_Links.size();
+    header.m_Counts[5] = m_Switches.size();
+    header.m_Counts[6] = m_Routings.size();
+    header.m_Counts[7] = m_Identifiers.size();
+    header.m_Counts[8] = m_Lpids.size();
+    header.m_Counts[9] = m_Strings.size();
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeSection(file, m_Users.data(), m_Users.size());
+    writeSection(file, m_Workloads.data(), m_Workloads.size());
+    writeSection(file, m_Masters.data(), m_Masters.size());
+    writeSection(file, m_Machines.data(), m_Machines.size());
+    writeSection(file, m_Links.data(), m_Links.size());
+    writeSection(file, m_Switches.data(), m_Switches.size());
+    writeSection(file, m_Routings.data(), m_Routings.size());
+    writeSection(file, m_Identifiers.data(), m_Identifiers.size());
+    writeSection(file, m_Lpids.data(), m_Lpids.size());
+    writeSection(file, m_Strings.data(), m_Strings.size());
+
+    if (!file) {
+      file.close();
+      std::filesystem::remove(temporaryPath);
+      return false;
+    }
+  }
+
+  /// Replace the previous snapshot, if any, at once.
+  std::error_code error;
+
+  std::filesystem::rename(temporaryPath, path, error);
+
+  if (error) {
+    std::filesystem::remove(temporaryPath, error);
+    return false;
+  }
+  return true;
+}
+
+auto ModelSnapshot::load(const std::filesystem::path &path,
+                         const std::uint64_t sourceHash,
+                         const std::uint64_t sourceSize,
+                         const std::uint64_t options) -> bool {
+  std::ifstream file(path, std::ios::binary);
+
+  if (!file.is_open())
+    return false;
+
+  SnapshotHeader header;
+
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      !header.matches(sourceHash, sourceSize, options))
+    return false;
+
+  const std::uint64_t *const counts = header.m_Counts;
+
+  /// Check if the file size matches the size described by its header, such
+  /// that a truncated snapshot is never read.
+  std::error_code error;
+  const std::uint64_t expectedSize =
+      sizeof(header) + getSectionSize<UserRecord>(counts[0]) +
+      getSectionSize<WorkloadRecord>(counts[1]) +
+      getSectionSize<MasterRecord>(counts[2]) +
+      getSectionSize<MachineRecord>(counts[3]) +
+      getSectionSize<LinkRecord>(counts[4]) +
+      getSectionSize<SwitchRecord>(counts[5]) +
+      getSectionSize<RoutingRecord>(counts[6]) +
+      getSectionSize<PoolRange>(counts[7]) +
+      getSectionSize<tw_lpid>(counts[8]) + getSectionSize<char>(counts[9]);
+
+  if (std::filesystem::file_size(path, error) != expectedSize || error)
+    return false;
+
+  m_Users.resize(counts[0]);
+  m_Workloads.resize(counts[1]);
+  m_Masters.resize(counts[2]);
+  m_Machines.resize(counts[3]);
+  m_Links.resize(counts[4]);
+  m_Switches.resize(counts[5]);
+  m_Routings.resize(counts[6]);
+  m_Identifiers.resize(counts[7]);
+  m_Lpids.resize(counts[8]);
+  m_Strings.resize(counts[9]);
+
+  readSection(file, m_Users.data(), counts[0]);
+  readSection(file, m_Workloads.data(), counts[1]);
+  readSection(file, m_Masters.data(), counts[2]);
+  readSection(file, m_Machines.data(), counts[3]);
+  readSection(file, m_Links.data(), counts[4]);
+  readSection(file, m_Switches.data(), counts[5]);
+  readSection(file, m_Routings.data(), counts[6]);
+  readSection(file, m_Identifiers.data(), counts[7]);
+  readSection(file, m_Lpids.data(), counts[8]);
+  readSection(file, m_Strings.data(), counts[9]);
+
+  if (!file) {
+    *this = ModelSnapshot();
+    return false;
+  }
+  return true;
+}
+
+auto ModelSnapshot::hash(const char *data, const std::size_t size)
+    -> std::uint64_t {
+  constexpr std::uint64_t prime = 0x100000001b3ULL;
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  std::size_t i = 0;
+
+  /// FNV-1a over 64-bit words, followed by the remaining bytes. The words are
+  /// mixed by a shift, such that their high bits reach the low bits.
+  for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+
+    std::memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * prime;
+    hash ^= hash >> 29;
+  }
+
+  for (; i < size; i++)
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * prime;
+
+  return hash;
+}
+
+}; // namespace ispd::model_loader
@@ -0,0 +1,330 @@
+#include <ross.h>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <ispd/model/builder.hpp>
+#include <ispd/routing/routing.hpp>
+#include <ispd/workload/workload.hpp>
+#include <ispd/model_loader/model_loader.hpp>
+#include <ispd/partitioning/event_rates.hpp>
+
+using ispd::model_loader::LogicalProcessType;
+
+namespace ispd::event_rates {
+
+namespace {
+
+/// \brief The minimum number of slaves whose routes are walked by each
+///        thread, such that small models are not split into useless shares.
+constexpr std::size_t g_MinSlavesPerThread = 4096;
+
+/// \brief The minimum number of masters whose shortest paths are searched by
+///        each thread.
+constexpr std::size_t g_MinMastersPerThread = 16;
+
+/// \struct Traffic
+///
+/// \brief The tasks accumulated by a single thread.
+struct Traffic final {
+  /// \brief The tasks sent through each link, indexed by its row.
+  std::vector<std::uint64_t> m_LinkTasks;
+
+  /// \brief The tasks delivered to each service, indexed by its global
+  ///        identifier.
+  std::vector<std::uint64_t> m_Delivered;
+};
+
+/// \brief Returns the `index`-th share of `count` items split through `parts`
+///        parts, as dealt by the round-robin scheduler from its first slave.
+constexpr auto share(const std::uint64_t count, const std::uint64_t parts,
+                     const std::uint64_t index) noexcept -> std::uint64_t {
+  return count / parts + (index < count % parts ? 1 : 0);
+}
+
+/// \brief Returns the tasks that the specified workload generates before the
+///        simulation ends.
+auto getTaskCount(const ispd::workload::Workload *const workload) noexcept
+    -> std::uint64_t {
+  if (!workload)
+    return 0;
+
+  const std::uint64_t remaining = workload->getRemainingTasks();
+  const double mean = workload->getInterarrivalMean();
+
+  /// The first task is generated at the beginning of the simulation and the
+  /// next ones are generated every interarrival mean, on average.
+  if (mean > 0.0 && std::isfinite(g_tw_ts_end)) {
+    const double arriving = std::floor(g_tw_ts_end / mean) + 1.0;
+
+    if (arriving < static_cast<double>(remaining))
+      return static_cast<std::uint64_t>(arriving);
+  }
+
+  return remaining;
+}
+
+/// \brief Returns true if the specified service forwards the tasks.
+auto isForwarding(const tw_lpid gid) -> bool {
+  const auto type = ispd::model_loader::getLogicalProcessType(gid);
+
+  return type == LogicalProcessType::SWITCH ||
+         type == LogicalProcessType::MACHINE;
+}
+
+/// \brief Accumulates the items `[0, itemCount)` in parallel.
+///
+/// The items are split into contiguous shares, one per thread, and each share
+/// is accumulated by `accumulate(first, last, traffic)` into its own traffic.
+/// Since the traffics are integers, their sum does not depend on the shares.
+template <typename Accumulate>
+auto accumulateInParallel(const std::size_t itemCount, unsigned threadCount,
+                          const std::size_t minItemsPerThread,
+                          const Accumulate &accumulate, Traffic &traffic)
+    -> void {
+  if (threadCount == 0)
+    threadCount = std::max(1U, std::thread::hardware_concurrency());
+  threadCount = static_cast<unsigned>(std::max<std::size_t>(
+      1, std::min<std::size_t>(threadCount, itemCount / minItemsPerThread)));
+
+  std::vector<Traffic> shares(threadCount);
+
+  const auto accumulateShare = [&](const unsigned i) {
+    shares[i].m_LinkTasks.assign(traffic.m_LinkTasks.size(), 0);
+    shares[i].m_Delivered.assign(traffic.m_Delivered.size(), 0);
+    accumulate(itemCount * i / threadCount, itemCount * (i + 1) / threadCount,
+               shares[i]);
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount - 1);
+
+  for (unsigned i = 1; i < threadCount; i++)
+    workers.emplace_back(accumulateShare, i);
+  accumulateShare(0);
+
+  for (auto &worker : workers)
+    worker.join();
+
+  for (const auto &share : shares) {
+    for (std::size_t row = 0; row < share.m_LinkTasks.size(); row++)
+      traffic.m_LinkTasks[row] += share.m_LinkTasks[row];
+    for (std::size_t gid = 0; gid < share.m_Delivered.size(); gid++)
+      traffic.m_Delivered[gid] += share.m_Delivered[gid];
+  }
+}
+
+/// \brief Accumulates the tasks sent through the routes served by the
+///        routing provider.
+///
+/// The work is split by slave instead of by master, since a single master
+/// may have most of the model's machines as its slaves.
+auto accumulateProvidedRoutes(const std::vector<std::uint64_t> &taskCounts,
+                              const unsigned threadCount, Traffic &traffic)
+    -> void {
+  const auto &masters = ispd::this_model::getMasters();
+  const auto &provider = ispd::routing_table::getProvider();
+
+  const auto accumulate = [&](const std::size_t first, const std::size_t last,
+                              Traffic &found) {
+    if (first >= last)
+      return;
+
+    std::size_t row = static_cast<std::size_t>(
+        std::upper_bound(masters.m_SlaveOffsets.cbegin(),
+                         masters.m_SlaveOffsets.cend(), first) -
+        masters.m_SlaveOffsets.cbegin() - 1);
+
+    for (std::size_t i = first; i < last; i++) {
+      while (i >= masters.m_SlaveOffsets[row + 1])
+        row++;
+
+      const tw_lpid master = masters.m_Gid[row];
+      const tw_lpid slave = masters.m_Slaves[i];
+      const std::uint64_t tasks =
+          share(taskCounts[row],
+                masters.m_SlaveOffsets[row + 1] - masters.m_SlaveOffsets[row],
+                i - masters.m_SlaveOffsets[row]);
+
+      if (tasks == 0 || !provider.hasRoute(master, slave))
+        continue;
+
+      const auto routes = provider.getRoutes(master, slave);
+
+      for (std::size_t k = 0; k < routes.size(); k++) {
+        const auto route = routes[k];
+        const std::uint64_t routeTasks = share(tasks, routes.size(), k);
+
+        for (std::size_t hop = 0; hop < route.getLength(); hop++) {
+          const auto linkRow = ispd::this_model::findLink(route.get(hop));
+
+          if (linkRow != ispd::model::g_NoServiceRow)
+            found.m_LinkTasks[linkRow] += routeTasks;
+        }
+      }
+
+      found.m_Delivered[slave] += tasks;
+    }
+  };
+
+  accumulateInParallel(masters.m_Slaves.size(), threadCount,
+                       g_MinSlavesPerThread, accumulate, traffic);
+}
+
+/// \brief Accumulates the tasks sent through the paths with the fewest hops
+///        from each master to its slaves.
+///
+/// The paths from a master are the tree of a breadth-first search, which
+/// stops as soon as all of its slaves have been reached. The tasks sent
+/// through a tree link are the tasks delivered below it, which are summed
+/// bottom-up.
+auto accumulateShortestPaths(const std::vector<std::uint64_t> &taskCounts,
+                             const std::size_t servicesSize,
+                             const unsigned threadCount, Traffic &traffic)
+    -> void {
+  const auto &links = ispd::this_model::getLinks();
+  const auto &masters = ispd::this_model::getMasters();
+
+  /// The links leaving each service, in the compressed sparse row layout.
+  std::vector<std::size_t> offsets(servicesSize + 1, 0);
+  std::vector<std::size_t> leaving(links.size());
+
+  for (std::size_t row = 0; row < links.size(); row++)
+    offsets[links.m_From[row] + 1]++;
+  for (std::size_t gid = 0; gid < servicesSize; gid++)
+    offsets[gid + 1] += offsets[gid];
+
+  std::vector<std::size_t> cursors(offsets.cbegin(), offsets.cend() - 1);
+
+  for (std::size_t row = 0; row < links.size(); row++)
+    leaving[cursors[links.m_From[row]]++] = row;
+
+  const auto accumulate = [&](const std::size_t first, const std::size_t last,
+                              Traffic &found) {
+    constexpr std::size_t noLink = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> parentLink(servicesSize, noLink);
+    std::vector<std::uint64_t> demand(servicesSize, 0);
+    std::vector<std::uint64_t> below(servicesSize, 0);
+    std::vector<tw_lpid> order;
+
+    for (std::size_t row = first; row < last; row++) {
+      const tw_lpid master = masters.m_Gid[row];
+      const std::size_t slaveCount =
+          masters.m_SlaveOffsets[row + 1] - masters.m_SlaveOffsets[row];
+      std::size_t pending = 0;
+
+      if (taskCounts[row] == 0)
+        continue;
+
+      for (std::size_t i = 0; i < slaveCount; i++) {
+        const tw_lpid slave =
+            masters.m_Slaves[masters.m_SlaveOffsets[row] + i];
+
+        if (slave == master || slave >= servicesSize)
+          continue;
+        if (demand[slave] == 0)
+          pending++;
+        demand[slave] += share(taskCounts[row], slaveCount, i);
+      }
+
+      /// Search the paths, in which only the switches and the machines may
+      /// forward the tasks.
+      order.assign(1, master);
+      parentLink[master] = noLink;
+
+      for (std::size_t head = 0; head < order.size() && pending > 0; head++) {
+        const tw_lpid at = order[head];
+
+        if (at != master && !isForwarding(at))
+          continue;
+
+        for (std::size_t i = offsets[at]; i < offsets[at + 1]; i++) {
+          const tw_lpid to = links.m_To[leaving[i]];
+
+          if (to == master || parentLink[to] != noLink)
+            continue;
+
+          parentLink[to] = leaving[i];
+          order.push_back(to);
+
+          if (demand[to] > 0 && --pending == 0)
+            break;
+        }
+      }
+
+      /// Sum the delivered tasks bottom-up, and clear the search.
+      for (std::size_t i = order.size() - 1; i > 0; i--) {
+        const tw_lpid at = order[i];
+        const std::size_t linkRow = parentLink[at];
+
+        below[at] += demand[at];
+        found.m_Delivered[at] += demand[at];
+        found.m_LinkTasks[linkRow] += below[at];
+        below[links.m_From[linkRow]] += below[at];
+
+        demand[at] = below[at] = 0;
+        parentLink[at] = noLink;
+      }
+
+      below[master] = 0;
+
+      /// Clear the demands of the slaves that have not been reached.
+      for (std::size_t i = masters.m_SlaveOffsets[row];
+           i < masters.m_SlaveOffsets[row + 1]; i++)
+        if (masters.m_Slaves[i] < servicesSize)
+          demand[masters.m_Slaves[i]] = 0;
+    }
+  };
+
+  accumulateInParallel(masters.size(), threadCount, g_MinMastersPerThread,
+                       accumulate, traffic);
+}
+
+}; // namespace
+
+auto estimate(const unsigned threadCount) -> EventEstimate {
+  const std::size_t servicesSize = ispd::model_loader::getServicesSize();
+  const auto &links = ispd::this_model::getLinks();
+  const auto &masters = ispd::this_model::getMasters();
+
+  std::vector<std::uint64_t> taskCounts(masters.size());
+
+  for (std::size_t row = 0; row < masters.size(); row++)
+    taskCounts[row] = getTaskCount(masters.m_Workload[row]);
+
+  Traffic traffic;
+
+  traffic.m_LinkTasks.assign(links.size(), 0);
+  traffic.m_Delivered.assign(servicesSize, 0);
+
+  if (ispd::routing_table::hasImplicitProvider())
+    accumulateProvidedRoutes(taskCounts, threadCount, traffic);
+  else
+    accumulateShortestPaths(taskCounts, servicesSize, threadCount, traffic);
+
+  EventEstimate estimate;
+
+  estimate.m_Events.assign(servicesSize, 0);
+
+  /// A master processes the generation of each of its tasks and the arrival
+  /// of its results.
+  for (std::size_t row = 0; row < masters.size(); row++)
+    estimate.m_Events[masters.m_Gid[row]] += 2 * taskCounts[row];
+
+  /// A link processes each task sent through it in both directions, as does
+  /// the service at which it arrives, unless the task is delivered to it.
+  for (std::size_t row = 0; row < links.size(); row++) {
+    estimate.m_Events[links.m_Gid[row]] += 2 * traffic.m_LinkTasks[row];
+    estimate.m_Events[links.m_To[row]] += 2 * traffic.m_LinkTasks[row];
+  }
+
+  for (std::size_t gid = 0; gid < servicesSize; gid++)
+    estimate.m_Events[gid] -=
+        std::min(estimate.m_Events[gid], traffic.m_Delivered[gid]);
+
+  estimate.m_LinkTasks = std::move(traffic.m_LinkTasks);
+  return estimate;
+}
+
+}; // namespace ispd::event_rates
@@ -0,0 +1,170 @@
+#include <ross.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <ispd/log/log.hpp>
+#include <ispd/model/builder.hpp>
+#include <ispd/model_loader/model_loader.hpp>
+#include <ispd/partitioning/lp_mapping.hpp>
+#include <ispd/partitioning/event_rates.hpp>
+#include <ispd/partitioning/partitioner.hpp>
+
+using ispd::partitioning::Edge;
+using ispd::partitioning::Graph;
+using ispd::partitioning::PartId;
+using ispd::partitioning::Vertex;
+using ispd::partitioning::Weight;
+
+namespace ispd::lp_mapping {
+
+namespace {
+
+/// \brief The processing element of each service, indexed by its global
+///        identifier, or empty if the partitioned mapping is not enabled.
+std::vector<PartId> g_Pes;
+
+/// \brief The services mapped to this processing element, sorted by their
+///        global identifiers, which are their local identifiers' order.
+std::vector<tw_lpid> g_LocalGids;
+
+/// \brief The local identifier of each service mapped to this processing
+///        element, indexed by its global identifier.
+std::vector<Vertex> g_LocalIndices;
+
+/// \brief Returns the graph of the loaded model's services, in which each
+///        link is connected to both of its ends.
+///
+/// Each service is weighted by the events it is expected to process, and
+/// each link end by the events expected to be sent through it, such that the
+/// partition balances the events processed by each PE and minimizes the
+/// remote ones. Every service and link end weighs at least one, such that the
+/// idle services are balanced as well.
+auto buildServiceGraph(const std::size_t servicesSize,
+                       const unsigned threadCount) -> Graph {
+  const auto &links = ispd::this_model::getLinks();
+  const auto estimate = ispd::event_rates::estimate(threadCount);
+  std::vector<Weight> vertexWeights(servicesSize);
+  std::vector<Edge> edges;
+
+  for (std::size_t gid = 0; gid < servicesSize; gid++)
+    vertexWeights[gid] = 1 + estimate.m_Events[gid];
+
+  edges.reserve(links.size() * 2);
+  for (std::size_t row = 0; row < links.size(); row++) {
+    const auto link = static_cast<Vertex>(links.m_Gid[row]);
+    const Weight weight = 1 + 2 * estimate.m_LinkTasks[row];
+
+    edges.push_back({link, static_cast<Vertex>(links.m_From[row]), weight});
+    edges.push_back({link, static_cast<Vertex>(links.m_To[row]), weight});
+  }
+
+  return Graph::build(std::move(vertexWeights), edges);
+}
+
+}; // namespace
+
+auto build(const tw_peid peCount, const double imbalance,
+           const unsigned threadCount) -> void {
+  const std::size_t servicesSize = ispd::model_loader::getServicesSize();
+
+  /// Checks if the services cannot be identified by the partitioner's
+  /// vertices. If so, the program is immediately aborted.
+  if (servicesSize >= std::numeric_limits<Vertex>::max())
+    ispd_error("The %lu services cannot be partitioned, since there are more "
+               "than %u.",
+               servicesSize, std::numeric_limits<Vertex>::max() - 1);
+
+  const Graph graph = buildServiceGraph(servicesSize, threadCount);
+  auto pes = ispd::partitioning::partition(
+      graph, static_cast<PartId>(peCount), imbalance, threadCount);
+
+  /// Checks if a processing element has been left with no service. If so,
+  /// the program is immediately aborted, since every processing element must
+  /// host at least one logical process.
+  std::vector<std::size_t> lpCounts(peCount, 0);
+
+  for (const PartId pe : pes)
+    lpCounts[pe]++;
+  for (tw_peid pe = 0; pe < peCount; pe++)
+    if (lpCounts[pe] == 0)
+      ispd_error("No service has been mapped to PE %lu, since there are only "
+                 "%lu services.",
+                 pe, servicesSize);
+
+  g_Pes = std::move(pes);
+  g_LocalGids.clear();
+  g_LocalGids.reserve(lpCounts[g_tw_mynode]);
+  g_LocalIndices.assign(servicesSize, std::numeric_limits<Vertex>::max());
+
+  for (std::size_t gid = 0; gid < servicesSize; gid++) {
+    if (g_Pes[gid] != g_tw_mynode)
+      continue;
+
+    g_LocalIndices[gid] = static_cast<Vertex>(g_LocalGids.size());
+    g_LocalGids.push_back(gid);
+  }
+
+  /// Only the master node reports the partition, which is the same in every
+  /// node, along with the edge cut and the imbalance of the block mapping it
+  /// replaces. Both are measured in the expected events.
+  if (g_tw_mynode)
+    return;
+
+  const std::size_t blockSize = (servicesSize + peCount - 1) / peCount;
+  std::vector<PartId> blocks(servicesSize);
+
+  for (std::size_t gid = 0; gid < servicesSize; gid++)
+    blocks[gid] = static_cast<PartId>(gid / blockSize);
+
+  ispd_info("The %lu services have been partitioned through %lu PEs (Edge "
+            "Cut: %lu, Block Mapping Edge Cut: %lu, Imbalance: %.3lf, Block "
+            "Mapping Imbalance: %.3lf).",
+            servicesSize, peCount,
+            ispd::partitioning::getEdgeCut(graph, g_Pes),
+            ispd::partitioning::getEdgeCut(graph, blocks),
+            ispd::partitioning::getImbalance(graph, g_Pes,
+                                             static_cast<PartId>(peCount)),
+            ispd::partitioning::getImbalance(graph, blocks,
+                                             static_cast<PartId>(peCount)));
+}
+
+auto isEnabled() noexcept -> bool { return !g_Pes.empty(); }
+
+auto getPe(const tw_lpid gid) noexcept -> tw_peid { return g_Pes[gid]; }
+
+auto getLocalLpCount() noexcept -> tw_lpid { return g_LocalGids.size(); }
+
+auto getLocalGid(const tw_lpid index) noexcept -> tw_lpid {
+  return g_LocalGids[index];
+}
+
+auto mapLocalLps() -> void {
+  const tw_lpid lpCount = g_LocalGids.size();
+
+  /// The LPs are evenly distributed through the kernel processes, as by the
+  /// ROSS linear mapping.
+  const tw_lpid lpsPerKp = static_cast<tw_lpid>(
+      std::ceil(static_cast<double>(lpCount) / static_cast<double>(g_tw_nkp)));
+
+  for (tw_kpid kp = 0, lp = 0; kp < g_tw_nkp; kp++) {
+    tw_kp_onpe(kp, g_tw_pe);
+
+    for (tw_lpid i = 0; i < lpsPerKp && lp < lpCount; i++, lp++) {
+      tw_lp_onpe(lp, g_tw_pe, g_LocalGids[lp]);
+      tw_lp_onkp(tw_getlp(lp), tw_getkp(kp));
+    }
+  }
+}
+
+auto getLocalLp(const tw_lpid gid) -> tw_lp * {
+  /// Checks if the service is not mapped to this processing element. If so,
+  /// the program is immediately aborted.
+  if (gid >= g_LocalIndices.size() ||
+      g_LocalIndices[gid] == std::numeric_limits<Vertex>::max()) [[unlikely]]
+    ispd_error("The LP with GID %lu is not mapped to PE %lu.", gid,
+               g_tw_mynode);
+
+  return tw_getlp(g_LocalIndices[gid]);
+}
+
+}; // namespace ispd::lp_mapping
@@ -0,0 +1,834 @@
+#include <array>
+#include <cmath>
+#include <deque>
+#include <queue>
+#include <limits>
+#include <thread>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include <ispd/log/log.hpp>
+#include <ispd/partitioning/partitioner.hpp>
+
+namespace ispd::partitioning {
+
+namespace {
+
+/// \brief The gain of moving a vertex to another part, which is the decrease
+///        of the edge cut.
+using Gain = std::int64_t;
+
+/// \brief The marker of an unmatched or unassigned vertex.
+constexpr Vertex g_NoVertex = std::numeric_limits<Vertex>::max();
+
+/// \brief The number of vertices below which a graph is not coarsened.
+constexpr std::size_t g_CoarsestSize = 256;
+
+/// \brief The number of seeds from which the coarsest graph is bisected.
+constexpr unsigned g_InitialTries = 8;
+
+/// \brief The maximum number of Fiduccia-Mattheyses passes at each level.
+constexpr unsigned g_RefinementPasses = 8;
+
+/// \brief The number of consecutive moves that have not improved the
+///        bisection after which a Fiduccia-Mattheyses pass is stopped.
+constexpr std::size_t g_MaxFruitlessMoves = 128;
+
+/// \brief The maximum number of greedy k-way refinement passes.
+constexpr unsigned g_KWayPasses = 4;
+
+/// \class Random
+///
+/// \brief A xorshift pseudorandom generator, which gives the same sequence in
+///        every rank, such that the partitioning is deterministic.
+class Random {
+  std::uint64_t m_State;
+
+public:
+  explicit Random(const std::uint64_t seed) noexcept
+      : m_State((seed * 0x9E3779B97F4A7C15ULL) | 1) {}
+
+  [[nodiscard]] auto next() noexcept -> std::uint64_t {
+    m_State ^= m_State << 13;
+    m_State ^= m_State >> 7;
+    m_State ^= m_State << 17;
+    return m_State;
+  }
+
+  /// \brief Returns a pseudorandom permutation of `[0, n)`.
+  [[nodiscard]] auto permutation(const std::size_t n) -> std::vector<Vertex> {
+    std::vector<Vertex> order(n);
+
+    std::iota(order.begin(), order.end(), Vertex{0});
+    /// The index is drawn by a multiplication instead of a division, since
+    /// `n` fits in 32 bits.
+    for (std::size_t i = n; i > 1; i--)
+      std::swap(order[i - 1], order[((next() >> 32) * i) >> 32]);
+    return order;
+  }
+};
+
+/// \brief The maximum weight of each side of a bisection.
+using SideWeights = std::array<Weight, 2>;
+
+/// \brief Returns the weight by which the sides exceed their maximum weights.
+auto getOverweight(const SideWeights &weights,
+                   const SideWeights &maxWeights) noexcept -> Weight {
+  Weight overweight = 0;
+
+  for (int side = 0; side < 2; side++)
+    if (weights[side] > maxWeights[side])
+      overweight += weights[side] - maxWeights[side];
+  return overweight;
+}
+
+/// \brief Returns the weights of the sides of the specified bisection.
+auto getSideWeights(const Graph &graph,
+                    const std::vector<std::uint8_t> &sides) noexcept
+    -> SideWeights {
+  SideWeights weights = {0, 0};
+
+  for (std::size_t v = 0; v < graph.size(); v++)
+    weights[sides[v]] += graph.m_VertexWeights[v];
+  return weights;
+}
+
+/// \brief Returns the edge cut of the specified bisection.
+auto getSideCut(const Graph &graph,
+                const std::vector<std::uint8_t> &sides) noexcept -> Weight {
+  Weight cut = 0;
+
+  for (std::size_t v = 0; v < graph.size(); v++)
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++)
+      if (sides[graph.m_Adjacency[i]] != sides[v])
+        cut += graph.m_EdgeWeights[i];
+  return cut / 2;
+}
+
+/// \brief Coarsens the specified graph by collapsing a matching of its
+///        vertices.
+///
+/// Each vertex is matched with the unmatched neighbor to which it has the
+/// heaviest edge, unless their weights sum more than the specified maximum.
+/// The vertices are visited in their order rather than in a random one, which
+/// keeps the rows of the coarse graphs near each other in memory, since the
+/// related services usually have close identifiers. The vertices left unmatched with a
+/// single neighbor are then matched with each other if they share their
+/// neighbor, such that star-like graphs, whose leaves cannot be matched with
+/// the hub, are coarsened as well.
+///
+/// \param coarseOf The coarse vertex of each vertex.
+auto coarsen(const Graph &graph, const Weight maxVertexWeight,
+             std::vector<Vertex> &coarseOf) -> Graph {
+  const std::size_t n = graph.size();
+  const auto &weights = graph.m_VertexWeights;
+  std::vector<Vertex> match(n, g_NoVertex);
+
+  for (Vertex v = 0; v < n; v++) {
+    if (match[v] != g_NoVertex)
+      continue;
+
+    Vertex best = v;
+    Weight bestWeight = 0;
+
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++) {
+      const Vertex u = graph.m_Adjacency[i];
+
+      if (match[u] == g_NoVertex && graph.m_EdgeWeights[i] > bestWeight &&
+          weights[v] + weights[u] <= maxVertexWeight) {
+        best = u;
+        bestWeight = graph.m_EdgeWeights[i];
+      }
+    }
+
+    match[v] = best;
+    match[best] = v;
+  }
+
+  /// Match the unmatched leaves that share their neighbor.
+  std::vector<Vertex> pendingLeaf(n, g_NoVertex);
+
+  for (Vertex v = 0; v < n; v++) {
+    if (match[v] != v || graph.m_Offsets[v + 1] - graph.m_Offsets[v] != 1)
+      continue;
+
+    const Vertex hub = graph.m_Adjacency[graph.m_Offsets[v]];
+    const Vertex leaf = pendingLeaf[hub];
+
+    if (leaf != g_NoVertex && weights[v] + weights[leaf] <= maxVertexWeight) {
+      match[v] = leaf;
+      match[leaf] = v;
+      pendingLeaf[hub] = g_NoVertex;
+    } else {
+      pendingLeaf[hub] = v;
+    }
+  }
+
+  /// Number the coarse vertices in the order of their first fine vertex.
+  std::vector<Vertex> representatives;
+
+  coarseOf.assign(n, g_NoVertex);
+  for (Vertex v = 0; v < n; v++) {
+    if (coarseOf[v] != g_NoVertex)
+      continue;
+
+    coarseOf[v] = coarseOf[match[v]] =
+        static_cast<Vertex>(representatives.size());
+    representatives.push_back(v);
+  }
+
+  /// Build the coarse graph. The edges between the same coarse vertices are
+  /// merged, which are found by the slot of each neighbor in the current
+  /// row, such that the slots need not be reset between rows.
+  const std::size_t coarseCount = representatives.size();
+  constexpr std::uint64_t noSlot = std::numeric_limits<std::uint64_t>::max();
+  std::vector<std::uint64_t> slots(coarseCount, noSlot);
+  Graph coarse;
+
+  coarse.m_VertexWeights.reserve(coarseCount);
+  coarse.m_Offsets.reserve(coarseCount + 1);
+  coarse.m_Adjacency.reserve(graph.m_Adjacency.size() / 2);
+  coarse.m_EdgeWeights.reserve(graph.m_Adjacency.size() / 2);
+
+  for (Vertex c = 0; c < coarseCount; c++) {
+    const Vertex v = representatives[c];
+    const Vertex members[2] = {v, match[v]};
+    const std::uint64_t rowBegin = coarse.m_Adjacency.size();
+
+    coarse.m_VertexWeights.push_back(weights[v] +
+                                     (match[v] != v ? weights[match[v]] : 0));
+
+    for (int m = 0; m < (match[v] != v ? 2 : 1); m++) {
+      const Vertex w = members[m];
+
+      for (auto i = graph.m_Offsets[w]; i < graph.m_Offsets[w + 1]; i++) {
+        const Vertex neighbor = coarseOf[graph.m_Adjacency[i]];
+
+        if (neighbor == c)
+          continue;
+
+        if (slots[neighbor] != noSlot && slots[neighbor] >= rowBegin) {
+          coarse.m_EdgeWeights[slots[neighbor]] += graph.m_EdgeWeights[i];
+        } else {
+          slots[neighbor] = coarse.m_Adjacency.size();
+          coarse.m_Adjacency.push_back(neighbor);
+          coarse.m_EdgeWeights.push_back(graph.m_EdgeWeights[i]);
+        }
+      }
+    }
+
+    coarse.m_Offsets.push_back(coarse.m_Adjacency.size());
+  }
+
+  return coarse;
+}
+
+/// \brief Refines the specified bisection by Fiduccia-Mattheyses passes.
+///
+/// Each pass moves the boundary vertices one by one, each time the one with
+/// the highest gain from a side that may be left, locking the moved vertices.
+/// The pass is stopped once many moves have not improved the bisection, and
+/// the moves after the best bisection found are undone. A bisection is better
+/// than another if its sides exceed their maximum weights by less or, if
+/// equally, if its edge cut is lighter.
+auto refine(const Graph &graph, std::vector<std::uint8_t> &sides,
+            const SideWeights &maxWeights) -> void {
+  using Entry = std::pair<Gain, Vertex>;
+
+  const std::size_t n = graph.size();
+  const auto &weights = graph.m_VertexWeights;
+  std::vector<Gain> gains(n);
+  std::vector<std::uint8_t> locked(n);
+  std::vector<Vertex> moves;
+  SideWeights sideWeights = getSideWeights(graph, sides);
+
+  for (unsigned pass = 0; pass < g_RefinementPasses; pass++) {
+    std::priority_queue<Entry> queues[2];
+
+    for (Vertex v = 0; v < n; v++) {
+      Gain gain = 0;
+      bool boundary = false;
+
+      for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++) {
+        const Gain weight = static_cast<Gain>(graph.m_EdgeWeights[i]);
+
+        if (sides[graph.m_Adjacency[i]] == sides[v]) {
+          gain -= weight;
+        } else {
+          gain += weight;
+          boundary = true;
+        }
+      }
+
+      gains[v] = gain;
+      locked[v] = 0;
+      if (boundary)
+        queues[sides[v]].push({gain, v});
+    }
+
+    /// The overweight sides' vertices are moved even if they are not in the
+    /// boundary.
+    for (int side = 0; side < 2; side++)
+      if (sideWeights[side] > maxWeights[side])
+        for (Vertex v = 0; v < n; v++)
+          if (sides[v] == side)
+            queues[side].push({gains[v], v});
+
+    Gain gained = 0, bestGained = 0;
+    Weight bestOverweight = getOverweight(sideWeights, maxWeights);
+    std::size_t bestMoveCount = 0, fruitlessMoves = 0;
+
+    moves.clear();
+
+    while (fruitlessMoves < g_MaxFruitlessMoves) {
+      /// Discard the stale entries, whose vertex has been locked or whose
+      /// gain has changed since they have been pushed.
+      for (int side = 0; side < 2; side++)
+        while (!queues[side].empty()) {
+          const auto [gain, v] = queues[side].top();
+
+          if (!locked[v] && sides[v] == side && gains[v] == gain)
+            break;
+          queues[side].pop();
+        }
+
+      /// Decide the side from which a vertex is moved. An overweight side is
+      /// always left, and, otherwise, the vertex with the highest gain whose
+      /// move keeps the other side within its maximum weight is moved.
+      int from = -1;
+
+      if (sideWeights[0] > maxWeights[0] && !queues[0].empty())
+        from = 0;
+      else if (sideWeights[1] > maxWeights[1] && !queues[1].empty())
+        from = 1;
+      else {
+        for (int side = 0; side < 2; side++) {
+          if (queues[side].empty())
+            continue;
+
+          const auto [gain, v] = queues[side].top();
+
+          if (sideWeights[1 - side] + weights[v] > maxWeights[1 - side]) {
+            /// The vertex does not fit in the other side. It is discarded
+            /// in this pass, unless its gain changes.
+            queues[side].pop();
+            from = -2;
+            break;
+          }
+
+          if (from < 0 || gain > queues[from].top().first)
+            from = side;
+        }
+
+        if (from == -2)
+          continue;
+      }
+
+      if (from < 0)
+        break;
+
+      const Vertex v = queues[from].top().second;
+      const int to = 1 - from;
+
+      queues[from].pop();
+      sides[v] = static_cast<std::uint8_t>(to);
+      sideWeights[from] -= weights[v];
+      sideWeights[to] += weights[v];
+      locked[v] = 1;
+      gained += gains[v];
+      moves.push_back(v);
+
+      for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++) {
+        const Vertex u = graph.m_Adjacency[i];
+        const Gain weight = static_cast<Gain>(graph.m_EdgeWeights[i]);
+
+        if (locked[u])
+          continue;
+
+        gains[u] += sides[u] == to ? -2 * weight : 2 * weight;
+        queues[sides[u]].push({gains[u], u});
+      }
+
+      const Weight overweight = getOverweight(sideWeights, maxWeights);
+
+      if (overweight < bestOverweight ||
+          (overweight == bestOverweight && gained > bestGained)) {
+        bestOverweight = overweight;
+        bestGained = gained;
+        bestMoveCount = moves.size();
+        fruitlessMoves = 0;
+      } else {
+        fruitlessMoves++;
+      }
+    }
+
+    /// Undo the moves after the best bisection.
+    for (std::size_t i = moves.size(); i-- > bestMoveCount;) {
+      const Vertex v = moves[i];
+
+      sideWeights[sides[v]] -= weights[v];
+      sides[v] ^= 1;
+      sideWeights[sides[v]] += weights[v];
+    }
+
+    if (bestMoveCount == 0)
+      break;
+  }
+}
+
+/// \brief Bisects the specified graph by growing the first side from the
+///        specified seed, each time adding the vertex whose addition cuts the
+///        lightest edges, until it weighs its target weight.
+auto grow(const Graph &graph, const Vertex seed, const Weight targetWeight,
+          std::vector<std::uint8_t> &sides) -> void {
+  using Entry = std::pair<Gain, Vertex>;
+
+  const std::size_t n = graph.size();
+  std::vector<Gain> gains(n);
+  std::priority_queue<Entry> frontier;
+  Weight weight = 0;
+  Vertex nextUnvisited = 0;
+
+  sides.assign(n, 1);
+  for (Vertex v = 0; v < n; v++) {
+    Gain gain = 0;
+
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++)
+      gain -= static_cast<Gain>(graph.m_EdgeWeights[i]);
+    gains[v] = gain;
+  }
+
+  frontier.push({gains[seed], seed});
+
+  while (weight < targetWeight) {
+    Vertex v = g_NoVertex;
+
+    while (!frontier.empty()) {
+      const auto [gain, u] = frontier.top();
+
+      frontier.pop();
+      if (sides[u] == 1 && gains[u] == gain) {
+        v = u;
+        break;
+      }
+    }
+
+    /// If the seed's component has been exhausted, the growth continues from
+    /// the next vertex not added yet.
+    if (v == g_NoVertex) {
+      while (nextUnvisited < n && sides[nextUnvisited] == 0)
+        nextUnvisited++;
+      if (nextUnvisited == n)
+        break;
+      v = nextUnvisited;
+    }
+
+    sides[v] = 0;
+    weight += graph.m_VertexWeights[v];
+
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++) {
+      const Vertex u = graph.m_Adjacency[i];
+
+      if (sides[u] == 0)
+        continue;
+
+      gains[u] += 2 * static_cast<Gain>(graph.m_EdgeWeights[i]);
+      frontier.push({gains[u], u});
+    }
+  }
+}
+
+/// \brief Bisects the specified graph, such that the first side weighs the
+///        specified fraction of the total weight.
+auto bisect(const Graph &graph, const double fraction, const double imbalance,
+            Random &random) -> std::vector<std::uint8_t> {
+  const Weight totalWeight = graph.getTotalVertexWeight();
+  const Weight firstTarget =
+      static_cast<Weight>(std::llround(static_cast<double>(totalWeight) *
+                                       fraction));
+  const SideWeights targets = {firstTarget, totalWeight - firstTarget};
+  SideWeights maxWeights;
+
+  for (int side = 0; side < 2; side++)
+    maxWeights[side] =
+        targets[side] + static_cast<Weight>(static_cast<double>(targets[side]) *
+                                            imbalance);
+
+  /// Coarsen the graph until it is small enough or until the coarsening does
+  /// not reduce it enough. No coarse vertex may weigh much more than the
+  /// vertices of a graph with the coarsest size and the same total weight,
+  /// such that the coarsest graph can still be balanced.
+  const Weight maxVertexWeight =
+      std::max<Weight>(1, totalWeight * 3 / (2 * g_CoarsestSize));
+  std::deque<Graph> levels;
+  std::deque<std::vector<Vertex>> coarseOfs;
+  const Graph *current = &graph;
+
+  while (current->size() > g_CoarsestSize) {
+    std::vector<Vertex> coarseOf;
+    Graph coarse = coarsen(*current, maxVertexWeight, coarseOf);
+
+    if (coarse.size() * 20 > current->size() * 19)
+      break;
+
+    levels.push_back(std::move(coarse));
+    coarseOfs.push_back(std::move(coarseOf));
+    current = &levels.back();
+  }
+
+  /// Bisect the coarsest graph from several seeds, keeping the best
+  /// bisection.
+  std::vector<std::uint8_t> sides, candidate;
+  Weight bestOverweight = 0, bestCut = 0;
+  const auto seeds = random.permutation(current->size());
+
+  for (unsigned i = 0; i < g_InitialTries && i < seeds.size(); i++) {
+    grow(*current, seeds[i], targets[0], candidate);
+    refine(*current, candidate, maxWeights);
+
+    const Weight overweight =
+        getOverweight(getSideWeights(*current, candidate), maxWeights);
+    const Weight cut = getSideCut(*current, candidate);
+
+    if (sides.empty() || overweight < bestOverweight ||
+        (overweight == bestOverweight && cut < bestCut)) {
+      sides.swap(candidate);
+      bestOverweight = overweight;
+      bestCut = cut;
+    }
+  }
+
+  /// Project the bisection back to the finer levels, refining it at each.
+  for (std::size_t level = levels.size(); level-- > 0;) {
+    const Graph &finer = level == 0 ? graph : levels[level - 1];
+    const auto &coarseOf = coarseOfs[level];
+
+    candidate.resize(finer.size());
+    for (std::size_t v = 0; v < finer.size(); v++)
+      candidate[v] = sides[coarseOf[v]];
+    sides.swap(candidate);
+
+    levels.pop_back();
+    refine(finer, sides, maxWeights);
+  }
+
+  return sides;
+}
+
+/// \brief Returns the subgraph induced by the vertices of the specified side.
+///
+/// \param vertices The original vertex of each vertex of the graph.
+/// \param subVertices The original vertex of each vertex of the subgraph.
+auto extract(const Graph &graph, const std::vector<std::uint8_t> &sides,
+             const std::uint8_t side, const std::vector<Vertex> &vertices,
+             std::vector<Vertex> &subVertices) -> Graph {
+  const std::size_t n = graph.size();
+  std::vector<Vertex> subIds(n, g_NoVertex);
+  Graph subgraph;
+
+  std::uint64_t entryCount = 0;
+
+  subVertices.clear();
+  for (Vertex v = 0; v < n; v++) {
+    if (sides[v] != side)
+      continue;
+
+    subIds[v] = static_cast<Vertex>(subVertices.size());
+    subVertices.push_back(vertices[v]);
+    subgraph.m_VertexWeights.push_back(graph.m_VertexWeights[v]);
+
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++)
+      entryCount += sides[graph.m_Adjacency[i]] == side;
+  }
+
+  subgraph.m_Offsets.reserve(subVertices.size() + 1);
+  subgraph.m_Adjacency.reserve(entryCount);
+  subgraph.m_EdgeWeights.reserve(entryCount);
+  for (Vertex v = 0; v < n; v++) {
+    if (sides[v] != side)
+      continue;
+
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++) {
+      const Vertex u = graph.m_Adjacency[i];
+
+      if (sides[u] == side) {
+        subgraph.m_Adjacency.push_back(subIds[u]);
+        subgraph.m_EdgeWeights.push_back(graph.m_EdgeWeights[i]);
+      }
+    }
+
+    subgraph.m_Offsets.push_back(subgraph.m_Adjacency.size());
+  }
+
+  return subgraph;
+}
+
+/// \brief Partitions the specified graph into the parts
+///        `[firstPart, firstPart + partCount)` by recursive bisection.
+///
+/// The two halves of a bisection are partitioned concurrently while there
+/// are threads left. Each bisection draws from its own generator, seeded by
+/// its parts, such that the partition does not depend on the threads.
+auto partitionRecursively(const Graph &graph,
+                          const std::vector<Vertex> &vertices,
+                          const PartId firstPart, const PartId partCount,
+                          const double imbalance, const unsigned threadCount,
+                          std::vector<PartId> &parts) -> void {
+  if (partCount == 1 || graph.size() == 0) {
+    for (const Vertex v : vertices)
+      parts[v] = firstPart;
+    return;
+  }
+
+  const PartId firstCount = partCount / 2;
+  Random random((static_cast<std::uint64_t>(firstPart) << 32) | partCount);
+  const auto sides = bisect(graph, static_cast<double>(firstCount) / partCount,
+                            imbalance, random);
+
+  const auto partitionSide = [&](const std::uint8_t side,
+                                 const unsigned sideThreadCount) {
+    std::vector<Vertex> subVertices;
+    const Graph subgraph = extract(graph, sides, side, vertices, subVertices);
+
+    partitionRecursively(subgraph, subVertices,
+                         side == 0 ? firstPart : firstPart + firstCount,
+                         side == 0 ? firstCount : partCount - firstCount,
+                         imbalance, sideThreadCount, parts);
+  };
+
+  if (threadCount > 1) {
+    std::thread worker(partitionSide, 0, threadCount / 2);
+
+    partitionSide(1, threadCount - threadCount / 2);
+    worker.join();
+  } else {
+    partitionSide(0, 1);
+    partitionSide(1, 1);
+  }
+}
+
+/// \brief Refines the specified k-way partition by greedy passes.
+///
+/// Each boundary vertex is moved to the neighboring part to which it has the
+/// heaviest edges, if it decreases the edge cut, or if it does not increase
+/// the edge cut but moves the vertex to a lighter part, and if the part does
+/// not exceed the maximum weight. The vertices of the overweight parts are
+/// moved even if the edge cut is increased.
+auto refineKWay(const Graph &graph, std::vector<PartId> &parts,
+                const PartId partCount, const double imbalance) -> void {
+  const std::size_t n = graph.size();
+  const auto &weights = graph.m_VertexWeights;
+  std::vector<Weight> partWeights(partCount, 0);
+  std::vector<std::size_t> partSizes(partCount, 0);
+
+  for (std::size_t v = 0; v < n; v++) {
+    partWeights[parts[v]] += weights[v];
+    partSizes[parts[v]]++;
+  }
+
+  const Weight averageWeight =
+      (graph.getTotalVertexWeight() + partCount - 1) / partCount;
+  const Weight maxWeight =
+      averageWeight +
+      static_cast<Weight>(static_cast<double>(averageWeight) * imbalance);
+
+  std::vector<Weight> connectivity(partCount, 0);
+  std::vector<PartId> touched;
+
+  for (unsigned pass = 0; pass < g_KWayPasses; pass++) {
+    std::size_t moveCount = 0;
+
+    for (std::size_t v = 0; v < n; v++) {
+      const PartId from = parts[v];
+
+      /// A part must not be emptied.
+      if (partSizes[from] == 1)
+        continue;
+
+      touched.clear();
+      for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++) {
+        const PartId part = parts[graph.m_Adjacency[i]];
+
+        if (connectivity[part] == 0)
+          touched.push_back(part);
+        connectivity[part] += graph.m_EdgeWeights[i];
+      }
+
+      const Gain internal = static_cast<Gain>(connectivity[from]);
+      const bool overweight = partWeights[from] > maxWeight;
+      PartId to = from;
+      Gain bestGain = std::numeric_limits<Gain>::min();
+
+      for (const PartId part : touched) {
+        if (part == from || partWeights[part] + weights[v] > maxWeight)
+          continue;
+
+        const Gain gain = static_cast<Gain>(connectivity[part]) - internal;
+
+        if (gain > bestGain ||
+            (gain == bestGain && partWeights[part] < partWeights[to]))
+          to = part, bestGain = gain;
+      }
+
+      /// A vertex of an overweight part with no neighboring part to which it
+      /// fits is moved to the lightest part.
+      if (overweight && to == from) {
+        const PartId lightest = static_cast<PartId>(
+            std::min_element(partWeights.cbegin(), partWeights.cend()) -
+            partWeights.cbegin());
+
+        if (partWeights[lightest] + weights[v] <= maxWeight) {
+          to = lightest;
+          bestGain = -internal;
+        }
+      }
+
+      for (const PartId part : touched)
+        connectivity[part] = 0;
+
+      if (to == from)
+        continue;
+
+      if (overweight || bestGain > 0 ||
+          (bestGain == 0 && partWeights[to] + weights[v] < partWeights[from])) {
+        parts[v] = to;
+        partWeights[from] -= weights[v];
+        partWeights[to] += weights[v];
+        partSizes[from]--;
+        partSizes[to]++;
+        moveCount++;
+      }
+    }
+
+    if (moveCount == 0)
+      break;
+  }
+}
+
+}; // namespace
+
+auto Graph::build(std::vector<Weight> vertexWeights,
+                  const std::vector<Edge> &edges) -> Graph {
+  const std::size_t n = vertexWeights.size();
+  std::vector<std::uint64_t> offsets(n + 1, 0);
+
+  for (const Edge &edge : edges) {
+    /// Checks if an edge refers to an unknown vertex. If so, the program is
+    /// immediately aborted.
+    if (edge.m_First >= n || edge.m_Second >= n)
+      ispd_error("An edge between %u and %u refers to an unknown vertex.",
+                 edge.m_First, edge.m_Second);
+
+    if (edge.m_First != edge.m_Second) {
+      offsets[edge.m_First + 1]++;
+      offsets[edge.m_Second + 1]++;
+    }
+  }
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  /// Scatter the edges in both directions into their rows.
+  std::vector<std::pair<Vertex, Weight>> entries(offsets[n]);
+  std::vector<std::uint64_t> next(offsets.cbegin(), offsets.cend() - 1);
+
+  for (const Edge &edge : edges) {
+    if (edge.m_First == edge.m_Second)
+      continue;
+
+    entries[next[edge.m_First]++] = {edge.m_Second, edge.m_Weight};
+    entries[next[edge.m_Second]++] = {edge.m_First, edge.m_Weight};
+  }
+
+  /// Sort each row by neighbor, merging the parallel edges.
+  Graph graph;
+
+  graph.m_Offsets.reserve(n + 1);
+  graph.m_Adjacency.reserve(entries.size());
+  graph.m_EdgeWeights.reserve(entries.size());
+
+  for (std::size_t v = 0; v < n; v++) {
+    const auto first = entries.begin() + offsets[v];
+    const auto last = entries.begin() + offsets[v + 1];
+
+    std::sort(first, last);
+
+    for (auto it = first; it != last; ++it) {
+      if (it != first && it->first == (it - 1)->first)
+        graph.m_EdgeWeights.back() += it->second;
+      else {
+        graph.m_Adjacency.push_back(it->first);
+        graph.m_EdgeWeights.push_back(it->second);
+      }
+    }
+
+    graph.m_Offsets.push_back(graph.m_Adjacency.size());
+  }
+
+  graph.m_VertexWeights = std::move(vertexWeights);
+  return graph;
+}
+
+auto Graph::getTotalVertexWeight() const noexcept -> Weight {
+  return std::accumulate(m_VertexWeights.cbegin(), m_VertexWeights.cend(),
+                         Weight{0});
+}
+
+auto partition(const Graph &graph, const PartId partCount,
+               const double imbalance, unsigned threadCount)
+    -> std::vector<PartId> {
+  /// Checks if no part has been requested. If so, the program is immediately
+  /// aborted.
+  if (partCount == 0)
+    ispd_error("A graph cannot be partitioned into zero parts.");
+
+  std::vector<PartId> parts(graph.size(), 0);
+
+  if (partCount == 1)
+    return parts;
+
+  /// The imbalance of the nested bisections compounds. Therefore, each
+  /// bisection tolerates a share of the imbalance, such that the leaf parts
+  /// are within the tolerated imbalance.
+  const double depth = std::ceil(std::log2(static_cast<double>(partCount)));
+  const double bisectionImbalance = std::pow(1.0 + imbalance, 1.0 / depth) - 1.0;
+  std::vector<Vertex> vertices(graph.size());
+
+  if (threadCount == 0)
+    threadCount = std::max(1U, std::thread::hardware_concurrency());
+
+  std::iota(vertices.begin(), vertices.end(), Vertex{0});
+  partitionRecursively(graph, vertices, 0, partCount, bisectionImbalance,
+                       threadCount, parts);
+  refineKWay(graph, parts, partCount, imbalance);
+  return parts;
+}
+
+auto getEdgeCut(const Graph &graph, const std::vector<PartId> &parts) noexcept
+    -> Weight {
+  Weight cut = 0;
+
+  for (std::size_t v = 0; v < graph.size(); v++)
+    for (auto i = graph.m_Offsets[v]; i < graph.m_Offsets[v + 1]; i++)
+      if (parts[graph.m_Adjacency[i]] != parts[v])
+        cut += graph.m_EdgeWeights[i];
+  return cut / 2;
+}
+
+auto getImbalance(const Graph &graph, const std::vector<PartId> &parts,
+                  const PartId partCount) -> double {
+  std::vector<Weight> partWeights(partCount, 0);
+
+  for (std::size_t v = 0; v < graph.size(); v++)
+    partWeights[parts[v]] += graph.m_VertexWeights[v];
+
+  const double averageWeight =
+      static_cast<double>(graph.getTotalVertexWeight()) / partCount;
+
+  if (averageWeight == 0.0)
+    return 1.0;
+  return static_cast<double>(
+             *std::max_element(partWeights.cbegin(), partWeights.cend())) /
+         averageWeight;
+}
+
+}; // namespace ispd::partitioning
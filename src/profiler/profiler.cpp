@@ -0,0 +1,173 @@
+#include <mpi.h>
+#include <ross.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <ispd/log/log.hpp>
+#include <ispd/profiler/profiler.hpp>
+
+namespace ispd::profiler {
+
+namespace {
+
+/// \brief The number of measures of each phase.
+constexpr std::size_t g_MeasureCount = 3;
+
+/// \brief A startup phase, as measured by this rank.
+struct Phase final {
+  std::string m_Name;
+  double m_Measures[g_MeasureCount]; ///< The wall time (in seconds), the peak
+                                     ///< RSS growth (in bytes) and the number
+                                     ///< of items.
+};
+
+std::vector<Phase> g_Phases;
+
+/// \brief If set, a phase has begun and has not ended yet.
+bool g_InPhase = false;
+
+/// \brief The current phase's start time and the peak RSS at its start.
+std::chrono::steady_clock::time_point g_PhaseStart;
+double g_PhaseStartPeakRss = 0.0;
+
+/// \brief The reduced startup phases.
+nlohmann::json g_Report;
+
+/// \brief Returns the peak resident set size of this process (in bytes).
+auto getPeakRss() noexcept -> double {
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0.0;
+
+#ifdef __APPLE__
+  return static_cast<double>(usage.ru_maxrss);
+#else
+  /// The peak resident set size is reported in kilobytes.
+  return static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif // __APPLE__
+}
+
+/// \brief Reduces the phases' measures through the ranks with the specified
+///        operation.
+auto reduceMeasures(const std::vector<double> &measures, const MPI_Op op,
+                    const char *const opName) noexcept -> std::vector<double> {
+  std::vector<double> reduced(measures.size());
+
+  if (MPI_SUCCESS != MPI_Allreduce(measures.data(), reduced.data(),
+                                   static_cast<int>(measures.size()),
+                                   MPI_DOUBLE, op, MPI_COMM_ROSS))
+    ispd_error("The %s of the startup phases could not be reduced, exiting...",
+               opName);
+  return reduced;
+}
+
+}; // namespace
+
+auto beginPhase(const char *const name) noexcept -> void {
+  /// Checks if the previous phase has not ended. If so, the program is
+  /// immediately aborted, since the phases must not be nested.
+  if (g_InPhase)
+    ispd_error("Startup phase %s has begun before %s has ended.", name,
+               g_Phases.back().m_Name.c_str());
+
+  g_InPhase = true;
+  g_Phases.push_back({name, {}});
+  g_PhaseStartPeakRss = getPeakRss();
+  g_PhaseStart = std::chrono::steady_clock::now();
+}
+
+auto endPhase(const std::uint64_t itemCount) noexcept -> void {
+  const auto end = std::chrono::steady_clock::now();
+
+  if (!g_InPhase)
+    ispd_error("A startup phase has ended without having begun.");
+
+  Phase &phase = g_Phases.back();
+
+  phase.m_Measures[0] =
+      std::chrono::duration<double>(end - g_PhaseStart).count();
+  phase.m_Measures[1] = getPeakRss() - g_PhaseStartPeakRss;
+  phase.m_Measures[2] = static_cast<double>(itemCount);
+  g_InPhase = false;
+}
+
+auto reportPhases() noexcept -> void {
+  const int phaseCount = static_cast<int>(g_Phases.size());
+  int phaseCounts[2] = {phaseCount, -phaseCount};
+  int maxPhaseCounts[2];
+
+  /// Checks if the ranks have not gone through the same number of phases. If
+  /// so, the program is immediately aborted, since the phases are reduced
+  /// one by one.
+  if (MPI_SUCCESS != MPI_Allreduce(phaseCounts, maxPhaseCounts, 2, MPI_INT,
+                                   MPI_MAX, MPI_COMM_ROSS))
+    ispd_error("The number of startup phases could not be reduced, exiting...");
+  if (maxPhaseCounts[0] != -maxPhaseCounts[1])
+    ispd_error("The ranks have gone through different numbers of startup "
+               "phases.");
+
+  std::vector<double> measures;
+
+  measures.reserve(g_Phases.size() * g_MeasureCount);
+  for (const auto &phase : g_Phases)
+    measures.insert(measures.end(), phase.m_Measures,
+                    phase.m_Measures + g_MeasureCount);
+
+  const auto mins = reduceMeasures(measures, MPI_MIN, "minimum");
+  const auto maxs = reduceMeasures(measures, MPI_MAX, "maximum");
+  const auto sums = reduceMeasures(measures, MPI_SUM, "sum");
+  const unsigned rankCount = tw_nnodes();
+
+  static const char *const measureKeys[g_MeasureCount] = {
+      "wall_time", "peak_rss_delta", "items"};
+
+  g_Report = nlohmann::json::object();
+  g_Report["ranks"] = rankCount;
+  g_Report["phases"] = nlohmann::json::array();
+
+  for (std::size_t i = 0; i < g_Phases.size(); i++) {
+    nlohmann::json phase;
+
+    phase["name"] = g_Phases[i].m_Name;
+
+    for (std::size_t j = 0; j < g_MeasureCount; j++) {
+      const std::size_t k = i * g_MeasureCount + j;
+
+      phase[measureKeys[j]] = {{"min", mins[k]},
+                               {"average", sums[k] / rankCount},
+                               {"max", maxs[k]}};
+    }
+    g_Report["phases"].push_back(std::move(phase));
+  }
+
+  /// Only the master node prints the startup phases.
+  if (g_tw_mynode)
+    return;
+
+  constexpr double bytesPerMib = 1024.0 * 1024.0;
+
+  ispd_info("");
+  ispd_info("Startup Phases (min / avg / max through %u ranks)", rankCount);
+
+  for (std::size_t i = 0; i < g_Phases.size(); i++) {
+    const std::size_t k = i * g_MeasureCount;
+
+    ispd_info("");
+    ispd_info(" %s", g_Phases[i].m_Name.c_str());
+    ispd_info("  Wall Time......................: %lf / %lf / %lf seconds.",
+              mins[k], sums[k] / rankCount, maxs[k]);
+    ispd_info("  Peak RSS Growth................: %.1lf / %.1lf / %.1lf MiB.",
+              mins[k + 1] / bytesPerMib,
+              sums[k + 1] / rankCount / bytesPerMib,
+              maxs[k + 1] / bytesPerMib);
+    ispd_info("  Items..........................: %.0lf / %.1lf / %.0lf.",
+              mins[k + 2], sums[k + 2] / rankCount, maxs[k + 2]);
+  }
+  ispd_info("");
+}
+
+auto getPhasesReport() noexcept -> const nlohmann::json & { return g_Report; }
+
+}; // namespace ispd::profiler
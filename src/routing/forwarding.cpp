@@ -0,0 +1,142 @@
+#include <ross.h>
+#include <tuple>
+#include <algorithm>
+#include <ispd/routing/forwarding.hpp>
+
+namespace ispd::routing {
+
+namespace {
+
+/// \struct ForwardingEntry
+///
+/// \brief A route passing by a hosted forwarding service, as collected before
+///        the entries are laid out.
+struct ForwardingEntry {
+  tw_lpid m_Service;
+  RouteId m_RouteId;
+  NextHop m_NextHop;
+};
+
+} // namespace
+
+auto ForwardingTables::build(const RoutingProvider &provider,
+                             const std::vector<RouteDemand> &demands,
+                             const std::vector<RouteEdge> &edges,
+                             const VertexPredicate &isHosted) -> void {
+  /// Returns the downward end of the specified link.
+  const auto findDownwardEnd = [&edges](const tw_lpid link) {
+    const auto it = std::lower_bound(
+        edges.cbegin(), edges.cend(), link,
+        [](const RouteEdge &edge, const tw_lpid gid) {
+          return edge.m_Link < gid;
+        });
+
+    if (it == edges.cend() || it->m_Link != link) [[unlikely]]
+      ispd_error("Route hop %lu is not a link.", link);
+
+    return it->m_To;
+  };
+
+  std::vector<ForwardingEntry> entries;
+
+  for (const RouteDemand &demand : demands) {
+    for (const tw_lpid dest : demand.m_Dests) {
+      /// The routes that are not served by this processing element do not
+      /// pass by any hosted service.
+      if (!provider.hasRoute(demand.m_Src, dest))
+        continue;
+
+      const RouteList routes = provider.getRoutes(demand.m_Src, dest);
+
+      for (std::size_t i = 0; i < routes.size(); i++) {
+        const Route route = routes[i];
+        const RouteId id = provider.getRouteId(demand.m_Src, dest, i);
+
+        /// The service between the (k - 1)-th and the k-th links forwards the
+        /// tasks to the k-th link downward and to the (k - 1)-th link upward.
+        for (std::size_t k = 1; k < route.getLength(); k++) {
+          const tw_lpid previous = route.get(k - 1);
+          const tw_lpid service = findDownwardEnd(previous);
+
+          if (isHosted(service))
+            entries.push_back({service, id, {route.get(k), previous}});
+        }
+      }
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const ForwardingEntry &a, const ForwardingEntry &b) {
+              return std::tie(a.m_Service, a.m_RouteId) <
+                     std::tie(b.m_Service, b.m_RouteId);
+            });
+
+  m_Services.clear();
+  m_Offsets.clear();
+  m_RouteIds.resize(entries.size());
+  m_NextHops.resize(entries.size());
+
+  for (std::size_t i = 0; i < entries.size(); i++) {
+    const ForwardingEntry &entry = entries[i];
+
+    if (i == 0 || entries[i - 1].m_Service != entry.m_Service) {
+      m_Services.push_back(entry.m_Service);
+      m_Offsets.push_back(i);
+    } else if (entries[i - 1].m_RouteId == entry.m_RouteId) [[unlikely]] {
+      ispd_error("Route with identifier %lu passes by %lu more than once.",
+                 entry.m_RouteId, entry.m_Service);
+    }
+
+    m_RouteIds[i] = entry.m_RouteId;
+    m_NextHops[i] = entry.m_NextHop;
+  }
+
+  m_Offsets.push_back(entries.size());
+
+  ispd_info("Next-hop tables have been built at node %lu (Services: %lu, "
+            "Entries: %lu, Bytes: %lu).",
+            static_cast<unsigned long>(g_tw_mynode), m_Services.size(),
+            entries.size(), getMemoryUsage());
+}
+
+auto ForwardingTables::getTable(const tw_lpid service) const noexcept
+    -> NextHopTable {
+  const auto it =
+      std::lower_bound(m_Services.cbegin(), m_Services.cend(), service);
+
+  if (it == m_Services.cend() || *it != service)
+    return NextHopTable();
+
+  const std::size_t index = it - m_Services.cbegin();
+  const std::uint64_t first = m_Offsets[index];
+
+  return NextHopTable(m_RouteIds.data() + first, m_NextHops.data() + first,
+                      m_Offsets[index + 1] - first);
+}
+
+}; // namespace ispd::routing
+
+namespace ispd::forwarding_table {
+/// \brief The next-hop tables of the services hosted by this processing
+///        element, or `nullptr` if they have not been built.
+static ispd::routing::ForwardingTables *g_ForwardingTables = nullptr;
+
+auto build(const std::vector<ispd::routing::RouteDemand> &demands,
+           const std::vector<ispd::routing::RouteEdge> &edges,
+           const ispd::routing::VertexPredicate &isHosted) -> void {
+  if (!g_ForwardingTables)
+    g_ForwardingTables = new ispd::routing::ForwardingTables();
+
+  /// The routes are walked as served by the global route provider.
+  g_ForwardingTables->build(ispd::routing_table::getProvider(), demands,
+                            edges, isHosted);
+}
+
+auto isEnabled() noexcept -> bool { return g_ForwardingTables != nullptr; }
+
+auto getTable(const tw_lpid service) noexcept -> ispd::routing::NextHopTable {
+  return g_ForwardingTables ? g_ForwardingTables->getTable(service)
+                            : ispd::routing::NextHopTable();
+}
+
+}; // namespace ispd::forwarding_table
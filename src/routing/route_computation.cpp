@@ -0,0 +1,322 @@
+#include <ross.h>
+#include <queue>
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <numeric>
+#include <algorithm>
+#include <ispd/routing/routing.hpp>
+
+namespace ispd::routing {
+
+namespace {
+
+/// \brief The index used to indicate that there is no vertex or arc.
+constexpr std::uint64_t g_None = std::numeric_limits<std::uint64_t>::max();
+
+/// \struct RouteArc
+///
+/// \brief A link, as seen from its upward end in the adjacency layout.
+struct RouteArc {
+  tw_lpid m_Link;       ///< The link's global identifier.
+  std::uint64_t m_Head; ///< The index of the link's downward end.
+  double m_Weight;      ///< The link's cost.
+};
+
+/// \class RouteGraph
+///
+/// \brief The directed graph formed by the links, laid out in the compressed
+///        sparse row (CSR) layout over compact vertex indices.
+class RouteGraph {
+  std::vector<tw_lpid> m_Vertices;      ///< The sorted vertices.
+  std::vector<std::uint64_t> m_Offsets; ///< The first arc of each vertex.
+  std::vector<RouteArc> m_Arcs;         ///< The arcs, grouped by tail.
+  std::vector<std::uint8_t> m_Transit;  ///< If each vertex may forward.
+
+public:
+  RouteGraph(const std::vector<RouteEdge> &edges,
+             const VertexPredicate &isTransit) {
+    m_Vertices.reserve(edges.size() * 2);
+
+    for (const RouteEdge &edge : edges) {
+      /// Check if the link's weight is negative. If so, the shortest routes
+      /// are not well defined and the program is immediately aborted.
+      if (!(edge.m_Weight >= 0.0))
+        ispd_error("Link %lu has a negative or undefined weight (%lf).",
+                   edge.m_Link, edge.m_Weight);
+
+      m_Vertices.push_back(edge.m_From);
+      m_Vertices.push_back(edge.m_To);
+    }
+
+    std::sort(m_Vertices.begin(), m_Vertices.end());
+    m_Vertices.erase(std::unique(m_Vertices.begin(), m_Vertices.end()),
+                     m_Vertices.end());
+
+    /// Count the arcs of each vertex and, then, place them. The arcs of each
+    /// vertex are kept in the edges' order, such that the computed routes are
+    /// the same in every run.
+    m_Offsets.assign(m_Vertices.size() + 1, 0);
+
+    for (const RouteEdge &edge : edges)
+      m_Offsets[find(edge.m_From) + 1]++;
+
+    std::partial_sum(m_Offsets.begin(), m_Offsets.end(), m_Offsets.begin());
+
+    std::vector<std::uint64_t> next(m_Offsets.begin(), m_Offsets.end() - 1);
+    m_Arcs.resize(edges.size());
+
+    for (const RouteEdge &edge : edges)
+      m_Arcs[next[find(edge.m_From)]++] =
+          RouteArc{edge.m_Link, find(edge.m_To), edge.m_Weight};
+
+    m_Transit.resize(m_Vertices.size());
+
+    for (std::size_t i = 0; i < m_Vertices.size(); i++)
+      m_Transit[i] = isTransit(m_Vertices[i]);
+  }
+
+  /// \brief Returns the index of the vertex, or `g_None` if it is not an
+  ///        end of any link.
+  [[nodiscard]] auto find(const tw_lpid vertex) const noexcept
+      -> std::uint64_t {
+    const auto it =
+        std::lower_bound(m_Vertices.cbegin(), m_Vertices.cend(), vertex);
+
+    return it != m_Vertices.cend() && *it == vertex
+               ? static_cast<std::uint64_t>(it - m_Vertices.cbegin())
+               : g_None;
+  }
+
+  [[nodiscard]] auto getVertexCount() const noexcept -> std::size_t {
+    return m_Vertices.size();
+  }
+
+  [[nodiscard]] auto getArc(const std::uint64_t arc) const noexcept
+      -> const RouteArc & {
+    return m_Arcs[arc];
+  }
+
+  [[nodiscard]] auto getArcBegin(const std::uint64_t vertex) const noexcept
+      -> std::uint64_t {
+    return m_Offsets[vertex];
+  }
+
+  [[nodiscard]] auto getArcEnd(const std::uint64_t vertex) const noexcept
+      -> std::uint64_t {
+    return m_Offsets[vertex + 1];
+  }
+
+  [[nodiscard]] auto isTransit(const std::uint64_t vertex) const noexcept
+      -> bool {
+    return m_Transit[vertex];
+  }
+};
+
+/// \struct RouteSearch
+///
+/// \brief The state of a single-source shortest route search, which is
+///        reused by a thread among the sources it computes.
+struct RouteSearch {
+  std::vector<double> m_Distance;        ///< The distance to each vertex.
+  std::vector<std::uint64_t> m_Previous; ///< The arc that reaches each vertex.
+  std::vector<std::uint64_t> m_Tail;     ///< The tail of that arc.
+  std::vector<std::uint64_t> m_Touched;  ///< The vertices reached so far.
+
+  explicit RouteSearch(const std::size_t vertexCount)
+      : m_Distance(vertexCount, std::numeric_limits<double>::infinity()),
+        m_Previous(vertexCount, g_None), m_Tail(vertexCount, g_None) {}
+
+  /// \brief Computes the shortest routes from the source to every vertex.
+  auto run(const RouteGraph &graph, const std::uint64_t source) -> void {
+    /// Reset only the vertices reached by the previous search.
+    for (const std::uint64_t vertex : m_Touched) {
+      m_Distance[vertex] = std::numeric_limits<double>::infinity();
+      m_Previous[vertex] = g_None;
+      m_Tail[vertex] = g_None;
+    }
+    m_Touched.clear();
+
+    using entry_type = std::pair<double, std::uint64_t>;
+    std::priority_queue<entry_type, std::vector<entry_type>,
+                        std::greater<entry_type>>
+        queue;
+
+    m_Distance[source] = 0.0;
+    m_Touched.push_back(source);
+    queue.emplace(0.0, source);
+
+    while (!queue.empty()) {
+      const auto [distance, vertex] = queue.top();
+      queue.pop();
+
+      /// Skip the outdated entries.
+      if (distance > m_Distance[vertex])
+        continue;
+
+      /// A route may only continue through a vertex that forwards tasks.
+      if (vertex != source && !graph.isTransit(vertex))
+        continue;
+
+      for (std::uint64_t a = graph.getArcBegin(vertex);
+           a < graph.getArcEnd(vertex); a++) {
+        const RouteArc &arc = graph.getArc(a);
+        const double candidate = distance + arc.m_Weight;
+
+        if (candidate < m_Distance[arc.m_Head]) {
+          if (m_Previous[arc.m_Head] == g_None)
+            m_Touched.push_back(arc.m_Head);
+
+          m_Distance[arc.m_Head] = candidate;
+          m_Previous[arc.m_Head] = a;
+          m_Tail[arc.m_Head] = vertex;
+          queue.emplace(candidate, arc.m_Head);
+        }
+      }
+    }
+  }
+};
+
+/// \struct DemandRoutes
+///
+/// \brief The routes computed for a single demand.
+struct DemandRoutes {
+  std::vector<RouteRecord> m_Routes; ///< The kept routes.
+  std::vector<tw_lpid> m_Hops;       ///< The kept routes' pooled paths.
+  std::vector<RouteId> m_Ordinals;   ///< The kept routes' ordinals.
+
+  /// \brief The first destination that could not be reached, if any.
+  tw_lpid m_Unreachable = 0;
+  bool m_Failed = false;
+};
+
+} // namespace
+
+auto RoutingTable::compute(const std::vector<RouteEdge> &edges,
+                           const std::vector<RouteDemand> &demands,
+                           const VertexPredicate &isTransit,
+                           unsigned threadCount,
+                           const VertexPredicate &isRelevant) -> void {
+  const RouteGraph graph(edges, isTransit);
+
+  if (threadCount == 0)
+    threadCount = std::max(1U, std::thread::hardware_concurrency());
+  threadCount = static_cast<unsigned>(std::max<std::size_t>(
+      1, std::min<std::size_t>(threadCount, demands.size())));
+
+  /// The demands are handed to the threads one at a time, since the cost of
+  /// the searches may vary a lot among the sources.
+  std::vector<DemandRoutes> results(demands.size());
+  std::atomic<std::size_t> nextDemand{0};
+
+  const auto work = [&]() {
+    RouteSearch search(graph.getVertexCount());
+    std::vector<tw_lpid> path;
+
+    for (std::size_t d = nextDemand++; d < demands.size(); d = nextDemand++) {
+      const RouteDemand &demand = demands[d];
+      DemandRoutes &result = results[d];
+      const std::uint64_t source = graph.find(demand.m_Src);
+
+      if (source != g_None)
+        search.run(graph, source);
+
+      for (std::size_t i = 0; i < demand.m_Dests.size(); i++) {
+        const std::uint64_t dest = graph.find(demand.m_Dests[i]);
+
+        /// Checks if the destination has not been reached. If so, the failure
+        /// is reported by the calling thread.
+        if (source == g_None || dest == g_None || dest == source ||
+            search.m_Previous[dest] == g_None) {
+          result.m_Unreachable = demand.m_Dests[i];
+          result.m_Failed = true;
+          break;
+        }
+
+        /// Walk the route backwards from the destination to the source.
+        path.clear();
+        for (std::uint64_t v = dest; v != source; v = search.m_Tail[v])
+          path.push_back(graph.getArc(search.m_Previous[v]).m_Link);
+        std::reverse(path.begin(), path.end());
+
+        /// Checks if the route is not relevant. If so, it is skipped.
+        if (isRelevant && !isRelevant(demand.m_Src) &&
+            std::none_of(path.cbegin(), path.cend(), isRelevant))
+          continue;
+
+        result.m_Routes.push_back(
+            {demand.m_Src, demand.m_Dests[i], result.m_Hops.size(),
+             path.size()});
+        result.m_Ordinals.push_back(i);
+        result.m_Hops.insert(result.m_Hops.end(), path.cbegin(), path.cend());
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount - 1);
+
+  for (unsigned i = 1; i < threadCount; i++)
+    workers.emplace_back(work);
+  work();
+
+  for (auto &worker : workers)
+    worker.join();
+
+  /// Report the first failure in the demands' order.
+  for (std::size_t d = 0; d < demands.size(); d++)
+    if (results[d].m_Failed)
+      ispd_error("There is no path from %lu to %lu through the links.",
+                 demands[d].m_Src, results[d].m_Unreachable);
+
+  /// Merge the demands' routes in the demands' order.
+  std::vector<RouteRecord> routes;
+  std::vector<tw_lpid> hops;
+  std::vector<RouteId> routeIds;
+  RouteId ordinalBase = 0;
+
+  for (std::size_t d = 0; d < demands.size(); d++) {
+    DemandRoutes &result = results[d];
+    const std::uint64_t hopBase = hops.size();
+
+    for (std::size_t i = 0; i < result.m_Routes.size(); i++) {
+      RouteRecord route = result.m_Routes[i];
+
+      route.m_HopBegin += hopBase;
+      routes.push_back(route);
+      routeIds.push_back(ordinalBase + result.m_Ordinals[i]);
+    }
+
+    hops.insert(hops.end(), result.m_Hops.cbegin(), result.m_Hops.cend());
+    ordinalBase += demands[d].m_Dests.size();
+
+    /// Release the demand's memory as soon as it has been merged.
+    result = DemandRoutes();
+  }
+
+  /// Lay out the computed routes in the flat layout.
+  build(routes, hops.data(), isRelevant ? routeIds.data() : nullptr);
+
+  ispd_info("Routes have been computed from %lu links by %u thread(s) "
+            "(Sources: %lu, Routes: %lu, Hops: %lu).",
+            edges.size(), threadCount, demands.size(), routes.size(),
+            hops.size());
+}
+
+}; // namespace ispd::routing
+
+namespace ispd::routing_table {
+/// \brief The global routing table, which is defined along with the other
+///        global routing table functions.
+extern ispd::routing::RoutingTable *g_RoutingTable;
+
+auto compute(const std::vector<ispd::routing::RouteEdge> &edges,
+             const std::vector<ispd::routing::RouteDemand> &demands,
+             const ispd::routing::VertexPredicate &isTransit,
+             const unsigned threadCount,
+             const ispd::routing::VertexPredicate &isRelevant) -> void {
+  /// Forward the route computation to the global routing table.
+  g_RoutingTable->compute(edges, demands, isTransit, threadCount, isRelevant);
+}
+
+}; // namespace ispd::routing_table
@@ -0,0 +1,36 @@
+/// \file routec.cpp
+///
+/// \brief The offline route compiler.
+///
+/// This tool compiles a textual route file (`routes.route`) into the compiled
+/// route file format described by `RouteFileHeader`. The compiled route file
+/// can then be given to the simulator through the `--routes` option, which
+/// memory-maps it instead of parsing it at every startup.
+///
+/// Usage: ispd_routec <textual-route-file> <compiled-route-file>
+#include <cstdio>
+#include <ispd/log/log.hpp>
+#include <ispd/routing/routing.hpp>
+
+int main(int argc, char **argv) {
+  ispd::log::setOutputFile(nullptr);
+
+  if (argc != 3) {
+    std::fprintf(stderr, "Usage: %s <textual-route-file> <compiled-route-file>\n",
+                 argv[0]);
+    return 1;
+  }
+
+  const std::string textPath = argv[1];
+  const std::string compiledPath = argv[2];
+
+  /// Parse the textual route file and write it back in the compiled format.
+  ispd::routing::RoutingTable table;
+
+  table.load(textPath);
+  table.save(compiledPath);
+
+  ispd_info("Route file %s has been compiled into %s.", textPath.c_str(),
+            compiledPath.c_str());
+  return 0;
+}
@@ -1,4 +1,16 @@
 #include <ross.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstring>
+#include <thread>
+#include <limits>
+#include <numeric>
+#include <charconv>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
 #include <ispd/routing/routing.hpp>
 
 namespace ispd::routing {
@@ -39,153 +51,778 @@ enum class ParsingStage {
   ///
   INNER_VERTEX
 };
+
+/// \struct RouteChunk
+///
+/// \brief A newline-aligned chunk of a textual route file, along with the
+///        routes parsed from it.
+struct RouteChunk {
+  const char *m_First = nullptr; ///< The chunk's first character.
+  const char *m_Last = nullptr;  ///< One past the chunk's last character.
+
+  std::vector<RouteRecord> m_Routes; ///< The parsed routes.
+  std::vector<tw_lpid> m_Hops;       ///< The parsed routes' pooled paths.
+
+  /// \brief The number of lines parsed from this chunk. If an error has been
+  ///        found, it is the line number, within the chunk, of the error.
+  std::size_t m_Lines = 0;
+
+  /// \brief The description of the first error found, or `nullptr`.
+  const char *m_Error = nullptr;
+
+  /// \brief The number of well-formed routes that have not been kept, since
+  ///        none of their vertices is relevant.
+  std::size_t m_Skipped = 0;
+
+  /// \brief The ordinal, within the chunk, of each kept route among every
+  ///        well-formed route. It is only filled if routes may be skipped.
+  std::vector<RouteId> m_Ordinals;
+};
+
+/// \brief Checks if the character separates two identifiers in a route line.
+[[nodiscard]] constexpr inline auto isSeparator(const char c) noexcept
+    -> bool {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// \brief Parses all the route lines of the specified chunk.
+///
+/// Each identifier is parsed in place with `std::from_chars`, therefore, no
+/// memory is allocated per identifier and no exception is thrown. The parsing
+/// stops at the first malformed line, whose description and line number are
+/// stored in the chunk to be reported by the calling thread.
+///
+/// \param chunk The chunk to be parsed.
+/// \param isRelevant If set, only the routes whose source or hops are
+///                   relevant are kept.
+auto parseRouteChunk(RouteChunk &chunk,
+                     const VertexPredicate &isRelevant) noexcept -> void {
+  const char *it = chunk.m_First;
+  const char *const last = chunk.m_Last;
+
+  while (it < last) {
+    const char *lineEnd =
+        static_cast<const char *>(std::memchr(it, '\n', last - it));
+    if (!lineEnd)
+      lineEnd = last;
+
+    chunk.m_Lines++;
+
+    RouteRecord route{0, 0, chunk.m_Hops.size(), 0};
+    ParsingStage stage = ParsingStage::SOURCE_VERTEX;
+
+    for (;;) {
+      while (it < lineEnd && isSeparator(*it))
+        it++;
+
+      if (it == lineEnd)
+        break;
+
+      tw_lpid vertex;
+      const auto [next, ec] = std::from_chars(it, lineEnd, vertex);
+
+      /// Checks if the identifier is not a number or is followed by
+      /// characters that are not separators.
+      if (ec == std::errc::result_out_of_range) {
+        chunk.m_Error = "A vertex is out of range";
+        return;
+      }
+      if (ec != std::errc() || (next < lineEnd && !isSeparator(*next))) {
+        chunk.m_Error = "A vertex is not a number";
+        return;
+      }
+
+      switch (stage) {
+      case ParsingStage::SOURCE_VERTEX:
+        route.m_Src = vertex;
+        stage = ParsingStage::DESTINATION_VERTEX;
+        break;
+      case ParsingStage::DESTINATION_VERTEX:
+        route.m_Dest = vertex;
+        stage = ParsingStage::INNER_VERTEX;
+        break;
+      case ParsingStage::INNER_VERTEX:
+        chunk.m_Hops.push_back(vertex);
+        route.m_HopCount++;
+        break;
+      }
+
+      it = next;
+    }
+
+    it = lineEnd + 1;
+
+    /// Blank lines are ignored.
+    if (stage == ParsingStage::SOURCE_VERTEX)
+      continue;
+
+    /// Checks if the route has no inner vertices, since every route must
+    /// have at least one.
+    if (route.m_HopCount == 0) {
+      chunk.m_Error = "A route must have at least one inner vertex";
+      return;
+    }
+
+    /// Checks if the route is not relevant. If so, its path is discarded.
+    if (isRelevant && !isRelevant(route.m_Src) &&
+        std::none_of(chunk.m_Hops.cbegin() + route.m_HopBegin,
+                     chunk.m_Hops.cend(), isRelevant)) {
+      chunk.m_Hops.resize(route.m_HopBegin);
+      chunk.m_Skipped++;
+      continue;
+    }
+
+    if (isRelevant)
+      chunk.m_Ordinals.push_back(chunk.m_Routes.size() + chunk.m_Skipped);
+    chunk.m_Routes.push_back(route);
+  }
+}
 }; // namespace
 
-auto RoutingTable::addRoute(const tw_lpid src, const tw_lpid dest,
-                            const Route *route) -> void {
-  /// It counts how many routes have been registered starting from this source
-  /// vertex. This is done for the purpose of provide an early sanity check
-  /// about if the routes have been registered correctly with relation to the
-  /// model built.
-  m_RoutesCounting[src]++;
+RoutingTable::~RoutingTable() {
+  /// Unmap the compiled route file, if any.
+  if (m_Mapping)
+    munmap(const_cast<void *>(m_Mapping), m_MappingSize);
+}
+
+auto RoutingTable::load(const std::string &filepath,
+                        const unsigned threadCount,
+                        const VertexPredicate &isRelevant) -> void {
+  std::ifstream file(filepath, std::ios::binary);
+
+  /// Check if the routing file could not be opened. If so, an error
+  /// indicating the case is sent and the program is immediately aborted.
+  if (!file.is_open()) [[unlikely]]
+    ispd_error("Routing file %s could not be opened.", filepath.c_str());
+
+  /// Check if a routing file has already been loaded into this table.
+  if (m_Header) [[unlikely]]
+    ispd_error("Routing file %s is being loaded into a non-empty routing "
+               "table.",
+               filepath.c_str());
+
+  /// Read the file's leading bytes to check if it is a compiled route file.
+  char magic[sizeof(g_RouteFileMagic)] = {};
+  file.read(magic, sizeof(magic));
+
+  const bool compiled =
+      file.gcount() == sizeof(magic) &&
+      std::memcmp(magic, g_RouteFileMagic, sizeof(magic)) == 0;
+
+  file.close();
+
+  if (compiled) {
+    /// The compiled route file is shared through the page cache, therefore,
+    /// it is kept whole even if only the relevant routes are requested.
+    if (isRelevant)
+      ispd_info("Compiled route file %s is mapped as a whole, since its pages "
+                "are shared among the ranks in the same host.",
+                filepath.c_str());
+    loadCompiled(filepath);
+  } else
+    loadText(filepath, threadCount, isRelevant);
+}
+
+auto RoutingTable::load(const std::string &name,
+                        ispd::input::FileBuffer &&buffer,
+                        const unsigned threadCount,
+                        const VertexPredicate &isRelevant) -> void {
+  /// Check if a routing file has already been loaded into this table.
+  if (m_Header) [[unlikely]]
+    ispd_error("Routing file %s is being loaded into a non-empty routing "
+               "table.",
+               name.c_str());
+
+  const bool compiled =
+      buffer.size() >= sizeof(g_RouteFileMagic) &&
+      std::memcmp(buffer.data(), g_RouteFileMagic, sizeof(g_RouteFileMagic)) ==
+          0;
+
+  if (!compiled) {
+    parseText(name, buffer.data(), buffer.size(), threadCount, isRelevant);
+    return;
+  }
+
+  if (buffer.size() < sizeof(RouteFileHeader))
+    ispd_error("Compiled route file %s is truncated.", name.c_str());
+
+  /// The compiled route file is kept whole, since its routes are identified
+  /// by their indices in the layout.
+  if (isRelevant)
+    ispd_info("Compiled route file %s is kept as a whole, since it has been "
+              "compiled for every rank.",
+              name.c_str());
+
+  /// The buffer is taken over as the in-memory image, which is laid out
+  /// exactly as the compiled route file.
+  const std::size_t size = buffer.size();
+
+  m_Image = buffer.releaseWords();
+
+  const RouteFileHeader *const header =
+      reinterpret_cast<const RouteFileHeader *>(m_Image.data());
+
+  checkCompiled(name, header, size);
+  bindSections(header);
+
+  /// Since the image is private to this rank, its prefixes may be shared.
+  if (m_SharePrefixes)
+    sharePrefixes();
+
+  ispd_info("Compiled route file %s has been loaded from memory (Sources: "
+            "%lu, Pairs: %lu, Routes: %lu, Hops: %lu).",
+            name.c_str(), m_Header->m_SourceCount, m_Header->m_PairCount,
+            m_Header->m_RouteCount, m_Header->m_HopCount);
+}
+
+auto RoutingTable::loadText(const std::string &filepath,
+                            unsigned threadCount,
+                            const VertexPredicate &isRelevant) -> void {
+  const int fd = open(filepath.c_str(), O_RDONLY);
+
+  /// Check if the routing file could not be opened. If so, an error
+  /// indicating the case is sent and the program is immediately aborted.
+  if (fd < 0) [[unlikely]]
+    ispd_error("Routing file %s could not be opened.", filepath.c_str());
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0) [[unlikely]]
+    ispd_error("Routing file %s could not be inspected.", filepath.c_str());
+
+  const std::size_t size = st.st_size;
+
+  /// Map the textual route file, such that it is parsed in place without
+  /// being copied into a buffer first.
+  void *const mapping =
+      size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+
+  close(fd);
 
-  /// Insert the route.
-  m_Routes[szudzik(src, dest)].push_back(route);
+  if (mapping == MAP_FAILED) [[unlikely]]
+    ispd_error("Routing file %s could not be mapped.", filepath.c_str());
+
+  parseText(filepath, static_cast<const char *>(mapping), size, threadCount,
+            isRelevant);
+
+  if (mapping)
+    munmap(mapping, size);
 }
 
-auto RoutingTable::parseRouteLine(const std::string &routeLine,
-                                  const std::size_t lineNumber, tw_lpid &src,
-                                  tw_lpid &dest) -> Route * {
-  const std::size_t routeLineLength = routeLine.length();
-  std::size_t whitespaceCount = 0;
-  std::size_t pathLength = 0;
-  std::size_t pathIndex = 0;
+auto RoutingTable::parseText(const std::string &name, const char *const text,
+                             const std::size_t size, unsigned threadCount,
+                             const VertexPredicate &isRelevant) -> void {
+  /// Decide the number of threads. Each chunk has at least a minimum size,
+  /// such that small route files are not split into useless chunks.
+  constexpr std::size_t minChunkSize = std::size_t{1} << 20;
+
+  if (threadCount == 0)
+    threadCount = std::max(1U, std::thread::hardware_concurrency());
+  threadCount = static_cast<unsigned>(std::max<std::size_t>(
+      1, std::min<std::size_t>(threadCount, size / minChunkSize)));
+
+  /// Split the file into newline-aligned chunks, such that every route line
+  /// is parsed entirely by a single thread.
+  std::vector<RouteChunk> chunks(threadCount);
+  std::size_t chunkBegin = 0;
+
+  for (unsigned i = 0; i < threadCount; i++) {
+    std::size_t chunkEnd =
+        i + 1 == threadCount ? size : (size / threadCount) * (i + 1);
+
+    if (chunkEnd < chunkBegin)
+      chunkEnd = chunkBegin;
+
+    /// Move the chunk's end past the next newline.
+    const void *const newline =
+        chunkEnd < size ? std::memchr(text + chunkEnd, '\n', size - chunkEnd)
+                        : nullptr;
+
+    if (i + 1 < threadCount)
+      chunkEnd = newline ? static_cast<const char *>(newline) - text + 1 : size;
+
+    chunks[i].m_First = text + chunkBegin;
+    chunks[i].m_Last = text + chunkEnd;
+    chunkBegin = chunkEnd;
+  }
+
+  /// Parse the chunks in parallel. The first chunk is parsed by the calling
+  /// thread.
+  std::vector<std::thread> workers;
+  workers.reserve(threadCount - 1);
+
+  for (unsigned i = 1; i < threadCount; i++)
+    workers.emplace_back(parseRouteChunk, std::ref(chunks[i]),
+                         std::cref(isRelevant));
+  parseRouteChunk(chunks[0], isRelevant);
+
+  for (auto &worker : workers)
+    worker.join();
+
+  /// Report the first error in the file's order. Since every chunk before
+  /// the failing one has been parsed entirely, their line counts give the
+  /// error's line number in the file.
+  std::size_t lineOffset = 0;
+
+  for (const RouteChunk &chunk : chunks) {
+    if (chunk.m_Error)
+      ispd_error("%s (Line Number: %lu).", chunk.m_Error,
+                 lineOffset + chunk.m_Lines);
+    lineOffset += chunk.m_Lines;
+  }
+
+  /// Merge the chunks' routes and paths in the file's order.
+  std::size_t routeCount = 0, hopCount = 0, skippedCount = 0;
+
+  for (const RouteChunk &chunk : chunks) {
+    routeCount += chunk.m_Routes.size();
+    hopCount += chunk.m_Hops.size();
+    skippedCount += chunk.m_Skipped;
+  }
+
+  std::vector<RouteRecord> routes;
+  std::vector<tw_lpid> hops;
+
+  /// If routes may have been skipped, a route's identifier is its ordinal in
+  /// the file, since it is the same in every rank.
+  std::vector<RouteId> routeIds;
+  RouteId ordinalBase = 0;
 
-  // It counts the amount of whitespaces the route line contains.
-  // With that information in hands, it is possible to conclude the
-  // path length and allocate the exactly amount of path elements.
-  for (std::size_t i = 0; i < routeLineLength; i++)
-    if (routeLine[i] == ' ')
-      whitespaceCount++;
+  routes.reserve(routeCount);
+  hops.reserve(hopCount);
+  if (isRelevant)
+    routeIds.reserve(routeCount);
 
-  // It sets the path length and allocate the path elements.
-  pathLength = whitespaceCount - 1;
+  for (RouteChunk &chunk : chunks) {
+    const std::uint64_t hopBase = hops.size();
 
-  std::unique_ptr<tw_lpid *> path =
-      std::make_unique<tw_lpid *>(new tw_lpid[pathLength]);
+    for (RouteRecord route : chunk.m_Routes) {
+      route.m_HopBegin += hopBase;
+      routes.push_back(route);
+    }
+
+    for (const RouteId ordinal : chunk.m_Ordinals)
+      routeIds.push_back(ordinalBase + ordinal);
 
-  std::size_t partStart = 0;
-  std::size_t partLength = 0;
+    hops.insert(hops.end(), chunk.m_Hops.cbegin(), chunk.m_Hops.cend());
+    ordinalBase += chunk.m_Routes.size() + chunk.m_Skipped;
 
-  ParsingStage stage = ParsingStage::SOURCE_VERTEX;
+    /// Release the chunk's memory as soon as it has been merged.
+    chunk.m_Routes = std::vector<RouteRecord>();
+    chunk.m_Hops = std::vector<tw_lpid>();
+    chunk.m_Ordinals = std::vector<RouteId>();
+  }
 
-  for (std::size_t i = 0; i < routeLineLength; i++) {
-    while (routeLine[i] != ' ' && i < routeLineLength) {
-      partLength++;
-      i++;
+  /// Print the loaded routes.
+  DEBUG({
+    for (const RouteRecord &route : routes) {
+      std::printf("Route [F: %lu, T: %lu, P: ", route.m_Src, route.m_Dest);
+      for (std::size_t i = 0; i < route.m_HopCount - 1; i++)
+        std::printf("%lu -> ", hops[route.m_HopBegin + i]);
+      std::printf("%lu].\n", hops[route.m_HopBegin + route.m_HopCount - 1]);
     }
+  });
+
+  /// Lay out the parsed routes in the flat layout.
+  build(routes, hops.data(), isRelevant ? routeIds.data() : nullptr);
+
+  ispd_info("Routing file %s has been parsed by %u thread(s) (Routes: %lu, "
+            "Hops: %lu, Skipped Routes: %lu).",
+            name.c_str(), threadCount, routeCount, hopCount,
+            skippedCount);
+}
 
-    // It obtains a route part. That is represented by a sequence of
-    // letters followed by a space, new line or end of file.
-    const std::string routePart = routeLine.substr(partStart, partLength);
-
-#define TRY_CATCH_PARSE(LEFT, TYPENAME)                                        \
-  try {                                                                        \
-    LEFT = std::stoul(routePart);                                              \
-  } catch (const std::invalid_argument &e) {                                   \
-    ispd_error(TYPENAME " vertex is not a number (Line Number: %lu).",         \
-               lineNumber);                                                    \
-  } catch (const std::out_of_range &e) {                                       \
-    ispd_error(TYPENAME "vertex is out of range (Line Number: %lu).",          \
-               lineNumber);                                                    \
+auto RoutingTable::build(const std::vector<RouteRecord> &routes,
+                         const tw_lpid *const hops,
+                         const RouteId *const routeIds) -> void {
+  /// Check if a routing file has already been loaded into this table.
+  if (m_Header) [[unlikely]]
+    ispd_error("Routes are being built into a non-empty routing table.");
+
+  const auto before = [&routes](const std::size_t a, const std::size_t b) {
+    return routes[a].m_Src != routes[b].m_Src
+               ? routes[a].m_Src < routes[b].m_Src
+               : routes[a].m_Dest < routes[b].m_Dest;
+  };
+
+  /// The routes' order in the layout. Routes connecting the same vertices
+  /// keep their relative order, such that the first route given is the one
+  /// returned by `getRoute`.
+  std::vector<std::size_t> order(routes.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+
+  if (!std::is_sorted(order.begin(), order.end(), before))
+    std::stable_sort(order.begin(), order.end(), before);
+
+  RouteFileHeader header;
+
+  std::memcpy(header.m_Magic, g_RouteFileMagic, sizeof(header.m_Magic));
+  header.m_Version = g_RouteFileVersion;
+  header.m_HopWidth = sizeof(tw_lpid);
+  header.m_ByteOrder = g_RouteFileByteOrderMark;
+  header.m_SourceCount = 0;
+  header.m_PairCount = 0;
+  header.m_RouteCount = routes.size();
+  header.m_HopCount = 0;
+
+  /// Count the distinct sources, pairs and the total number of hops.
+  for (std::size_t i = 0; i < order.size(); i++) {
+    const RouteRecord &route = routes[order[i]];
+    const RouteRecord *const previous = i ? &routes[order[i - 1]] : nullptr;
+
+    if (!previous || previous->m_Src != route.m_Src)
+      header.m_SourceCount++;
+    if (!previous || previous->m_Src != route.m_Src ||
+        previous->m_Dest != route.m_Dest)
+      header.m_PairCount++;
+    header.m_HopCount += route.m_HopCount;
   }
 
-    switch (stage) {
-    case ParsingStage::SOURCE_VERTEX:
-      TRY_CATCH_PARSE(src, "Source")
-      stage = ParsingStage::DESTINATION_VERTEX;
-      break;
-    case ParsingStage::DESTINATION_VERTEX:
-      TRY_CATCH_PARSE(dest, "Destination")
-      stage = ParsingStage::INNER_VERTEX;
-      break;
-    case ParsingStage::INNER_VERTEX:
-      TRY_CATCH_PARSE((*path)[pathIndex++], "Inner")
-      break;
-    default:
-      ispd_error("Unknown parsing stage while parsing a route line.");
+  /// Allocate the image, copy the header and point the sections to it.
+  constexpr std::size_t headerWords =
+      sizeof(RouteFileHeader) / sizeof(std::uint64_t);
+
+  m_Image.assign(headerWords + header.getPayloadWords(), 0);
+  std::memcpy(m_Image.data(), &header, sizeof(header));
+  bindSections(reinterpret_cast<const RouteFileHeader *>(m_Image.data()));
+
+  /// The sections are written through these pointers, since the bound ones
+  /// are read-only.
+  std::uint64_t *const sources = m_Image.data() + (m_Sources - m_Image.data());
+  std::uint64_t *const sourcePairs =
+      m_Image.data() + (m_SourcePairs - m_Image.data());
+  std::uint64_t *const pairDests =
+      m_Image.data() + (m_PairDests - m_Image.data());
+  std::uint64_t *const pairRoutes =
+      m_Image.data() + (m_PairRoutes - m_Image.data());
+  std::uint64_t *const routeHops =
+      m_Image.data() + (m_RouteHops - m_Image.data());
+  tw_lpid *const imageHops = m_Image.data() + (m_Hops - m_Image.data());
+
+  std::uint64_t source = 0, pair = 0, hop = 0;
+
+  for (std::size_t i = 0; i < order.size(); i++) {
+    const RouteRecord &route = routes[order[i]];
+    const RouteRecord *const previous = i ? &routes[order[i - 1]] : nullptr;
+
+    /// A new source starts a new range of pairs.
+    if (!previous || previous->m_Src != route.m_Src) {
+      sources[source] = route.m_Src;
+      sourcePairs[source++] = pair;
     }
 
-#undef TRY_CATCH_PARSE
+    /// A new pair starts a new range of routes.
+    if (!previous || previous->m_Src != route.m_Src ||
+        previous->m_Dest != route.m_Dest) {
+      pairDests[pair] = route.m_Dest;
+      pairRoutes[pair++] = i;
+    }
 
-    partStart = i + 1;
-    partLength = 0;
+    /// Copy the route's path to the pooled hop array.
+    routeHops[i] = hop;
+    std::copy_n(hops + route.m_HopBegin, route.m_HopCount, imageHops + hop);
+    hop += route.m_HopCount;
   }
 
-  /// Creates the route object contanining the path that has been
-  /// read from the specified routing line and the route's length.
-  return new Route(std::move(path), pathLength);
+  sourcePairs[source] = pair;
+  pairRoutes[pair] = order.size();
+  routeHops[order.size()] = hop;
+
+  /// Index the routes' identifiers, if they are not their indices.
+  if (routeIds) {
+    m_RouteIds.resize(order.size());
+    m_RouteIdIndex.resize(order.size());
+
+    for (std::size_t i = 0; i < order.size(); i++) {
+      m_RouteIds[i] = routeIds[order[i]];
+      m_RouteIdIndex[i] = std::make_pair(m_RouteIds[i], i);
+    }
+
+    std::sort(m_RouteIdIndex.begin(), m_RouteIdIndex.end());
+  }
+
+  if (m_SharePrefixes)
+    sharePrefixes();
 }
 
-auto RoutingTable::load(const std::string &filepath) -> void {
-  std::ifstream file(filepath);
-  std::size_t lineNumber = 0;
+auto RoutingTable::sharePrefixes() -> void {
+  constexpr std::uint64_t noParent = std::numeric_limits<std::uint64_t>::max();
 
-  /// Check if the routing file could not be opened. If so, an error
+  /// Hashes a (parent, hop) trie edge.
+  struct EdgeHash {
+    auto operator()(const std::pair<std::uint64_t, tw_lpid> &edge) const
+        noexcept -> std::size_t {
+      return std::hash<std::uint64_t>()(edge.first * 0x9e3779b97f4a7c15ULL ^
+                                        edge.second);
+    }
+  };
+
+  /// The children of the trie nodes, which are only kept while the routes of
+  /// a single source are inserted, since routes from different sources
+  /// seldom share a prefix.
+  std::unordered_map<std::pair<std::uint64_t, tw_lpid>, std::uint64_t,
+                     EdgeHash>
+      children;
+
+  m_RouteNodes.resize(m_Header->m_RouteCount);
+
+  for (std::uint64_t source = 0; source < m_Header->m_SourceCount; source++) {
+    const std::uint64_t firstRoute = m_PairRoutes[m_SourcePairs[source]];
+    const std::uint64_t lastRoute = m_PairRoutes[m_SourcePairs[source + 1]];
+
+    children.clear();
+
+    for (std::uint64_t route = firstRoute; route < lastRoute; route++) {
+      std::uint64_t node = noParent;
+
+      /// Walk down the trie along the route's path, creating the nodes of
+      /// the hops that are not shared with a previous route.
+      for (std::uint64_t hop = m_RouteHops[route];
+           hop < m_RouteHops[route + 1]; hop++) {
+        const auto [it, inserted] =
+            children.try_emplace({node, m_Hops[hop]}, m_TrieHops.size());
+
+        if (inserted) {
+          m_TrieHops.push_back(m_Hops[hop]);
+          m_TrieParents.push_back(node);
+        }
+
+        node = it->second;
+      }
+
+      m_RouteNodes[route] = node;
+    }
+  }
+
+  m_TrieHops.shrink_to_fit();
+  m_TrieParents.shrink_to_fit();
+
+  /// Release the pooled hop array, which is the image's last section.
+  m_Image.resize(m_Image.size() - m_Header->m_HopCount);
+  m_Image.shrink_to_fit();
+  bindSections(reinterpret_cast<const RouteFileHeader *>(m_Image.data()));
+  m_Hops = nullptr;
+
+  ispd_info("Route prefixes have been shared (Hops: %lu, Trie Nodes: %lu).",
+            m_Header->m_HopCount, m_TrieHops.size());
+}
+
+auto RoutingTable::bindSections(const RouteFileHeader *const header) noexcept
+    -> void {
+  /// Compute where each section starts after the header.
+  const std::uint64_t *section =
+      reinterpret_cast<const std::uint64_t *>(header + 1);
+
+  m_Header = header;
+  m_Sources = section;
+  section += header->m_SourceCount;
+  m_SourcePairs = section;
+  section += header->m_SourceCount + 1;
+  m_PairDests = section;
+  section += header->m_PairCount;
+  m_PairRoutes = section;
+  section += header->m_PairCount + 1;
+  m_RouteHops = section;
+  section += header->m_RouteCount + 1;
+  m_Hops = reinterpret_cast<const tw_lpid *>(section);
+}
+
+auto RoutingTable::checkCompiled(const std::string &name,
+                                 const RouteFileHeader *const header,
+                                 const std::size_t size) -> void {
+  /// Check if the compiled route file has been generated by an incompatible
+  /// compiler or in a machine with a different architecture.
+  if (!header->isCompatible())
+    ispd_error("Compiled route file %s is incompatible with this build "
+               "(Version: %u, Hop Width: %u).",
+               name.c_str(), header->m_Version, header->m_HopWidth);
+
+  /// Check if the file size matches the size described by its header. This
+  /// guarantees that every section lookup is within the layout's bounds.
+  if (header->getFileSize() != size)
+    ispd_error("Compiled route file %s has %zu bytes, but its header "
+               "describes %lu bytes.",
+               name.c_str(), size, header->getFileSize());
+}
+
+auto RoutingTable::loadCompiled(const std::string &filepath) -> void {
+  const int fd = open(filepath.c_str(), O_RDONLY);
+
+  /// Check if the compiled route file could not be opened. If so, an error
+  /// indicating the case is sent and the program is immediately aborted.
+  if (fd < 0) [[unlikely]]
+    ispd_error("Compiled route file %s could not be opened.",
+               filepath.c_str());
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) < sizeof(RouteFileHeader))
+    ispd_error("Compiled route file %s is truncated.", filepath.c_str());
+
+  /// Map the whole file as read-only and shared, such that every rank in the
+  /// same host is served from the same page cache pages.
+  void *const mapping =
+      mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+  /// The mapping keeps the file referenced, therefore, the file descriptor is
+  /// no longer needed.
+  close(fd);
+
+  if (mapping == MAP_FAILED) [[unlikely]]
+    ispd_error("Compiled route file %s could not be mapped.",
+               filepath.c_str());
+
+  /// The compiled route file is shared through the page cache, therefore,
+  /// its routes are kept as they are even if prefix sharing is enabled.
+  if (m_SharePrefixes)
+    ispd_info("Compiled route file %s is mapped as is, since its pages are "
+              "shared among the ranks in the same host.",
+              filepath.c_str());
+
+  m_Mapping = mapping;
+  m_MappingSize = st.st_size;
+
+  const RouteFileHeader *const header =
+      static_cast<const RouteFileHeader *>(mapping);
+
+  checkCompiled(filepath, header, m_MappingSize);
+  bindSections(header);
+
+  ispd_info("Compiled route file %s has been mapped (Sources: %lu, Pairs: "
+            "%lu, Routes: %lu, Hops: %lu).",
+            filepath.c_str(), header->m_SourceCount, header->m_PairCount,
+            header->m_RouteCount, header->m_HopCount);
+}
+
+auto RoutingTable::save(const std::string &filepath) const -> void {
+  std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+
+  /// Check if the compiled route file could not be created. If so, an error
   /// indicating the case is sent and the program is immediately aborted.
   if (!file.is_open()) [[unlikely]]
-    ispd_error("Routing file %s could not be opened.", filepath.c_str());
+    ispd_error("Compiled route file %s could not be created.",
+               filepath.c_str());
+
+  /// Check if there is no routes to be written.
+  if (!m_Header) [[unlikely]]
+    ispd_error("An empty routing table cannot be written to %s.",
+               filepath.c_str());
+
+  /// Since the layout is the same in memory and in the compiled route file,
+  /// the routes are written as is.
+  if (m_TrieParents.empty()) {
+    file.write(reinterpret_cast<const char *>(m_Header),
+               m_Header->getFileSize());
+  }
+  /// Otherwise, every section but the pooled hop array is written as is, and
+  /// the pooled hop array is expanded from the prefix trie.
+  else {
+    file.write(reinterpret_cast<const char *>(m_Header),
+               m_Header->getFileSize() -
+                   m_Header->m_HopCount * sizeof(tw_lpid));
 
-  /// Read the each line from the routing file. Each line in the file
-  /// represents a route indicating the source service, the destination
-  /// service and the services' identifiers that composes the inner route's
-  /// elements.
-  ///
-  /// In that case, each line from the routing file has the following format:
-  ///
-  ///                    <SRC-ID> <DEST-ID> [<ID>]
-  ///
-  /// in which, [<ID>] indicates one or more identifiers.
-  for (std::string routeLine; std::getline(file, routeLine);) {
-    lineNumber++;
-
-    /// The source and destination identifier that will be identified from
-    /// the route line.
-    tw_lpid src, dest;
-
-    /// Parse the route line obtaining the route structure containing the
-    /// route's length and the route's intermediate services identifiers.
-    Route *route = parseRouteLine(routeLine, lineNumber, src, dest);
-
-    /// Add the route.
-    addRoute(src, dest, route);
-
-    /// Print the loaded route.
-    DEBUG({
-      std::printf("Route [F: %lu, T: %lu, P: ", src, dest);
-      for (int i = 0; i < route->getLength() - 1; i++)
-        std::printf("%lu -> ", route->get(i));
-      std::printf("%lu].\n", route->get(route->getLength() - 1));
-    });
+    std::vector<tw_lpid> path;
+
+    for (std::uint64_t route = 0; route < m_Header->m_RouteCount; route++) {
+      path.resize(m_RouteHops[route + 1] - m_RouteHops[route]);
+
+      /// Walk the route backwards from its last hop.
+      std::uint64_t node = m_RouteNodes[route];
+
+      for (std::size_t i = path.size(); i-- > 0; node = m_TrieParents[node])
+        path[i] = m_TrieHops[node];
+
+      file.write(reinterpret_cast<const char *>(path.data()),
+                 path.size() * sizeof(tw_lpid));
+    }
   }
+
+  if (!file) [[unlikely]]
+    ispd_error("Compiled route file %s could not be written.",
+               filepath.c_str());
+}
+
+auto RoutingTable::findSource(const tw_lpid src) const noexcept
+    -> std::uint64_t {
+  const std::uint64_t *const end = m_Sources + m_Header->m_SourceCount;
+  const std::uint64_t *const it = std::lower_bound(m_Sources, end, src);
+
+  return (it != end && *it == src) ? it - m_Sources : m_Header->m_SourceCount;
+}
+
+auto RoutingTable::findPair(const tw_lpid src,
+                            const tw_lpid dest) const noexcept
+    -> std::uint64_t {
+  const std::uint64_t source = findSource(src);
+
+  if (source == m_Header->m_SourceCount)
+    return m_Header->m_PairCount;
+
+  /// Search the destination vertex only within the source's pairs, which are
+  /// stored contiguously.
+  const std::uint64_t *const first = m_PairDests + m_SourcePairs[source];
+  const std::uint64_t *const last = m_PairDests + m_SourcePairs[source + 1];
+  const std::uint64_t *const it = std::lower_bound(first, last, dest);
+
+  return (it != last && *it == dest) ? it - m_PairDests
+                                     : m_Header->m_PairCount;
 }
 
-auto RoutingTable::getRoute(const tw_lpid src, const tw_lpid dest) const
-    -> const Route * {
-  return m_Routes.at(szudzik(src, dest))[0];
+auto RoutingTable::hasRoute(const tw_lpid src, const tw_lpid dest) const
+    -> bool {
+  return findPair(src, dest) != m_Header->m_PairCount;
 }
 
 auto RoutingTable::getRoutes(const tw_lpid src, const tw_lpid dest) const
-    -> const std::vector<const Route *> & {
-  return m_Routes.at(szudzik(src, dest));
+    -> RouteList {
+  const std::uint64_t pair = findPair(src, dest);
+
+  if (pair == m_Header->m_PairCount) [[unlikely]]
+    ispd_error("There is no route from %lu to %lu.", src, dest);
+
+  const std::uint64_t route = m_PairRoutes[pair];
+  const std::size_t count = m_PairRoutes[pair + 1] - route;
+
+  if (!m_TrieParents.empty())
+    return RouteList(m_RouteHops + route, m_TrieHops.data(),
+                     m_TrieParents.data(), m_RouteNodes.data() + route, count);
+  return RouteList(m_RouteHops + route, m_Hops, count);
+}
+
+auto RoutingTable::getRouteId(const tw_lpid src, const tw_lpid dest,
+                              const std::size_t index) const -> RouteId {
+  const std::uint64_t pair = findPair(src, dest);
+
+  if (pair == m_Header->m_PairCount) [[unlikely]]
+    ispd_error("There is no route from %lu to %lu.", src, dest);
+
+  const std::uint64_t route = m_PairRoutes[pair] + index;
+
+  if (route >= m_PairRoutes[pair + 1]) [[unlikely]]
+    ispd_error("There is no route %lu from %lu to %lu.", index, src, dest);
+
+  return m_RouteIds.empty() ? route : m_RouteIds[route];
 }
 
 auto RoutingTable::countRoutes(const tw_lpid src) const -> const std::uint32_t {
-  const auto it = m_RoutesCounting.find(src);
-  if (it == m_RoutesCounting.end())
+  const std::uint64_t source = findSource(src);
+
+  if (source == m_Header->m_SourceCount)
+    ispd_error("There is no routing with source at LP with GID %lu.", src);
+
+  return m_PairRoutes[m_SourcePairs[source + 1]] -
+         m_PairRoutes[m_SourcePairs[source]];
+}
+
+auto RoutingTable::countDestinations(const tw_lpid src) const
+    -> const std::uint32_t {
+  const std::uint64_t source = findSource(src);
+
+  if (source == m_Header->m_SourceCount)
     ispd_error("There is no routing with source at LP with GID %lu.", src);
 
-  return m_RoutesCounting.at(src);
+  return m_SourcePairs[source + 1] - m_SourcePairs[source];
 }
 
 }; // namespace ispd::routing
@@ -194,25 +831,79 @@ namespace ispd::routing_table {
 /// \brief The global routing table.
 ispd::routing::RoutingTable *g_RoutingTable = new ispd::routing::RoutingTable();
 
-auto load(const std::string &filepath) -> void {
+/// \brief The provider that serves the routes, which is the global routing
+///        table unless an implicit provider has been selected.
+static const ispd::routing::RoutingProvider *g_RoutingProvider = g_RoutingTable;
+
+auto setProvider(const ispd::routing::RoutingProvider *const provider)
+    -> void {
+  g_RoutingProvider = provider;
+}
+
+auto hasImplicitProvider() -> bool {
+  return g_RoutingProvider != g_RoutingTable;
+}
+
+auto getProvider() -> const ispd::routing::RoutingProvider & {
+  return *g_RoutingProvider;
+}
+
+auto load(const std::string &filepath, const unsigned threadCount,
+          const ispd::routing::VertexPredicate &isRelevant) -> void {
   /// Forward the route tabl load to the global routing table.
-  g_RoutingTable->load(filepath);
+  g_RoutingTable->load(filepath, threadCount, isRelevant);
+}
+
+auto load(const std::string &name, ispd::input::FileBuffer &&buffer,
+          const unsigned threadCount,
+          const ispd::routing::VertexPredicate &isRelevant) -> void {
+  /// Forward the route table load to the global routing table.
+  g_RoutingTable->load(name, std::move(buffer), threadCount, isRelevant);
+}
+
+auto enablePrefixSharing() -> void {
+  /// Forward the prefix sharing to the global routing table.
+  g_RoutingTable->enablePrefixSharing();
 }
 
-auto getRoute(const tw_lpid src, const tw_lpid dest)
-    -> const ispd::routing::Route * {
-  /// Forward the route query to the global routing table.
-  return g_RoutingTable->getRoute(src, dest);
+auto getRouteCount() -> std::uint64_t {
+  /// Forward the route count query to the global routing table.
+  return g_RoutingTable->getRouteCount();
+}
+
+auto getRoute(const tw_lpid src, const tw_lpid dest) -> ispd::routing::Route {
+  /// Forward the route query to the route provider.
+  return g_RoutingProvider->getRoute(src, dest);
+}
+
+auto hasRoute(const tw_lpid src, const tw_lpid dest) -> bool {
+  return g_RoutingProvider->hasRoute(src, dest);
 }
 
 auto getRoutes(const tw_lpid src, const tw_lpid dest)
-    -> const std::vector<const ispd::routing::Route *> & {
-  return g_RoutingTable->getRoutes(src, dest);
+    -> ispd::routing::RouteList {
+  return g_RoutingProvider->getRoutes(src, dest);
+}
+
+auto getRouteId(const tw_lpid src, const tw_lpid dest, const std::size_t index)
+    -> ispd::routing::RouteId {
+  /// Forward the route identifier query to the route provider.
+  return g_RoutingProvider->getRouteId(src, dest, index);
+}
+
+auto getRouteById(const ispd::routing::RouteId id) -> ispd::routing::Route {
+  /// Forward the route query to the route provider.
+  return g_RoutingProvider->getRouteById(id);
 }
 
 auto countRoutes(const tw_lpid src) -> const std::uint32_t {
-  /// Forward the route couting to the global routing table.
-  return g_RoutingTable->countRoutes(src);
+  /// Forward the route couting to the route provider.
+  return g_RoutingProvider->countRoutes(src);
+}
+
+auto countDestinations(const tw_lpid src) -> const std::uint32_t {
+  /// Forward the destination couting to the route provider.
+  return g_RoutingProvider->countDestinations(src);
 }
 
 }; // namespace ispd::routing_table
@@ -18,7 +18,7 @@ namespace ispd::workload {
                owner.c_str());
   }
 
-  m_Owner = userIterator->second.getId();
+  m_Owner = userIterator->getId();
   m_RemainingTasks = remainingTasks;
   m_InterarrivalDist = std::move(interarrivalDist);
   m_ComputingOffload = computingOffload;